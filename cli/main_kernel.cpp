@@ -11,8 +11,11 @@
 #include <iomanip>
 #include <algorithm>
 #include <map>
+#include <array>
 #include <filesystem>
 #include <cstdlib>
+#include <chrono>
+#include <future>
 
 static void printHelp() {
     std::cerr << "Kernel Commands:\n"
@@ -22,17 +25,30 @@ static void printHelp() {
               << "  stats              # print detailed statistics (demographics, networks, beliefs)\n"
               << "  reset [N R k p]    # reset with optional: pop, regions, k, rewire_p\n"
               << "  run T log          # run T ticks, log metrics every 'log' steps\n"
-              << "  cluster kmeans K   # detect K cultures via K-means\n"
+              << "  cluster kmeans K [warm] # detect K cultures via K-means (warm: start from last cultures)\n"
+              << "  cluster minibatch K B # K cultures via mini-batch K-means (batch size B)\n"
               << "  cluster dbscan e m # detect cultures via DBSCAN (eps, minPts)\n"
+              << "  cluster online     # snapshot cultures from the online tracker\n"
+              << "  cluster async M .. # run kmeans/minibatch/dbscan on a snapshot in the background\n"
+              << "  cluster collect    # wait for the background clustering and install it\n"
+              << "  tracker [K S]      # show online culture tracker (K>0 enables, 0 disables; S sweep ticks)\n"
               << "  cultures           # print last detected cultures\n"
+              << "  culture_history    # list retired cultures with birth/death ticks\n"
               << "  economy            # show economy summary\n"
               << "  region R           # show regional economy details\n"
               << "  classes            # show emergent economic classes\n"
               << "  detect_movements   # detect movements from last clustering\n"
               << "  movements          # list active movements with stats\n"
               << "  movement ID        # show detailed info for movement ID\n"
+              << "  epidemic [network|regional|seed N] # show epidemic state, switch model, or seed N cases\n"
+              << "  lod                # show adaptive level-of-detail tiers and last-tick counters\n"
+              << "  load               # show per-thread load of the last neighbor sweep\n"
               << "  quit               # exit\n"
-              << "\nOptions: use --start=<profile> or SIM_START_CONDITION env var to choose economic start\n";
+              << "\nOptions: use --start=<profile> or SIM_START_CONDITION env var to choose economic start\n"
+              << "         use --trade-equilibrium to solve trade to steady state each economy update\n"
+              << "         use --network-epidemic to spread disease over social ties (SEIR)\n"
+              << "         use --lod[=TOL] to update quiet agents every 2/4/8 ticks (drift tolerance TOL)\n"
+              << "         use --edge-replicas to read 16-bit neighbor belief copies stored per edge\n";
 }
 
 static void printClusters(const std::vector<Cluster>& clusters, const Kernel& kernel) {
@@ -47,7 +63,9 @@ static void printClusters(const std::vector<Cluster>& clusters, const Kernel& ke
     std::cout << "Total clusters: " << clusters.size() << "\n";
     std::cout << "Within variance: " << metrics.withinVariance << "\n";
     std::cout << "Between variance: " << metrics.betweenVariance << "\n";
-    std::cout << "Silhouette: " << metrics.silhouette << "\n";
+    std::cout << "Variance ratio: " << metrics.varianceRatio << "\n";
+    std::cout << "Silhouette: " << metrics.silhouette << " (95% CI " << metrics.silhouetteLow
+              << " .. " << metrics.silhouetteHigh << ", n=" << metrics.silhouetteSamples << ")\n";
     std::cout << "Diversity: " << metrics.diversity << "\n\n";
 
     // Language family names (can be customized)
@@ -56,12 +74,13 @@ static void printClusters(const std::vector<Cluster>& clusters, const Kernel& ke
     for (const auto& cluster : clusters) {
         std::cout << std::setprecision(2)
                   << "Cluster " << cluster.id << " [" << cluster.members.size()
-                  << " agents, coherence=" << cluster.coherence << "]\n";
+                  << " agents, coherence=" << cluster.coherence
+                  << ", born tick " << cluster.birthTick << "]\n";
 
         std::cout << "  Centroid: [" << std::setprecision(3);
-        for (int d = 0; d < 4; ++d) {
+        for (int d = 0; d < kBeliefDims; ++d) {
             std::cout << cluster.centroid[d];
-            if (d < 3) std::cout << ", ";
+            if (d + 1 < kBeliefDims) std::cout << ", ";
         }
         std::cout << "]\n";
 
@@ -97,6 +116,16 @@ static void printClusters(const std::vector<Cluster>& clusters, const Kernel& ke
 }
 
 static std::vector<Cluster> g_lastClusters;
+static ClusterTracker g_clusterTracker;  // persistent culture ids across clusterings
+static std::future<ClusteringResult> g_pendingClusters;  // background clustering, if any
+
+static void installAsyncClusters(const Kernel& kernel) {
+    ClusteringResult result = g_pendingClusters.get();
+    g_lastClusters = std::move(result.clusters);
+    g_clusterTracker.update(g_lastClusters, result.generation);
+    std::cerr << "Background clustering of generation " << result.generation
+              << " installed (now at " << kernel.generation() << ")\n";
+}
 
 #ifdef HAS_GAME_MODULES
 static MovementModule g_movements;
@@ -120,6 +149,17 @@ int main(int argc, char** argv) {
         std::string arg = argv[i];
         if (arg.rfind("--start=", 0) == 0) {
             cfg.startCondition = arg.substr(8);
+        } else if (arg == "--trade-equilibrium") {
+            cfg.tradeEquilibrium = true;
+        } else if (arg == "--network-epidemic") {
+            cfg.networkEpidemic = true;
+        } else if (arg == "--lod") {
+            cfg.lod.enabled = true;
+        } else if (arg.rfind("--lod=", 0) == 0) {
+            cfg.lod.enabled = true;
+            cfg.lod.tolerance = std::stod(arg.substr(6));
+        } else if (arg == "--edge-replicas") {
+            cfg.edgeReplicas = true;
         } else if (arg == "--help" || arg == "-h") {
             printHelp();
             return 0;
@@ -187,13 +227,31 @@ int main(int argc, char** argv) {
                     iss >> method;
                     if (method == "kmeans") {
                         int k = 5;
-                        iss >> k;
-                        k = std::clamp(k, 2, 20);
+                        std::string warm;
+                        iss >> k >> warm;
+                        k = std::clamp(k, 2, 64);
                         std::cerr << "Running K-means with k=" << k << "...\n";
                         KMeansClustering km(k);
+                        if (warm == "warm") km.warmStart(g_lastClusters);
                         g_lastClusters = km.run(kernel);
+                        g_clusterTracker.update(g_lastClusters, kernel.generation());
                         std::cerr << "Iterations: " << km.iterationsUsed()
-                                  << " (converged=" << (km.converged() ? "yes" : "no") << ")\n";
+                                  << " (converged=" << (km.converged() ? "yes" : "no")
+                                  << (km.warmStarted() ? ", warm start" : "") << ")\n";
+                        printClusters(g_lastClusters, kernel);
+                    } else if (method == "minibatch") {
+                        int k = 5;
+                        int batch = 1024;
+                        iss >> k >> batch;
+                        k = std::clamp(k, 2, 64);
+                        batch = std::max(batch, 16);
+                        std::cerr << "Running mini-batch K-means with k=" << k << ", batch=" << batch << "...\n";
+                        MiniBatchKMeansClustering mb(k, batch);
+                        g_lastClusters = mb.run(kernel);
+                        g_clusterTracker.update(g_lastClusters, kernel.generation());
+                        std::cerr << "Iterations: " << mb.iterationsUsed()
+                                  << " (converged=" << (mb.converged() ? "yes" : "no")
+                                  << ", inertia=" << mb.inertia() << ")\n";
                         printClusters(g_lastClusters, kernel);
                     } else if (method == "dbscan") {
                         double eps = 0.3;
@@ -202,13 +260,100 @@ int main(int argc, char** argv) {
                         std::cerr << "Running DBSCAN (eps=" << eps << ", minPts=" << minPts << ")...\n";
                         DBSCANClustering db(eps, minPts);
                         g_lastClusters = db.run(kernel);
+                        g_clusterTracker.update(g_lastClusters, kernel.generation());
                         std::cerr << "Noise points: " << db.noisePoints() << "\n";
                         printClusters(g_lastClusters, kernel);
+                    } else if (method == "async") {
+                        if (g_pendingClusters.valid()) {
+                            std::cerr << "A background clustering is already running; 'cluster collect' first.\n";
+                            continue;
+                        }
+                        std::string algo;
+                        iss >> algo;
+                        if (algo == "kmeans") {
+                            int k = 5;
+                            iss >> k;
+                            g_pendingClusters = clusterAsync(kernel, KMeansClustering(std::clamp(k, 2, 64)));
+                        } else if (algo == "minibatch") {
+                            int k = 5;
+                            int batch = 1024;
+                            iss >> k >> batch;
+                            g_pendingClusters = clusterAsync(kernel,
+                                MiniBatchKMeansClustering(std::clamp(k, 2, 64), std::max(batch, 16)));
+                        } else if (algo == "dbscan") {
+                            double eps = 0.3;
+                            int minPts = 50;
+                            iss >> eps >> minPts;
+                            g_pendingClusters = clusterAsync(kernel, DBSCANClustering(eps, minPts));
+                        } else {
+                            std::cerr << "Usage: cluster async kmeans K | cluster async minibatch K B | cluster async dbscan eps minPts\n";
+                            continue;
+                        }
+                        std::cerr << "Clustering generation " << kernel.generation() << " in the background...\n";
+                    } else if (method == "collect") {
+                        if (!g_pendingClusters.valid()) {
+                            std::cerr << "No background clustering pending.\n";
+                            continue;
+                        }
+                        installAsyncClusters(kernel);
+                        printClusters(g_lastClusters, kernel);
+                    } else if (method == "online") {
+                        const OnlineClustering* tracker = kernel.cultureTracker();
+                        if (!tracker) {
+                            std::cerr << "Culture tracker disabled. Enable it with 'tracker K'.\n";
+                            continue;
+                        }
+                        g_lastClusters = tracker->materialize(kernel);
+                        g_clusterTracker.update(g_lastClusters, kernel.generation());
+                        printClusters(g_lastClusters, kernel);
                     } else {
-                        std::cerr << "Usage: cluster kmeans K | cluster dbscan eps minPts\n";
+                        std::cerr << "Usage: cluster kmeans K [warm] | cluster minibatch K B | cluster dbscan eps minPts | cluster online | cluster async ... | cluster collect\n";
+                    }
+                } else if (cmd == "tracker") {
+                    int k = -1;
+                    int sweep = 20;
+                    if (iss >> k) {
+                        iss >> sweep;
+                        k = std::clamp(k, 0, 64);
+                        sweep = std::max(sweep, 1);
+                        kernel.enableCultureTracker(static_cast<std::uint32_t>(k), sweep);
+                    }
+                    const OnlineClustering* tracker = kernel.cultureTracker();
+                    if (!tracker) {
+                        std::cout << "Culture tracker disabled.\n";
+                        continue;
+                    }
+                    std::cout << "\n=== Culture Tracker (Generation " << kernel.generation() << ") ===\n"
+                              << "Clusters: " << tracker->k() << " | Tracked agents: " << tracker->trackedAgents()
+                              << " | Sweep: " << tracker->sweepTicks() << " ticks"
+                              << " | Inertia: " << std::fixed << std::setprecision(2) << tracker->inertia() << "\n";
+                    for (int c = 0; c < tracker->k(); ++c) {
+                        const auto& centroid = tracker->centroids()[c];
+                        std::cout << "  Cluster " << c << ": " << tracker->clusterSize(c) << " agents"
+                                  << ", coherence=" << std::setprecision(3) << tracker->clusterCoherence(c)
+                                  << ", centroid=[";
+                        for (int d = 0; d < kBeliefDims; ++d) {
+                            std::cout << centroid[d] << (d + 1 < kBeliefDims ? ", " : "]\n");
+                        }
                     }
+                    std::cout.flush();
                 } else if (cmd == "cultures") {
+                    if (g_pendingClusters.valid() &&
+                        g_pendingClusters.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                        installAsyncClusters(kernel);
+                    }
                     printClusters(g_lastClusters, kernel);
+                } else if (cmd == "culture_history") {
+                    const auto& retired = g_clusterTracker.retired();
+                    std::cout << "\n=== Culture History (Generation " << kernel.generation() << ") ===\n"
+                              << "Live cultures: " << g_clusterTracker.live().size()
+                              << " | Retired: " << retired.size() << "\n";
+                    for (const auto& record : retired) {
+                        std::cout << "  Culture " << record.id << ": born tick " << record.birthTick
+                                  << ", died tick " << record.deathTick
+                                  << ", last size " << record.size << "\n";
+                    }
+                    std::cout.flush();
         } else if (cmd == "state") {
             std::string opt;
             iss >> opt;
@@ -333,7 +478,9 @@ int main(int argc, char** argv) {
             newCfg.startCondition = cfg.startCondition;
             
             kernel.reset(newCfg);
+            g_pendingClusters = {};  // Waits for and drops any clustering of the old run
             g_lastClusters.clear();
+            g_clusterTracker.clear();
             std::cout << "Reset: " << N << " agents, " << R << " regions (start="
                       << newCfg.startCondition << ")\n";
             std::cout.flush();
@@ -397,25 +544,104 @@ int main(int argc, char** argv) {
             std::cout << std::fixed << std::setprecision(3);
             std::cout << "Global Development: " << econ.globalDevelopment() << "\n";
             std::cout << "Total Trade Volume: " << econ.getTotalTrade() << "\n";
+            if (econ.tradeSolverConfig().equilibrium) {
+                const auto& solve = econ.tradeSolveStats();
+                std::cout << "Trade Equilibrium: " << solve.iterations << " iterations, residual "
+                          << std::scientific << solve.residual << std::fixed
+                          << (solve.converged ? "" : " (not converged)")
+                          << (solve.warmStarted ? ", warm start" : ", cold start") << "\n";
+            }
             std::cout << "Welfare: " << econ.globalWelfare() << "\n";
             std::cout << "Inequality (Gini): " << econ.globalInequality() << "\n";
             std::cout << "Hardship: " << econ.globalHardship() << "\n";
             
             // Count economic system types
-            std::map<std::string, int> systemCounts;
+            std::array<int, kEconomicSystemCount> systemCounts{};
             for (std::uint32_t r = 0; r < kernel.regionIndex().size(); ++r) {
                 const auto& reg = econ.getRegion(r);
-                if (reg.population > 0) {
-                    systemCounts[reg.economic_system]++;
+                const auto system = static_cast<std::size_t>(reg.economic_system);
+                if (reg.population > 0 && system < systemCounts.size()) {
+                    systemCounts[system]++;
                 }
             }
             std::cout << "\nEconomic Systems:\n";
-            for (const auto& [system, count] : systemCounts) {
-                std::cout << "  " << system << ": " << count << " regions\n";
+            for (std::size_t s = 0; s < systemCounts.size(); ++s) {
+                if (systemCounts[s] == 0) continue;
+                std::cout << "  " << kEconomicSystemNames[s] << ": " << systemCounts[s] << " regions\n";
             }
             std::cout << "\n";
             std::cout.flush();
             
+        } else if (cmd == "epidemic") {
+            std::string sub;
+            if (iss >> sub) {
+                if (sub == "network" || sub == "regional") {
+                    kernel.setEpidemicModel(sub == "network" ? EpidemicModel::Network : EpidemicModel::Regional);
+                    cfg.networkEpidemic = (sub == "network");
+                } else if (sub == "seed") {
+                    std::uint32_t count = 1;
+                    iss >> count;
+                    if (kernel.health().epidemicModel() != EpidemicModel::Network) {
+                        std::cout << "Seeding needs the network model ('epidemic network').\n";
+                    } else {
+                        std::cout << "Seeded " << kernel.seedInfections(count) << " index cases\n";
+                    }
+                } else {
+                    std::cout << "Usage: epidemic [network|regional|seed N]\n";
+                }
+            }
+            const auto& health = kernel.health();
+            std::size_t infected = 0;
+            for (const auto& agent : kernel.agents()) {
+                if (agent.alive && agent.health.infected) ++infected;
+            }
+            std::cout << "\n=== Epidemic (Generation " << kernel.generation() << ") ===\n";
+            std::cout << "Model: " << (health.epidemicModel() == EpidemicModel::Network ? "network SEIR" : "regional")
+                      << " | Infected: " << infected << "\n";
+            if (health.epidemicModel() == EpidemicModel::Network) {
+                const auto& stats = health.epidemicStats();
+                std::cout << "Exposed: " << stats.exposed << " | Infectious: " << stats.infectious
+                          << " | Total cases: " << stats.totalCases << "\n"
+                          << "Last tick: " << stats.newExposures << " exposures (" << stats.spillovers
+                          << " spillover), " << stats.recoveries << " recoveries, "
+                          << stats.edgesScanned << " contacts scanned\n";
+            }
+            std::cout.flush();
+            
+        } else if (cmd == "lod") {
+            const auto& lod = kernel.levelOfDetail();
+            if (!lod.enabled()) {
+                std::cout << "Level of detail disabled (start with --lod).\n";
+                continue;
+            }
+            const auto& stats = lod.stats();
+            std::cout << "\n=== Level of Detail (Generation " << kernel.generation() << ") ===\n";
+            std::cout << "Tolerance: " << lod.config().tolerance << " per tick\n";
+            for (int t = 0; t < LevelOfDetail::kTiers; ++t) {
+                std::cout << "  Every " << (1 << t) << " tick" << (t ? "s" : " ") << ": "
+                          << stats.tierCounts[t] << " agents\n";
+            }
+            std::cout << "Last tick: " << stats.beliefUpdates << " belief / " << stats.wellbeingUpdates
+                      << " wellbeing updates, " << stats.demotions << " demotions, promotions: "
+                      << stats.neighborPromotions << " neighbor, " << stats.economyPromotions << " economy, "
+                      << stats.stressPromotions << " stress\n";
+            std::cout.flush();
+            
+        } else if (cmd == "load") {
+            const auto& load = kernel.beliefLoad();
+            if (load.tasks.empty()) {
+                std::cout << "No neighbor sweep yet (step first).\n";
+                continue;
+            }
+            std::cout << "\n=== Neighbor Sweep Load (Generation " << kernel.generation() << ") ===\n";
+            for (std::size_t t = 0; t < load.tasks.size(); ++t) {
+                std::cout << "  Thread " << t << ": " << load.tasks[t] << " tasks, " << load.cost[t]
+                          << " agents+edges, " << std::fixed << std::setprecision(2)
+                          << load.seconds[t] * 1000.0 << " ms\n";
+            }
+            std::cout << "Imbalance (slowest / mean): " << std::setprecision(3) << load.imbalance() << "\n";
+            std::cout.flush();
+            
         } else if (cmd == "region") {
             std::uint32_t rid;
             iss >> rid;
@@ -437,7 +663,7 @@ int main(int argc, char** argv) {
                 std::cout << " - " << quadrant << "\n\n";
                 
                 std::cout << "Population: " << region.population << "\n";
-                std::cout << "Economic System: " << region.economic_system << "\n";
+                std::cout << "Economic System: " << economicSystemName(region.economic_system) << "\n";
                 std::cout << "Development: " << region.development << "\n";
                 std::cout << "Efficiency: " << region.efficiency << "\n\n";
                 
@@ -507,7 +733,7 @@ int main(int argc, char** argv) {
         } else if (cmd == "detect_movements") {
 #ifdef HAS_GAME_MODULES
             if (g_lastClusters.empty()) {
-                std::cerr << "No clusters detected. Run 'cluster kmeans K' or 'cluster dbscan' first.\n";
+                std::cerr << "No clusters detected. Run 'cluster kmeans K', 'cluster dbscan' or 'cluster online' first.\n";
                 continue;
             }
             
@@ -528,9 +754,12 @@ int main(int argc, char** argv) {
             
             std::cout << "\n=== Active Movements (Generation " << kernel.generation() << ") ===\n";
             std::cout << "Total movements: " << stats.totalMovements << "\n";
-            std::cout << "Total membership: " << stats.totalMembership << " agents\n";
+            std::cout << "Total membership: " << stats.totalMembership << " agents ("
+                      << stats.multiMembership << " in several movements)\n";
             std::cout << "Average power: " << std::fixed << std::setprecision(3) << stats.avgPower << "\n";
             std::cout << "Average size: " << std::fixed << std::setprecision(1) << stats.avgSize << "\n";
+            std::cout << "Average momentum: " << std::setprecision(4) << stats.avgMomentum
+                      << " | churn: " << stats.avgChurn << "\n";
             std::cout << "Stages: Birth=" << stats.birthStage << " Growth=" << stats.growthStage
                       << " Plateau=" << stats.plateauStage << " Decline=" << stats.declineStage << "\n\n";
             
@@ -541,14 +770,17 @@ int main(int argc, char** argv) {
                 std::cout << "Movement #" << mov->id << " [" << stageNames[static_cast<int>(mov->stage)] << "]\n";
                 std::cout << "  Size: " << mov->members.size() << " | Power: " << std::fixed << std::setprecision(3) << mov->power << "\n";
                 std::cout << "  Platform: [" << std::setprecision(2);
-                for (int d = 0; d < 4; ++d) {
+                for (int d = 0; d < kBeliefDims; ++d) {
                     std::cout << mov->platform[d];
-                    if (d < 3) std::cout << ", ";
+                    if (d + 1 < kBeliefDims) std::cout << ", ";
                 }
                 std::cout << "]\n";
                 std::cout << "  Coherence: " << std::setprecision(3) << mov->coherence
                           << " | Street: " << mov->streetCapacity
                           << " | Charisma: " << mov->charismaScore << "\n";
+                std::cout << "  Momentum: " << std::setprecision(4) << mov->momentum
+                          << " | Churn: " << mov->churn
+                          << " (+" << mov->joined << " / -" << mov->left << ")\n";
                 
                 if (!mov->regionalStrength.empty()) {
                     std::cout << "  Top regions: ";
@@ -595,21 +827,40 @@ int main(int argc, char** argv) {
             std::cout << "  Street capacity: " << mov->streetCapacity << "\n";
             std::cout << "  Charisma score: " << mov->charismaScore << "\n";
             std::cout << "Coherence: " << mov->coherence << "\n";
-            std::cout << "Momentum: " << mov->momentum << "\n";
+            std::cout << "Momentum: " << mov->momentum << " | Churn: " << mov->churn
+                      << " (+" << mov->joined << " joined / -" << mov->left << " left)\n";
             std::cout << "Platform: [" << std::setprecision(2);
-            for (int d = 0; d < 4; ++d) {
+            for (int d = 0; d < kBeliefDims; ++d) {
                 std::cout << mov->platform[d];
-                if (d < 3) std::cout << ", ";
+                if (d + 1 < kBeliefDims) std::cout << ", ";
             }
             std::cout << "]\n";
             
-            if (!mov->classComposition.empty()) {
+            if (!mov->members.empty()) {
                 std::cout << "Class composition:\n";
-                for (const auto& [decile, proportion] : mov->classComposition) {
+                for (int decile = 0; decile < 10; ++decile) {
+                    double proportion = mov->classComposition[decile];
+                    if (proportion <= 0.0) continue;
                     std::cout << "  Decile " << decile << ": " << std::setprecision(1) << (proportion * 100.0) << "%\n";
                 }
             }
             
+            std::vector<std::pair<double, std::uint32_t>> overlaps;
+            for (const auto& other : g_movements.movements()) {
+                if (other.id == mov->id) continue;
+                double jaccard = g_movements.overlap(mov->id, other.id);
+                if (jaccard > 0.0) overlaps.emplace_back(jaccard, other.id);
+            }
+            if (!overlaps.empty()) {
+                std::sort(overlaps.rbegin(), overlaps.rend());
+                std::cout << "Overlapping movements:\n";
+                for (std::size_t i = 0; i < overlaps.size() && i < 5; ++i) {
+                    std::cout << "  Movement #" << overlaps[i].second << ": "
+                              << g_movements.sharedMembers(mov->id, overlaps[i].second) << " shared (Jaccard "
+                              << std::setprecision(3) << overlaps[i].first << ")\n";
+                }
+            }
+            
             if (!mov->regionalStrength.empty()) {
                 std::cout << "Regional strength:\n";
                 std::vector<std::pair<std::uint32_t, double>> sortedRegions(
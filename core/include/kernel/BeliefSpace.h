@@ -0,0 +1,114 @@
+#ifndef BELIEF_SPACE_H
+#define BELIEF_SPACE_H
+
+#include <array>
+#include <cmath>
+
+#include "kernel/Precision.h"
+
+/**
+ * Belief-space dimensionality and vector kernels
+ *
+ * The number of belief axes is fixed at build time (CMake BELIEF_DIMS = 4, 8
+ * or 16), so every belief loop has a constant trip count the compiler fully
+ * unrolls and vectorizes. Axes 0-3 keep their meaning (Authority, Tradition,
+ * Hierarchy, Faith); axes 4+ are generic opinion dimensions that take part in
+ * social influence, similarity and clustering only.
+ *
+ * The kernels below are templates on D, so code written against them (and
+ * their tests) works for any dimensionality; the simulation instantiates
+ * them for kBeliefDims. KernelConfig::beliefDims must match the build.
+ * They accept double aggregates (BeliefVec) and per-agent state (BeliefState,
+ * float with AGENT_FLOAT_STATE) alike and reduce in double.
+ */
+
+#ifndef BELIEF_DIMS
+#define BELIEF_DIMS 4
+#endif
+
+constexpr int kBeliefDims = BELIEF_DIMS;
+static_assert(kBeliefDims == 4 || kBeliefDims == 8 || kBeliefDims == 16,
+              "BELIEF_DIMS must be 4, 8 or 16");
+
+template <int D>
+using BeliefArray = std::array<double, D>;
+using BeliefVec = BeliefArray<kBeliefDims>;                 // Aggregates (centroids, sums)
+using BeliefState = std::array<state_t, kBeliefDims>;       // Per-agent storage
+
+namespace belief {
+
+template <int D, typename A, typename B>
+inline double dot(const std::array<A, D>& a, const std::array<B, D>& b) {
+    double sum = 0.0;
+    #pragma omp simd reduction(+:sum)
+    for (int d = 0; d < D; ++d) sum += static_cast<double>(a[d]) * b[d];
+    return sum;
+}
+
+template <int D, typename A>
+inline double normSq(const std::array<A, D>& a) {
+    return dot<D>(a, a);
+}
+
+template <int D, typename A, typename B>
+inline double distanceSq(const std::array<A, D>& a, const std::array<B, D>& b) {
+    double sum = 0.0;
+    #pragma omp simd reduction(+:sum)
+    for (int d = 0; d < D; ++d) {
+        const double diff = static_cast<double>(a[d]) - b[d];
+        sum += diff * diff;
+    }
+    return sum;
+}
+
+// acc += w * v
+template <int D, typename A, typename B>
+inline void addScaled(std::array<A, D>& acc, const std::array<B, D>& v, double w) {
+    #pragma omp simd
+    for (int d = 0; d < D; ++d) acc[d] += w * v[d];
+}
+
+template <int D, typename A, typename B>
+inline void add(std::array<A, D>& acc, const std::array<B, D>& v) {
+    #pragma omp simd
+    for (int d = 0; d < D; ++d) acc[d] += v[d];
+}
+
+template <int D, typename A>
+inline void scale(std::array<A, D>& v, double w) {
+    #pragma omp simd
+    for (int d = 0; d < D; ++d) v[d] *= w;
+}
+
+// Cosine similarity, 0 if either vector is (near) zero
+template <int D, typename A, typename B>
+inline double cosine(const std::array<A, D>& a, const std::array<B, D>& b) {
+    double ab = 0.0, aa = 0.0, bb = 0.0;
+    #pragma omp simd reduction(+:ab, aa, bb)
+    for (int d = 0; d < D; ++d) {
+        const double ad = a[d], bd = b[d];
+        ab += ad * bd;
+        aa += ad * ad;
+        bb += bd * bd;
+    }
+    return (aa > 1e-9 && bb > 1e-9) ? ab / (std::sqrt(aa) * std::sqrt(bb)) : 0.0;
+}
+
+// Padé approximant of tanh: x (27 + x²) / (27 + 9 x²). Branch-free, so it
+// vectorizes in float or double
+template <typename T>
+inline T fastTanh(T x) {
+    const T x2 = x * x;
+    return x * (T(27) + x2) / (T(27) + T(9) * x2);
+}
+
+// Per-agent state widened to a double aggregate
+inline BeliefVec toVec(const BeliefState& s) {
+    BeliefVec v;
+    for (int d = 0; d < kBeliefDims; ++d) v[d] = s[d];
+    return v;
+}
+
+}  // namespace belief
+
+#endif
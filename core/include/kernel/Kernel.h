@@ -1,15 +1,23 @@
 #ifndef KERNEL_H
 #define KERNEL_H
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <vector>
 #include <cstdint>
 #include <string>
 #include <random>
+#include <memory>
+#include "kernel/BeliefSpace.h"
 #include "modules/Economy.h"
 #include "modules/Psychology.h"
 #include "modules/Health.h"
+#include "modules/LevelOfDetail.h"
 #include "modules/MeanField.h"
+#include "modules/OnlineClustering.h"
+#include "modules/PairwiseInfluence.h"
+#include "utils/DegreeScheduler.h"
 #include "utils/EventLog.h"
 
 // ---------- Tuning Constants ----------
@@ -50,6 +58,20 @@ namespace TuningConstants {
     constexpr double kWelfareThreshold = 0.5;        // Welfare level that triggers openness response
 }
 
+// Influence weight of `other` on `self` in the hybrid belief update.
+// EXPONENTIAL HOMOPHILY: e^(cosine similarity * kHomophilyExponent), clamped,
+// with a bonus for a shared language. Similar agents dominate (echo chambers)
+inline double homophilyWeight(const BeliefState& self, const BeliefState& other, bool same_language) {
+    const double similarity = belief::cosine<kBeliefDims>(self, other);
+    double weight = std::exp(similarity * TuningConstants::kHomophilyExponent);
+    weight = std::clamp(weight, TuningConstants::kHomophilyMinWeight,
+                        TuningConstants::kHomophilyMaxWeight);
+    if (same_language) {
+        weight *= TuningConstants::kLanguageBonusMultiplier;
+    }
+    return weight;
+}
+
 // ---------- Configuration ----------
 struct KernelConfig {
     std::uint32_t population = 50000;
@@ -59,8 +81,10 @@ struct KernelConfig {
     double stepSize = 0.15;             // eta (global influence rate)
     double simFloor = 0.05;             // minimum similarity gate
     bool useMeanField = true;           // Use mean field approximation (faster)
+    int beliefDims = kBeliefDims;       // belief axes; must match the build (CMake BELIEF_DIMS)
     std::uint64_t seed = 42;
     std::string startCondition = "baseline"; // economic starting profile
+    bool tradeEquilibrium = false;      // solve trade to steady state each economy update
     
     // Demography
     int ticksPerYear = 10;              // age granularity
@@ -68,6 +92,20 @@ struct KernelConfig {
     double regionCapacity = 500.0;      // target population per region
     bool demographyEnabled = true;      // enable births/deaths
     std::uint32_t maxPopulation = 2000000; // hard cap on total population (safety limit)
+    
+    // Online culture tracking (opt-in)
+    std::uint32_t cultureTrackerK = 0;  // clusters tracked every tick (0 = disabled)
+    int cultureTrackerSweepTicks = 20;  // ticks per amortized reassignment sweep
+    
+    // Epidemics
+    bool networkEpidemic = false;       // SEIR over social ties instead of regional coin flips
+    
+    // Adaptive level of detail: quiet agents update every 2/4/8 ticks (both belief paths)
+    LodConfig lod;
+    
+    // Edge-local quantized neighbor replicas (both paths):
+    // neighbor sweeps read 16-bit copies of neighbor beliefs stored per edge
+    bool edgeReplicas = false;
 };
 
 // ---------- Agent Structure ----------
@@ -91,23 +129,23 @@ struct Agent {
     // Dialects encode regional variation within a family
     std::uint8_t primaryLang = 0;    // language family (0-3)
     std::uint8_t dialect = 0;         // regional dialect within family
-    double fluency = 1.0;             // 0..1
+    trait_t fluency = 1.0;            // 0..1
     
     // Personality traits (0..1, mean ~0.5)
-    double openness = 0.5;
-    double conformity = 0.5;
-    double assertiveness = 0.5;
-    double sociality = 0.5;
+    trait_t openness = 0.5;
+    trait_t conformity = 0.5;
+    trait_t assertiveness = 0.5;
+    trait_t sociality = 0.5;
     
     // Belief state: internal x (unbounded), observable B = tanh(x)
-    std::array<double, 4> x{0, 0, 0, 0};  // internal state
-    std::array<double, 4> B{0, 0, 0, 0};  // beliefs [-1,1]
-    double B_norm_sq = 0.0; // cached squared norm of B
+    BeliefState x{};  // internal state
+    BeliefState B{};  // beliefs [-1,1]
+    state_t B_norm_sq = 0.0; // cached squared norm of B
     
     // Module multipliers (written by tech/media/economy modules)
-    double m_comm = 1.0;        // communication reach/speed
-    double m_susceptibility = 1.0;  // influence susceptibility
-    double m_mobility = 1.0;    // migration/relocation ease
+    state_t m_comm = 1.0;        // communication reach/speed
+    state_t m_susceptibility = 1.0;  // influence susceptibility
+    state_t m_mobility = 1.0;    // migration/relocation ease
     
     PsychologicalState psych;
     HealthState health;
@@ -128,7 +166,8 @@ public:
     
     // Access
     const std::vector<Agent>& agents() const { return agents_; }
-    std::vector<Agent>& agentsMut() { return agents_; }
+    std::vector<Agent>& agentsMut() { return agents_; }  // Call networkChanged() after editing neighbor lists
+    void networkChanged() { replicas_.markStale(); }
     const std::vector<std::vector<std::uint32_t>>& regionIndex() const { return regionIndex_; }
     std::uint64_t generation() const { return generation_; }
     
@@ -136,6 +175,23 @@ public:
     const Economy& economy() const { return economy_; }
     Economy& economyMut() { return economy_; }
     
+    // Wellbeing modules
+    const HealthModule& health() const { return health_; }
+    const PsychologyModule& psychology() const { return psychology_; }
+    const LevelOfDetail& levelOfDetail() const { return lod_; }
+    const SchedulerLoad& beliefLoad() const { return belief_sched_.load(); }  // Last neighbor sweep
+    void setEpidemicModel(EpidemicModel model);   // Clears current infections
+    std::uint32_t seedInfections(std::uint32_t count);  // Network mode: random index cases
+    
+    // Incrementally maintained belief distribution for one region (O(1))
+    RegionalBeliefProfile regionalBeliefProfile(std::uint32_t region) const {
+        return regional_aggregates_[region].profile();
+    }
+    
+    // Continuous culture tracker (null unless cultureTrackerK > 0)
+    const OnlineClustering* cultureTracker() const { return culture_tracker_.get(); }
+    void enableCultureTracker(std::uint32_t k, int sweep_ticks = 20);  // k = 0 disables
+    
     // Event log access
     EventLog& eventLog() { return event_log_; }
     const EventLog& eventLog() const { return event_log_; }
@@ -182,7 +238,7 @@ public:
         // Beliefs
         double polarizationMean = 0.0;
         double polarizationStd = 0.0;
-        std::array<double, 4> avgBeliefs = {0, 0, 0, 0};
+        BeliefVec avgBeliefs{};
         
         // Regional distribution
         std::uint32_t occupiedRegions = 0;
@@ -205,6 +261,7 @@ private:
     void initAgents();
     void buildSmallWorld();
     void updateBeliefs();
+    void updateWellbeing();  // Fused parallel health + psychology sweep
     
     // Demography
     void stepDemography();
@@ -217,7 +274,7 @@ private:
     double fertilityRateAnnual(int age) const;
     double fertilityPerTick(int age) const;
     double fertilityPerTick(int age, std::uint32_t region_id, const Agent& agent,
-                           const std::array<double, 4>& region_beliefs) const;  // Region and agent-specific fertility
+                           const BeliefVec& region_beliefs) const;  // Region and agent-specific fertility
     
     // Language assignment based on region geography
     void assignLanguagesByGeography();
@@ -244,54 +301,60 @@ private:
     Economy economy_;  // Economic module
     PsychologyModule psychology_;
     HealthModule health_;
+    LevelOfDetail lod_;  // Adaptive per-agent update rates
     MeanFieldApproximation mean_field_;  // Mean field approximation
+    DegreeScheduler belief_sched_;  // Edge-balanced tasks for the neighbor sweeps
+    PairwiseInfluence pairwise_;  // Packed neighbor nodes (pairwise mode)
+    EdgeReplicas replicas_;  // Per-edge neighbor copies (edge replica mode)
+    std::vector<BeliefState> belief_dx_;        // Per-agent deltas (pairwise mode)
+    std::vector<state_t> belief_rate_;          // Per-agent Σ w_ij (pairwise mode, level of detail)
+    std::vector<BeliefState> belief_partials_;  // Split-hub partial deltas
+    std::vector<state_t> belief_partial_rates_; // ... and their weight sums
     EventLog event_log_;  // Event tracking system
     
-    // Incrementally maintained regional aggregates
-    struct RegionalAggregates {
-        std::uint32_t population = 0;
-        std::array<double, 4> belief_sum = {0.0, 0.0, 0.0, 0.0};
+    // Incrementally maintained regional aggregates: population, belief sums,
+    // sums of squares and pole tallies (everything a RegionalBeliefProfile needs)
+    struct RegionalAggregates : RegionalBeliefMoments {
         bool dirty = false;  // Set if incremental updates may have drifted
     };
     std::vector<RegionalAggregates> regional_aggregates_;
     bool aggregates_initialized_ = false;
     
+    // Per-thread belief-change deltas, merged into regional_aggregates_ after
+    // each parallel belief pass. Persistent so steady-state steps don't allocate;
+    // only touched regions are merged and cleared.
+    struct BeliefDeltaBuffer {
+        std::vector<RegionalBeliefMoments> delta;
+        std::vector<std::uint8_t> marked;
+        std::vector<std::uint32_t> touched;
+        
+        void record(std::uint32_t region, const BeliefState& before, const BeliefState& after) {
+            if (!marked[region]) {
+                marked[region] = 1;
+                touched.push_back(region);
+            }
+            delta[region].update(before, after);
+        }
+    };
+    std::vector<BeliefDeltaBuffer> belief_deltas_;
+    std::vector<RegionalBeliefProfile> belief_profiles_;  // Scratch handed to Economy::update
+    
+    void prepareBeliefDeltas();  // Size one buffer per OpenMP thread
+    void mergeBeliefDeltas();
+    
+    // Online culture tracker, fed from the same belief passes as the
+    // regional aggregates (per-thread deltas merged in mergeBeliefDeltas)
+    std::unique_ptr<OnlineClustering> culture_tracker_;
+    
     // Pre-computed migration attractiveness (updated periodically, not per-migrant)
     std::vector<double> region_attractiveness_;
     std::vector<std::uint32_t> sorted_attractive_regions_;  // Indices sorted by attractiveness (desc)
     std::uint64_t attractiveness_update_gen_ = 0;
 
     // Helper functions
-    inline double fastTanh(double x) const {
-        // Padé approximant for tanh: (x * (27 + x^2)) / (27 + 9 * x^2)
-        // This is a fast, reasonably accurate approximation.
-        double x2 = x * x;
-        return x * (27.0 + x2) / (27.0 + 9.0 * x2);
-    }
-
-    inline double similarityGate(const Agent& a, const Agent& b) const {
-        // Cosine similarity: (a . b) / (||a|| * ||b||)
-        // We use cached squared norms to avoid sqrt.
-        double dot = a.B[0] * b.B[0] + a.B[1] * b.B[1] + a.B[2] * b.B[2] + a.B[3] * b.B[3];
-        
-        double norm_prod_sq = a.B_norm_sq * b.B_norm_sq;
-        
-        if (norm_prod_sq < 1e-9) {
-            return 1.0; // Both vectors are near-zero, consider them similar
-        }
-        
-        // similarity = cos(theta)
-        double sim = dot / std::sqrt(norm_prod_sq);
-        
-        // Simple linear gate: 0 if sim < floor, 1 if sim > 1, linear in between
-        return std::max(0.0, (sim - cfg_.simFloor) / (1.0 - cfg_.simFloor));
-    }
-
-    inline double languageQuality(const Agent& a, const Agent& b) const {
-        if (a.primaryLang == b.primaryLang) {
-            return 0.5 * (a.fluency + b.fluency);
-        }
-        return 0.1; // Low quality for different languages
+    template <typename T>
+    inline T fastTanh(T x) const {
+        return belief::fastTanh(x);  // Padé approximant (kernel/BeliefSpace.h)
     }
 };
 
@@ -0,0 +1,58 @@
+#ifndef PRECISION_H
+#define PRECISION_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * Storage precision of per-agent state
+ *
+ * The default build keeps all agent state in double. With CMake
+ * AGENT_FLOAT_STATE=ON (compile definition AGENT_FLOAT_STATE):
+ *   - beliefs, multipliers and health/psychology fields are float (state_t),
+ *   - personality traits and fluency, which are fixed at birth and live in
+ *     [0, 1], are 16-bit fixed point (trait_t = UnitQ16, step 1.5e-5).
+ * Arithmetic still happens in double wherever values are combined across
+ * agents (centroids, regional sums, similarity); only per-agent storage and
+ * short per-agent accumulations shrink.
+ */
+
+#ifdef AGENT_FLOAT_STATE
+constexpr bool kFloatState = true;
+#else
+constexpr bool kFloatState = false;
+#endif
+
+// Fixed-point value in [0, 1] stored in 16 bits; reads back as double
+class UnitQ16 {
+public:
+    static constexpr double kScale = 65535.0;
+
+    UnitQ16() = default;
+    UnitQ16(double v) : q_(encode(v)) {}
+    UnitQ16& operator=(double v) {
+        q_ = encode(v);
+        return *this;
+    }
+    operator double() const { return q_ * (1.0 / kScale); }
+
+    std::uint16_t raw() const { return q_; }
+
+private:
+    std::uint16_t q_ = 0;
+
+    static std::uint16_t encode(double v) {
+        return static_cast<std::uint16_t>(std::lround(std::clamp(v, 0.0, 1.0) * kScale));
+    }
+};
+
+#ifdef AGENT_FLOAT_STATE
+using state_t = float;
+using trait_t = UnitQ16;
+#else
+using state_t = double;
+using trait_t = double;
+#endif
+
+#endif
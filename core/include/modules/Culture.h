@@ -5,6 +5,11 @@
 #include <vector>
 #include <utility>
 #include <cstdint>
+#include <cstddef>
+#include <future>
+#include <random>
+
+#include "kernel/BeliefSpace.h"
 
 // Forward declarations
 class Kernel;
@@ -12,7 +17,7 @@ struct Agent;
 
 struct Cluster {
     std::uint32_t id = 0;
-    std::array<double, 4> centroid{0, 0, 0, 0};
+    BeliefVec centroid{};
     std::vector<std::uint32_t> members;
     double coherence = 0.0;
     std::array<double, 4> languageShare{0, 0, 0, 0};  // share per language family
@@ -24,64 +29,308 @@ struct Cluster {
     std::uint64_t deathTick = 0;
 };
 
+/**
+ * Compact column snapshot of the living population for clustering
+ *
+ * Holds only what the clustering algorithms and enrichment read (beliefs,
+ * region, language, dialect, agent id), about 50 bytes per agent instead of
+ * a full Agent with its neighbor list. Capturing is one O(N) sweep; after
+ * that the snapshot is independent of the kernel, so clustering can run on
+ * a worker thread while the simulation keeps stepping.
+ */
+struct ClusteringSnapshot {
+    std::uint64_t generation = 0;
+    std::size_t agentSlots = 0;       // agents().size() at capture (seeds the algorithms)
+    std::uint32_t regionCount = 0;
+
+    // One row per living agent, in agent order
+    std::vector<BeliefVec> beliefs;
+    std::vector<std::uint32_t> region;
+    std::vector<std::uint8_t> lang;
+    std::vector<std::uint8_t> dialect;
+    std::vector<std::uint32_t> agentId;
+    std::vector<std::int32_t> rowOf;  // agent id -> row (-1 = dead at capture)
+
+    static ClusteringSnapshot capture(const Kernel& kernel);
+
+    std::size_t size() const { return beliefs.size(); }
+    std::int32_t row(std::uint32_t agent_id) const {
+        return agent_id < rowOf.size() ? rowOf[agent_id] : -1;
+    }
+};
+
+/**
+ * Parallel K-means over living agents' belief vectors
+ *
+ * Lloyd iterations accelerated with triangle-inequality bounds, so once
+ * centroids settle most points are confirmed in O(1) without touching any
+ * centroid:
+ *   - HAMERLY (small k): one upper bound to the assigned centroid and one
+ *     lower bound to the second-closest, O(N) extra memory
+ *   - ELKAN (large k): one lower bound per point-centroid pair, skipping
+ *     individual centroids, when the N·k bound matrix fits the budget
+ * Both produce Lloyd's assignments exactly. Elkan's per-centroid bound
+ * checks cost about as much as a 4-D distance, so Auto only picks it for
+ * large k in higher-dimensional belief spaces; it can be forced explicitly.
+ * Points are gathered into a contiguous buffer (dead agents skipped), each
+ * pass is OpenMP-parallel, and centroid sums are reduced per thread inside
+ * the assignment pass. The last pass also yields the exact inertia.
+ */
+enum class KMeansBounds { Auto, Hamerly, Elkan };
+
 class KMeansClustering {
 public:
-    KMeansClustering(int k, int maxIter = 50, double tolerance = 1e-4);
+    KMeansClustering(int k, int maxIter = 50, double tolerance = 1e-4,
+                     KMeansBounds bounds = KMeansBounds::Auto);
+
+    // Seed the next run() from these clusters' centroids instead of k-means++
+    // (a slowly drifting population then converges in a few iterations)
+    void warmStart(const std::vector<Cluster>& previous);
+
+    std::vector<Cluster> run(const Kernel& kernel);
+    std::vector<Cluster> run(const ClusteringSnapshot& snapshot);
+    int iterationsUsed() const { return iterationsUsed_; }
+    bool converged() const { return converged_; }
+    bool warmStarted() const { return warmStarted_; }
+    double inertia() const { return inertia_; }
+    bool usedElkan() const { return elkan_; }
+    // Point-centroid distances actually evaluated (naive Lloyd: N·k per pass)
+    std::uint64_t distanceEvaluations() const { return distanceEvaluations_; }
+
+private:
+    using Point = BeliefVec;
+
+    int k_;
+    int maxIter_;
+    double tolerance_;  // converged once no centroid moves farther than this
+    KMeansBounds bounds_;
+    int iterationsUsed_ = 0;
+    bool converged_ = false;
+    double inertia_ = 0.0;
+    bool elkan_ = false;
+    bool warmStarted_ = false;
+    std::uint64_t distanceEvaluations_ = 0;
+    std::vector<BeliefVec> warmCentroids_;
+
+    // Working set (snapshot rows: living agents only)
+    std::vector<Point> points_;
+    std::vector<int> assignment_;
+    std::vector<double> upper_;              // distance bound to assigned centroid
+    std::vector<double> lower_;              // Hamerly: [point]; Elkan: [point * k + centroid]
+
+    // Centroid state
+    std::vector<Point> centroids_;
+    std::vector<double> centerDist_;         // k×k centroid distances (Elkan)
+    std::vector<double> halfMinDist_;        // ½ distance to nearest other centroid
+    std::vector<double> drift_;              // centroid movement in the last update
+
+    // Per-thread centroid accumulators
+    std::vector<Point> partialSums_;
+    std::vector<std::uint32_t> partialCounts_;
+
+    void initialize(std::size_t k, std::uint64_t seed);
+    void computeCenterDistances();
+    std::size_t assignPass(bool fullScan, bool exactInertia);
+    void updateCentroids(std::mt19937_64& reseedRng);
+    void updateBounds();
+};
+
+/**
+ * Mini-batch K-means (Sculley 2010) for very large populations
+ *
+ * Each iteration draws `batchSize` living agents uniformly at random, assigns
+ * them to the nearest centroid (in parallel), then streams them into their
+ * centroids with a per-centroid learning rate 1/count, so centroid cost is
+ * O(iterations·B·k) regardless of population size.
+ *
+ * SEEDING: k-means++ over a reservoir sample of living agents (gathered in
+ * the same sweep that builds the point buffer), not over all N.
+ * CONVERGENCE: the inertia of a fixed held-out sample, checked at
+ * iterations 10, 20, 40, ...; the run stops once a checkpoint improves on
+ * the previous one by less than a relative `tolerance`. With learning rate
+ * 1/count, centroids move about as much between doublings of the iteration
+ * count as in any earlier span of the run, so the test does not weaken as
+ * steps shrink. A centroid-shift test does: the shift decays with the
+ * learning rate whether or not the centroids have settled.
+ * OUTPUT: one parallel assignment pass over every living agent produces the
+ * Cluster members and the exact inertia.
+ */
+class MiniBatchKMeansClustering {
+public:
+    MiniBatchKMeansClustering(int k, int batchSize = 1024, int maxIter = 100,
+                              double tolerance = 1e-3);
 
     std::vector<Cluster> run(const Kernel& kernel);
+    std::vector<Cluster> run(const ClusteringSnapshot& snapshot);
     int iterationsUsed() const { return iterationsUsed_; }
     bool converged() const { return converged_; }
+    double inertia() const { return inertia_; }
+    int batchSize() const { return batchSize_; }
+
+    static constexpr int kFirstCheck = 10;        // First convergence checkpoint (iterations)
+    static constexpr std::size_t kHeldOut = 2048;  // Minimum held-out sample size
 
 private:
+    using Point = BeliefVec;
+
     int k_;
+    int batchSize_;
     int maxIter_;
-    double tolerance_;
+    double tolerance_;  // converged once a checkpoint improves held-out inertia by less than this
     int iterationsUsed_ = 0;
     bool converged_ = false;
+    double inertia_ = 0.0;
 
-    static double distance(const std::array<double, 4>& a, const std::array<double, 4>& b);
-    void initialize(const std::vector<Agent>& agents, std::vector<std::array<double, 4>>& centroids);
-    void assign(const std::vector<Agent>& agents,
-                const std::vector<std::array<double, 4>>& centroids,
-                std::vector<int>& assignment);
-    void update(const std::vector<Agent>& agents,
-                const std::vector<int>& assignment,
-                std::vector<std::array<double, 4>>& centroids);
-    double inertia(const std::vector<Agent>& agents,
-                   const std::vector<std::array<double, 4>>& centroids,
-                   const std::vector<int>& assignment) const;
+    std::vector<Point> centroids_;
+    std::vector<std::uint64_t> centroidCounts_;
+    std::vector<std::uint32_t> batch_;
+    std::vector<std::uint32_t> heldOut_;     // fixed convergence sample
+    std::vector<int> batchAssignment_;
 };
 
+/**
+ * Grid-indexed parallel DBSCAN over living agents' beliefs
+ *
+ * Points are bucketed into a sparse 4-D uniform grid with cell side eps/2
+ * (sorted cell keys, so memory is O(N) however small eps is). A cell's
+ * diagonal is then exactly eps, so points sharing a cell are always
+ * neighbors, and a neighborhood query visits at most 5^4 stencil cells.
+ *   1. Core detection: cells holding minPts points are all core; other
+ *      points count neighbors in parallel, stopping at minPts
+ *   2. Linking: parallel lock-free union-find over cells - a cell's cores are
+ *      joined outright, two cells are joined at the first core pair within eps
+ *   3. Cluster ids follow each component's lowest core index; border points
+ *      join the lowest-id cluster among their core neighbors
+ * This reproduces the labels of the classic sequential expansion (which
+ * discovers clusters in scan order) without its O(N²) region queries.
+ */
 class DBSCANClustering {
 public:
     DBSCANClustering(double eps = 0.3, int minPts = 50);
 
     std::vector<Cluster> run(const Kernel& kernel);
+    std::vector<Cluster> run(const ClusteringSnapshot& snapshot);
     int noisePoints() const { return noisePoints_; }
 
 private:
     double eps_;
     int minPts_;
     int noisePoints_ = 0;
+};
+
+/**
+ * Persistent identities across successive clusterings
+ *
+ * update() matches freshly computed clusters against the live set from the
+ * previous call and relabels them in place: a matched cluster inherits the
+ * persistent id and birthTick, an unmatched one gets a new id born at `tick`,
+ * and live clusters left unmatched are retired with deathTick = tick.
+ *   - OVERLAP: Jaccard similarity of member sets, counted in one pass over
+ *     the new members against the previous agent -> cluster labels
+ *   - CENTROID: Euclidean distance between centroids (no member state)
+ * Pairs are taken greedily, best first, so each identity continues into at
+ * most one new cluster (on a split it follows the larger overlap).
+ */
+enum class ClusterMatch { Overlap, Centroid };
+
+struct ClusterTrackerConfig {
+    ClusterMatch match = ClusterMatch::Overlap;
+    double minOverlap = 0.3;            // Jaccard needed to continue an identity
+    double maxCentroidDistance = 0.25;  // Centroid mode: farthest continuation
+};
+
+struct ClusterRecord {
+    std::uint32_t id = 0;
+    BeliefVec centroid{};
+    std::uint32_t size = 0;
+    std::uint64_t birthTick = 0;
+    std::uint64_t deathTick = 0;
+};
+
+class ClusterTracker {
+public:
+    explicit ClusterTracker(const ClusterTrackerConfig& cfg = ClusterTrackerConfig());
+
+    void update(std::vector<Cluster>& clusters, std::uint64_t tick);
+    void clear();
+
+    const std::vector<ClusterRecord>& live() const { return live_; }
+    const std::vector<ClusterRecord>& retired() const { return retired_; }  // oldest first
+    const ClusterTrackerConfig& config() const { return cfg_; }
+
+private:
+    static constexpr std::size_t kMaxRetired = 1024;
+
+    ClusterTrackerConfig cfg_;
+    std::vector<ClusterRecord> live_;
+    std::vector<ClusterRecord> retired_;
+    std::vector<int> labels_;            // agent id -> index into live_ (-1 = none)
+    std::vector<std::uint32_t> overlap_; // new × live intersection counts
+    std::uint32_t nextId_ = 0;
+};
 
-    static double distance(const std::array<double, 4>& a, const std::array<double, 4>& b);
-    std::vector<std::uint32_t> regionQuery(const std::vector<Agent>& agents,
-                                           std::uint32_t idx) const;
-    void expandCluster(const std::vector<Agent>& agents,
-                       std::uint32_t idx,
-                       std::vector<std::uint32_t>& neighbors,
-                       std::vector<int>& labels,
-                       int clusterId);
+/**
+ * Silhouette sampling: exact silhouette is O(N²), so s(i) is evaluated for
+ * `sampleSize` members drawn uniformly (with replacement). Mean distances to
+ * each cluster use every member of clusters up to `referencePerCluster` in
+ * size and that many uniform draws otherwise, so one call costs at most
+ * sampleSize · k · referencePerCluster distances. The reported interval is
+ * the normal-approximation mean ± zScore · sd / √sampleSize.
+ */
+struct SilhouetteOptions {
+    std::size_t sampleSize = 1000;          // 0 disables the silhouette
+    std::size_t referencePerCluster = 200;
+    double zScore = 1.96;                   // 95% interval
+    std::uint64_t seed = 0x5EED;
 };
 
 struct ClusterMetrics {
     double withinVariance = 0.0;
     double betweenVariance = 0.0;
-    double silhouette = 0.0;
+    double varianceRatio = 0.0;   // (between - within) / max(between, within)
+    double silhouette = 0.0;      // sampled mean silhouette coefficient
+    double silhouetteLow = 0.0;   // confidence interval bounds
+    double silhouetteHigh = 0.0;
+    std::size_t silhouetteSamples = 0;
     double diversity = 0.0;
 };
 
-ClusterMetrics computeClusterMetrics(const std::vector<Cluster>& clusters, const Kernel& kernel);
+ClusterMetrics computeClusterMetrics(const std::vector<Cluster>& clusters, const Kernel& kernel,
+                                     const SilhouetteOptions& silhouette = SilhouetteOptions());
+ClusterMetrics computeClusterMetrics(const std::vector<Cluster>& clusters,
+                                     const ClusteringSnapshot& snapshot,
+                                     const SilhouetteOptions& silhouette = SilhouetteOptions());
+// Centroid, coherence, language/dialect shares and top regions for every
+// cluster in one parallel pass over agents (memberships must be disjoint)
 void enrichClusters(std::vector<Cluster>& clusters, const Kernel& kernel);
+void enrichClusters(std::vector<Cluster>& clusters, const ClusteringSnapshot& snapshot);
+
+/**
+ * Asynchronous clustering
+ *
+ * clusterAsync() captures a ClusteringSnapshot on the calling thread (the
+ * only part that reads the kernel) and runs `algorithm` plus the metrics on
+ * a worker thread. The kernel may keep stepping meanwhile; the result is
+ * tagged with the generation it describes. The algorithm is copied into the
+ * task, so its own statistics (iterations, noise) are not reported back.
+ */
+struct ClusteringResult {
+    std::uint64_t generation = 0;  // snapshot generation
+    std::vector<Cluster> clusters;
+    ClusterMetrics metrics;
+};
+
+template <typename Algorithm>
+std::future<ClusteringResult> clusterAsync(const Kernel& kernel, Algorithm algorithm,
+                                           SilhouetteOptions silhouette = SilhouetteOptions()) {
+    return std::async(std::launch::async,
+        [snapshot = ClusteringSnapshot::capture(kernel), algorithm, silhouette]() mutable {
+            ClusteringResult result;
+            result.generation = snapshot.generation;
+            result.clusters = algorithm.run(snapshot);
+            result.metrics = computeClusterMetrics(result.clusters, snapshot, silhouette);
+            return result;
+        });
+}
 
 #endif
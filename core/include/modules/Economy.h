@@ -4,19 +4,80 @@
 #include <array>
 #include <memory>
 
+#include "kernel/BeliefSpace.h"
 #include "modules/EconomyTypes.h"
 #include "modules/TradeNetwork.h"
+#include "utils/SpatialIndex.h"
 #include <cstdint>
 #include <string>
 #include <random>
 
 // Regional belief distribution profile (captures more than just mean)
 struct RegionalBeliefProfile {
-    std::array<double, 4> mean{0, 0, 0, 0};           // Average belief
-    std::array<double, 4> variance{0, 0, 0, 0};       // Spread/disagreement
-    std::array<double, 4> dominant_pole{0, 0, 0, 0};  // Which extreme is stronger (signed)
-    double polarization = 0.0;                        // Overall belief diversity
-    std::uint32_t population = 0;                     // Agents counted
+    BeliefVec mean{};               // Average belief
+    BeliefVec variance{};           // Spread/disagreement
+    BeliefVec dominant_pole{};      // Which extreme is stronger (signed)
+    double polarization = 0.0;      // Overall belief diversity
+    std::uint32_t population = 0;   // Agents counted
+};
+
+// Sufficient statistics for a RegionalBeliefProfile. Every field is a plain
+// sum over member agents, so the kernel can maintain one per region
+// incrementally (add on birth/arrival, remove on death/departure, and
+// before/after deltas when beliefs move) and merge per-thread deltas in
+// any order. profile() turns the sums into a RegionalBeliefProfile in O(1).
+struct RegionalBeliefMoments {
+    static constexpr double kPoleThreshold = 0.1;  // |B| beyond this joins a faction
+
+    std::uint32_t population = 0;
+    BeliefVec belief_sum{};
+    BeliefVec belief_sumsq{};
+    BeliefVec pos_sum{};
+    BeliefVec neg_sum{};
+    std::array<std::int32_t, kBeliefDims> pos_count{};
+    std::array<std::int32_t, kBeliefDims> neg_count{};
+
+    void add(const BeliefState& B) {
+        ++population;
+        accumulate(B, 1.0, 1);
+    }
+    void remove(const BeliefState& B) {
+        --population;
+        accumulate(B, -1.0, -1);
+    }
+    // Belief change of a member that stays in the region
+    void update(const BeliefState& before, const BeliefState& after) {
+        accumulate(before, -1.0, -1);
+        accumulate(after, 1.0, 1);
+    }
+    void merge(const RegionalBeliefMoments& delta) {
+        population += delta.population;
+        for (int d = 0; d < kBeliefDims; ++d) {
+            belief_sum[d] += delta.belief_sum[d];
+            belief_sumsq[d] += delta.belief_sumsq[d];
+            pos_sum[d] += delta.pos_sum[d];
+            neg_sum[d] += delta.neg_sum[d];
+            pos_count[d] += delta.pos_count[d];
+            neg_count[d] += delta.neg_count[d];
+        }
+    }
+
+    RegionalBeliefProfile profile() const;
+
+private:
+    void accumulate(const BeliefState& B, double sign, std::int32_t count) {
+        for (int d = 0; d < kBeliefDims; ++d) {
+            belief_sum[d] += sign * B[d];
+            belief_sumsq[d] += sign * B[d] * B[d];
+            if (B[d] > kPoleThreshold) {
+                pos_count[d] += count;
+                pos_sum[d] += sign * B[d];
+            } else if (B[d] < -kPoleThreshold) {
+                neg_count[d] += count;
+                neg_sum[d] += sign * B[d];
+            }
+        }
+    }
 };
 
 // Trade link between regions with transport costs
@@ -78,11 +139,11 @@ struct RegionalEconomy {
     double wealth_bottom_50 = 0.0;  // share held by poorest 50%
     
     // Economic system (emerges from agent beliefs + conditions)
-    std::string economic_system = "mixed";  // "market", "planned", "mixed", "feudal", "cooperative"
+    EconomicSystem economic_system = EconomicSystem::Mixed;
     double system_stability = 1.0;  // how well system fits population beliefs
     
     // Hysteresis for system transitions (prevents thrashing)
-    std::string pending_system = "";      // System we're transitioning toward (if any)
+    EconomicSystem pending_system = EconomicSystem::None;  // System we're transitioning toward (if any)
     int transition_pressure_ticks = 0;    // How many ticks sustained pressure for change
     // Number of ticks representing ~5 years of sustained pressure.
     // Assumes TICKS_PER_YEAR is the simulation tick rate (default: 10).
@@ -119,10 +180,11 @@ public:
               std::mt19937_64& rng,
               const std::string& start_condition);
     void update(const std::vector<std::uint32_t>& region_populations,
-                const std::vector<std::array<double, 4>>& region_belief_centroids,
+                const std::vector<BeliefVec>& region_belief_centroids,
                 const std::vector<Agent>& agents,
                 std::uint64_t generation,
-                const std::vector<std::vector<std::uint32_t>>* region_index = nullptr);  // Optional region index for O(R*pop/R) instead of O(N)
+                const std::vector<std::vector<std::uint32_t>>* region_index = nullptr,  // Optional region index for O(R*pop/R) instead of O(N)
+                const std::vector<RegionalBeliefProfile>* belief_profiles = nullptr);   // Optional maintained profiles: O(R) system evolution
     
     // Accessors
     const RegionalEconomy& getRegion(std::uint32_t region_id) const;
@@ -148,19 +210,41 @@ public:
     const std::vector<TradeLink>& getTradeLinks() const { return trade_links_; }
     double getTotalTrade() const;
     
+    // Spatial index over region grid positions (col, row); built at init.
+    // Reusable for any region-neighborhood query (migration, diffusion, etc.)
+    const SpatialGridIndex& regionGridIndex() const { return region_grid_index_; }
+    
+    // Trade solver: single diffusion step (default) or converged equilibrium
+    void configureTradeSolver(const TradeSolverConfig& config);
+    const TradeSolverConfig& tradeSolverConfig() const { return trade_solver_config_; }
+    const TradeSolveStats& tradeSolveStats() const;
+    
     // Policy levers (for Phase 3+)
-    void setEconomicModel(const std::string& model); // force a model globally
+    void setEconomicModel(const std::string& model); // force a model globally ("" clears)
+    void setEconomicModel(EconomicSystem model);     // EconomicSystem::None clears
     
     // Resource allocation (for war module, Phase 2.8)
     void reallocateToWar(double fraction);
     
+    // Ideal economic system for regional conditions (pure rule-table lookup)
+    // Dominant pole: the current rules
+    EconomicSystem determineEconomicSystem(const RegionalBeliefProfile& profile, 
+                                           double development,
+                                           double hardship,
+                                           double inequality) const;
+    // Legacy: uses mean-based analysis
+    EconomicSystem determineEconomicSystem(const BeliefVec& beliefs, 
+                                           double development,
+                                           double hardship,
+                                           double inequality) const;
+    
 private:
     struct StartConditionProfile {
         std::string name;
         double baseDevelopment = 0.1;
         double developmentJitter = 0.05;
         std::array<double, kGoodTypes> endowmentMultipliers = {1.0, 1.0, 1.0, 1.0, 1.0};
-        std::string defaultSystem = "mixed";
+        EconomicSystem defaultSystem = EconomicSystem::Mixed;
         double wealthLogMean = 0.0;
         double wealthLogStd = 0.7;
         double productivityMean = 1.0;
@@ -170,35 +254,42 @@ private:
     std::vector<RegionalEconomy> regions_;
     std::vector<TradeLink> trade_links_;
     std::vector<AgentEconomy> agents_;
-    std::string forced_model_ = "";  // if set, overrides emergent systems
+    EconomicSystem forced_model_ = EconomicSystem::None;  // if set, overrides emergent systems
     double war_allocation_ = 0.0;
     std::string start_condition_name_ = "baseline";
     StartConditionProfile start_profile_{};
     
     // Matrix-based trade diffusion network
     std::unique_ptr<TradeNetwork> trade_network_;
+    // Columnar per-update region state ([region][good] blocks, rebuilt every update)
+    std::vector<TradeNetwork::GoodBlock> region_needs_;   // subsistence per capita (memoized)
+    std::vector<TradeNetwork::GoodBlock> trade_surplus_;  // production - demand
+    std::vector<TradeNetwork::GoodBlock> trade_flows_;    // net trade balance
+    TradeSolverConfig trade_solver_config_;
+    SpatialGridIndex region_grid_index_;
     
     void initializeEndowments(std::mt19937_64& rng);
     void initializeTradeNetwork();
     void initializeAgents(std::uint32_t num_agents, std::mt19937_64& rng);
     
     void evolveSpecialization();
-    void computeProduction();
+    // Fused region kernel, stage 1: production, memoized needs, trade surplus
+    void computeSupply();
     void computeTrade();
-    void computeConsumption();
-    void updatePrices();
+    // Fused region kernel, stage 2: consumption, prices, welfare, hardship
+    void computeMarkets();
     void distributeIncome(const std::vector<Agent>& agents, 
                           const std::vector<std::vector<std::uint32_t>>* region_index = nullptr);
-    void computeWelfare();
     void computeInequality(const std::vector<Agent>& agents,
                            const std::vector<std::vector<std::uint32_t>>* region_index = nullptr);
-    void computeHardship();
     void evolveDevelopment();
     // New overload using dominant pole analysis
     void evolveEconomicSystems(const std::vector<Agent>& agents,
                                const std::vector<std::vector<std::uint32_t>>& region_index);
+    // Dominant pole analysis from caller-maintained profiles (no agent scan)
+    void evolveEconomicSystems(const std::vector<RegionalBeliefProfile>& belief_profiles);
     // Legacy overload using mean-based analysis
-    void evolveEconomicSystems(const std::vector<std::array<double, 4>>& region_belief_centroids);
+    void evolveEconomicSystems(const std::vector<BeliefVec>& region_belief_centroids);
 
     StartConditionProfile resolveStartCondition(const std::string& name) const;
     
@@ -208,16 +299,10 @@ private:
         const std::vector<Agent>& agents,
         const std::vector<std::vector<std::uint32_t>>& region_index) const;
     
-    // Economic system emergence - NEW: uses dominant pole, not mean
-    std::string determineEconomicSystem(const RegionalBeliefProfile& profile, 
-                                       double development,
-                                       double hardship,
-                                       double inequality) const;
-    // Legacy: uses mean-based analysis
-    std::string determineEconomicSystem(const std::array<double, 4>& beliefs, 
-                                       double development,
-                                       double hardship,
-                                       double inequality) const;
+    // Hysteresis/path-dependence transition toward `ideal`, then emergent efficiency
+    void advanceSystemTransition(RegionalEconomy& region, EconomicSystem ideal) const;
+    // Apply a forced model to every region; returns false if none is set
+    bool applyForcedModel();
     
     // Wealth distribution
     double computeRegionGini(std::uint32_t region_id, const std::vector<Agent>& agents) const;
@@ -1,6 +1,10 @@
 #ifndef ECONOMY_TYPES_H
 #define ECONOMY_TYPES_H
 
+#include <array>
+#include <cstdint>
+#include <string>
+
 // Shared economic type definitions
 constexpr int kGoodTypes = 5;
 
@@ -12,4 +16,37 @@ enum GoodType {
     SERVICES = 4
 };
 
+// Economic systems are interned as a one-byte enum; names exist only for I/O.
+enum class EconomicSystem : std::uint8_t {
+    Market = 0,
+    Planned = 1,
+    Mixed = 2,
+    Feudal = 3,
+    Cooperative = 4,
+    None = 0xFF  // no pending transition / no forced model
+};
+
+constexpr int kEconomicSystemCount = 5;
+
+// Registry: index = static_cast<int>(EconomicSystem)
+inline constexpr std::array<const char*, kEconomicSystemCount> kEconomicSystemNames = {
+    "market", "planned", "mixed", "feudal", "cooperative"
+};
+
+inline const char* economicSystemName(EconomicSystem system) {
+    auto index = static_cast<std::size_t>(system);
+    return (index < kEconomicSystemNames.size()) ? kEconomicSystemNames[index] : "none";
+}
+
+// Returns false (and leaves `out` untouched) for unknown names
+inline bool parseEconomicSystem(const std::string& name, EconomicSystem& out) {
+    for (std::size_t i = 0; i < kEconomicSystemNames.size(); ++i) {
+        if (name == kEconomicSystemNames[i]) {
+            out = static_cast<EconomicSystem>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
 #endif
@@ -0,0 +1,83 @@
+#ifndef EDGE_REPLICAS_H
+#define EDGE_REPLICAS_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "kernel/BeliefSpace.h"
+
+struct Agent;
+
+/**
+ * Edge-local quantized copies of neighbor state
+ *
+ * Every edge i <- j keeps a 16-bit fixed-point copy of B_j plus what the
+ * belief kernels read besides beliefs (comm, fluency, language, liveness),
+ * stored in agent i's row in neighbor-list order. Neighbor sweeps then read
+ * only their own rows, sequentially, instead of one random agent per edge.
+ *
+ * refresh() runs at the start of each sweep. It quantizes every agent once
+ * into a compact record (16 bytes for four axes, about 1/20 of Agent) and
+ * copies only records that changed since the last refresh, through a reverse
+ * index of the edges reading each record. When more than kGatherFraction of
+ * the records changed it streams through all edges instead, pulling each
+ * neighbor's record into place: writes are sequential and the random reads
+ * hit the small record array. Rows are rebuilt after markStale(), which the
+ * kernel calls whenever it edits neighbor lists; deaths and language changes
+ * flow through the records.
+ *
+ * Beliefs are quantized with step 1/32767 (3e-5); int8 (step 8e-3) would be
+ * coarser than a typical per-tick belief move.
+ */
+class EdgeReplicas {
+public:
+    // 16 bytes for four axes: four records per cache line
+    struct Replica {
+        std::array<std::int16_t, kBeliefDims> q{};  // B * kScale, rounded
+        float comm = 0.0f;
+        std::uint16_t fluency = 0;                  // UnitQ16 steps
+        std::int16_t lang = -1;                     // Language family, -1 if dead or missing
+    };
+
+    static constexpr double kScale = 32767.0;
+    static constexpr double kGatherFraction = 0.5;  // Changed records above which all edges are pulled
+
+    void markStale() { stale_ = true; }
+    bool stale() const { return stale_; }
+
+    // Rebuild rows if stale or resized, then copy changed agent state into the edges
+    void refresh(const std::vector<Agent>& agents);
+
+    // Agent id's row, one replica per entry of its neighbor list when last rebuilt
+    const Replica* row(std::uint32_t id) const { return replicas_.data() + offsets_[id]; }
+    std::size_t rowSize(std::uint32_t id) const { return offsets_[id + 1] - offsets_[id]; }
+    std::size_t edgeCount() const { return replicas_.size(); }
+    std::size_t rebuilds() const { return rebuilds_; }
+    std::size_t copiedEdges() const { return copied_; }  // Edges written by the last refresh
+
+    static bool live(const Replica& r) { return r.lang >= 0; }
+    static state_t belief(const Replica& r, int d) { return static_cast<state_t>(r.q[d] * (1.0 / kScale)); }
+    static BeliefState beliefs(const Replica& r) {
+        BeliefState b;
+        for (int d = 0; d < kBeliefDims; ++d) b[d] = belief(r, d);
+        return b;
+    }
+
+private:
+    std::vector<Replica> records_;     // One per agent plus a dead record
+    std::vector<Replica> replicas_;    // Per edge, rows in agent order
+    std::vector<std::size_t> offsets_; // Row starts (n + 1)
+    std::vector<std::uint32_t> cols_;  // Record read by each edge (out-of-range IDs -> dead record)
+    std::vector<std::size_t> reader_offsets_;  // Per record (n + 2), into readers_
+    std::vector<std::size_t> readers_;         // Edges reading each record, grouped by record
+    std::vector<std::uint8_t> changed_;        // Record differs from the last refresh
+    bool stale_ = true;
+    std::size_t rebuilds_ = 0;
+    std::size_t copied_ = 0;
+
+    void rebuild(const std::vector<Agent>& agents);
+};
+
+#endif
@@ -1,10 +1,15 @@
 #ifndef HEALTH_MODULE_H
 #define HEALTH_MODULE_H
 
+#include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <random>
+#include <utility>
 #include <vector>
 
+#include "kernel/Precision.h"
+
 struct Agent;
 class Economy;
 
@@ -13,15 +18,46 @@ struct Disease {
     double mortality = 0.03;
     double recovery = 0.04;
     double immunity_boost = 0.2;
+
+    // Network (SEIR) mode
+    double transmission = 0.06;   // Per infectious contact per tick, scaled by (1 - immunity)
+    int latent_ticks = 3;         // Exposed → infectious delay (0 = SIR)
+    int immune_ticks = 0;         // Recovered → susceptible delay (0 = permanent)
+    double spillover = 0.2;       // Expected outside introductions per tick
+};
+
+enum class EpidemicModel : std::uint8_t {
+    Regional,   // Independent per-agent draws against regional infection pressure
+    Network     // SEIR transmission along social ties, sparse active sets
+};
+
+enum class InfectionStage : std::uint8_t {
+    Susceptible,
+    Exposed,
+    Infectious,
+    Recovered
 };
 
 struct HealthState {
-    double physical_health = 1.0;
-    bool infected = false;
+    state_t physical_health = 1.0;
+    bool infected = false;                  // == (stage == Infectious)
+    InfectionStage stage = InfectionStage::Susceptible;
+    std::uint64_t stage_tick = 0;           // Tick the current stage began
     const Disease* current_disease = nullptr;
-    double nutrition_level = 1.0;
-    double age_factor = 0.0;
-    double immunity = 0.0;
+    state_t nutrition_level = 1.0;
+    state_t age_factor = 0.0;
+    state_t immunity = 0.0;
+};
+
+// Network-mode counters (per-tick values refer to the last stepEpidemic call)
+struct EpidemicStats {
+    std::size_t exposed = 0;
+    std::size_t infectious = 0;
+    std::size_t newExposures = 0;       // This tick, including spillovers
+    std::size_t spillovers = 0;         // This tick
+    std::size_t recoveries = 0;         // This tick
+    std::size_t edgesScanned = 0;       // Contacts of infectious agents this tick
+    std::uint64_t totalCases = 0;       // Cumulative exposures
 };
 
 struct RegionalHealthSnapshot {
@@ -35,15 +71,58 @@ class HealthModule {
 public:
     void configure(std::uint32_t regionCount, std::uint64_t seed);
     void initializeAgents(std::vector<Agent>& agents);
+    // Serial sweep over living agents (beginTick / updateAgent / finishTick)
     void updateAgents(std::vector<Agent>& agents, const Economy& economy, std::uint64_t tick);
 
+    // --- Per-agent interface for the kernel's fused parallel sweep ---
+    // Refresh regional inputs and zero one accumulator slot per thread
+    void beginTick(const Economy& economy, std::size_t threads);
+    // Thread-safe for distinct `thread` slots; draws come from a counter-based
+    // RNG keyed on (tick, agent), so results do not depend on the schedule
+    // `steps` > 1 integrates that many ticks at once (adaptive level of detail)
+    void updateAgent(Agent& agent, std::uint64_t tick, std::size_t thread, double steps = 1.0);
+    // Count an agent that is not updated this tick in the regional sums
+    void accumulate(const Agent& agent, std::size_t thread);
+    // Fold the per-thread sums into the regional snapshots
+    void finishTick();
+
     const std::vector<RegionalHealthSnapshot>& regionalSnapshots() const { return regional_snapshots_; }
 
+    // --- Network epidemic (SEIR over Agent::neighbors) ---
+    // Switching models clears all infections and the active sets
+    void setEpidemicModel(EpidemicModel model, std::vector<Agent>& agents);
+    EpidemicModel epidemicModel() const { return model_; }
+    // Transmission and stage transitions for the exposed/infectious sets only,
+    // so cost scales with infected agents and their contacts, not population.
+    // Call after beginTick() (recovery reads regional healthcare)
+    void stepEpidemic(std::vector<Agent>& agents, std::uint64_t tick);
+    // Expose one susceptible agent (index case); false if not susceptible
+    bool seedInfection(Agent& agent, std::uint64_t tick);
+    const EpidemicStats& epidemicStats() const { return stats_; }
+    const Disease& disease() const { return baseline_disease_; }
+    Disease& diseaseMut() { return baseline_disease_; }
+
 private:
+    struct RegionSums {
+        double health = 0.0;
+        std::uint32_t count = 0;
+    };
+
     std::vector<RegionalHealthSnapshot> regional_snapshots_;
+    std::vector<std::vector<RegionSums>> thread_sums_;  // [thread][region]
     std::mt19937_64 rng_{};
+    std::uint64_t seed_ = 0;
     Disease baseline_disease_{};
 
+    EpidemicModel model_ = EpidemicModel::Regional;
+    std::vector<std::uint32_t> exposed_;       // Agent IDs in stage Exposed
+    std::vector<std::uint32_t> infectious_;    // Agent IDs in stage Infectious
+    std::deque<std::pair<std::uint32_t, std::uint64_t>> waning_;  // (id, recovery tick), FIFO
+    EpidemicStats stats_;
+
+    void expose(Agent& agent, std::uint64_t tick);
+    void clearEpidemic(std::vector<Agent>& agents);
+
     double computeAgeDecay(double ageFactor) const;
     double clamp01(double value) const;
 };
@@ -0,0 +1,135 @@
+#ifndef LEVEL_OF_DETAIL_H
+#define LEVEL_OF_DETAIL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct Agent;
+class Economy;
+
+struct LodConfig {
+    bool enabled = false;
+    double tolerance = 2e-2;      // Per-tick belief drift (any dimension) of a quiet agent; ~2e-3 for pairwise runs
+    int quietUpdates = 3;         // Consecutive quiet updates before stepping down a tier
+    double wakeFactor = 4.0;      // Drift above tolerance × wakeFactor promotes the agent's neighbors
+    double econTrigger = 0.02;    // Regional hardship/welfare/stability change that promotes a region
+    double stressTrigger = 0.05;  // Per-tick stress or personal hardship change that promotes an agent
+};
+
+// Per-tick counters (tier counts cover living agents at the start of the tick)
+struct LodStats {
+    std::array<std::size_t, 4> tierCounts{};
+    std::size_t beliefUpdates = 0;
+    std::size_t wellbeingUpdates = 0;
+    std::size_t demotions = 0;
+    std::size_t neighborPromotions = 0;
+    std::size_t economyPromotions = 0;
+    std::size_t stressPromotions = 0;
+};
+
+/**
+ * Adaptive level of detail (time stepping) for agent updates
+ *
+ * Each agent sits in a tier that updates every 1, 2, 4 or 8 ticks. Tier t
+ * agents update when (tick + id) is a multiple of 2^t, so each tier's work is
+ * spread evenly over its period. An update integrates all dt ticks since the
+ * agent's last one (see stepScales), so skipped ticks are not lost.
+ *
+ * Agents step down a tier after `quietUpdates` consecutive updates whose
+ * per-tick belief drift stays below `tolerance`, and return to full rate when
+ *   - their own drift or stress change exceeds the thresholds,
+ *   - a neighbor's drift exceeds tolerance × wakeFactor,
+ *   - their region's economy moves by more than `econTrigger`,
+ *   - their personal hardship (or, with network epidemics, infection status)
+ *     changes, or they migrate.
+ *
+ * Per-agent state is kept here (structure of arrays) rather than on Agent.
+ */
+class LevelOfDetail {
+public:
+    static constexpr int kTiers = 4;
+
+    void configure(const LodConfig& cfg);
+    const LodConfig& config() const { return cfg_; }
+    bool enabled() const { return cfg_.enabled; }
+    // Promote on infection status changes (sparse network epidemics only; the
+    // regional model's per-tick coin flips are integrated by the update itself)
+    void trackInfection(bool on) { track_infection_ = on; }
+
+    // Start a kernel tick: size state for new agents (full rate), count tiers
+    void beginTick(const std::vector<Agent>& agents, std::uint64_t tick, std::size_t threads);
+    // Track agents born since beginTick (full rate)
+    void resize(std::size_t agents);
+
+    bool due(std::uint32_t id) const {
+        const std::uint64_t mask = (1ull << tier_[id]) - 1;
+        return ((tick_ + id) & mask) == 0;
+    }
+    std::uint8_t tier(std::uint32_t id) const { return tier_[id]; }
+
+    // Ticks to integrate for an update at the current tick (>= 1)
+    double beliefElapsed(std::uint32_t id) const { return elapsed(belief_last_[id]); }
+    double wellbeingElapsed(std::uint32_t id) const { return elapsed(wellbeing_last_[id]); }
+
+    // Belief step scaling for dt ticks of relaxation at per-tick rate `rate`
+    // toward a fixed target: drift × (1 - (1-rate)^dt) / rate and innovation
+    // noise × sqrt(Σ (1-rate)^2j), i.e. exact for the linearized update
+    // (≈ dt and sqrt(dt) for small rates). Both are 1 for dt = 1
+    static void stepScales(double rate, double dt, double& drift, double& noise);
+
+    // After a belief update with per-tick drift `drift` (max over dimensions).
+    // Thread-safe for distinct agents; `thread` collects neighbor wake-ups
+    void recordBeliefUpdate(std::uint32_t id, double drift, std::size_t thread);
+    // Promote neighbors of agents that drifted strongly this tick (serial)
+    void wakeNeighbors(const std::vector<Agent>& agents);
+
+    // Wellbeing sweep: true if the agent's stress inputs moved since its last update
+    bool stressorsChanged(const Agent& agent, double hardship) const;
+    // After a wellbeing update integrating `steps` ticks. Thread-safe for distinct agents
+    void recordWellbeingUpdate(const Agent& agent, double hardship, double stressBefore,
+                               double steps, std::size_t thread);
+
+    // After an economy update: promote every agent in regions whose conditions moved
+    void checkEconomy(const Economy& economy, const std::vector<std::vector<std::uint32_t>>& region_index);
+    void promote(std::uint32_t id);   // Migration, new ties, ...
+
+    // Fold per-thread counters into stats()
+    void finishTick();
+    const LodStats& stats() const { return stats_; }
+
+private:
+    struct RegionConditions {
+        double hardship = 0.0;
+        double welfare = 0.0;
+        double stability = 0.0;
+        bool valid = false;
+    };
+    struct ThreadSlot {
+        std::vector<std::uint32_t> loud;   // Agents whose drift wakes their neighbors
+        std::size_t beliefUpdates = 0;
+        std::size_t wellbeingUpdates = 0;
+        std::size_t demotions = 0;
+        std::size_t stressPromotions = 0;
+    };
+
+    LodConfig cfg_;
+    std::uint64_t tick_ = 0;
+    bool track_infection_ = false;
+    std::vector<std::uint8_t> tier_;
+    std::vector<std::uint8_t> quiet_;             // Consecutive quiet updates in the current tier
+    std::vector<std::uint64_t> belief_last_;      // Tick of the last belief update
+    std::vector<std::uint64_t> wellbeing_last_;   // Tick of the last wellbeing update
+    std::vector<float> hardship_;                 // Personal hardship at the last wellbeing update
+    std::vector<std::uint8_t> infected_;          // Infection status at the last wellbeing update
+    std::vector<RegionConditions> regions_;
+    std::vector<ThreadSlot> slots_;
+    LodStats stats_;
+
+    double elapsed(std::uint64_t last) const {
+        return tick_ > last ? static_cast<double>(tick_ - last) : 1.0;
+    }
+};
+
+#endif
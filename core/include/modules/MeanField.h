@@ -5,6 +5,8 @@
 #include <vector>
 #include <cstdint>
 
+#include "kernel/BeliefSpace.h"
+
 struct Agent;
 
 /**
@@ -12,9 +14,15 @@ struct Agent;
  * Used to blend neighbor-based and regional field influence
  */
 struct NeighborInfluence {
-    std::array<double, 4> belief_sum{0.0, 0.0, 0.0, 0.0};
+    BeliefVec belief_sum{};
     double total_weight{0.0};
     int neighbor_count{0};
+
+    void merge(const NeighborInfluence& other) {
+        belief::add<kBeliefDims>(belief_sum, other.belief_sum);
+        total_weight += other.total_weight;
+        neighbor_count += other.neighbor_count;
+    }
 };
 
 /**
@@ -45,28 +53,28 @@ public:
                        const std::vector<std::vector<std::uint32_t>>& region_index);
     
     // Get field value for a region
-    const std::array<double, 4>& getRegionalField(std::uint32_t region) const;
+    const BeliefVec& getRegionalField(std::uint32_t region) const;
     
     // Get field strength (population-weighted influence)
     double getFieldStrength(std::uint32_t region) const;
     
     // Get blended influence combining neighbor and regional field
     // neighbor_weight: 0.0 = pure regional field, 1.0 = pure neighbor influence
-    std::array<double, 4> getBlendedInfluence(
+    BeliefVec getBlendedInfluence(
         const NeighborInfluence& neighbors,
         std::uint32_t region,
         double neighbor_weight = 0.6
     ) const;
     
     // Query
-    const std::vector<std::array<double, 4>>& fields() const { return regional_fields_; }
+    const std::vector<BeliefVec>& fields() const { return regional_fields_; }
     const std::vector<double>& strengths() const { return field_strengths_; }
 
 private:
     std::uint32_t num_regions_ = 0;
     
     // Regional mean belief fields
-    std::vector<std::array<double, 4>> regional_fields_;
+    std::vector<BeliefVec> regional_fields_;
     
     // Field strength (normalized by population density)
     std::vector<double> field_strengths_;
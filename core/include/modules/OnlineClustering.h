@@ -4,63 +4,143 @@
 #include <array>
 #include <vector>
 #include <cstdint>
+#include <cstddef>
+
+#include "kernel/BeliefSpace.h"
+#include "modules/Culture.h"
 
 struct Agent;
+class Kernel;
 
 /**
- * Online (Sequential) K-Means Clustering
- * 
- * Instead of batch "stop-the-world" clustering, this updates
- * cluster centroids incrementally as agents update beliefs.
- * 
+ * Online (Sequential) K-Means Clustering - continuous culture tracker
+ *
+ * Instead of batch "stop-the-world" clustering, the kernel feeds every
+ * belief change into this tracker as it happens, so cluster sizes,
+ * centroids and coherence are always current and cost O(1) to query.
+ *
  * Algorithm:
- *   1. Initialize K centroids (once)
- *   2. For each agent belief update:
- *      - Find nearest centroid
- *      - Update centroid: C_new = C_old + α(Agent - C_old)
- *   3. Periodically reassign agents to handle drift
- * 
- * Advantages:
- *   - No computational spikes (O(1) per update)
- *   - Always-current cluster state
- *   - Spreads cost evenly across simulation
+ *   1. Seed K centroids with k-means++ and assign every living agent (once)
+ *   2. Each cluster keeps exact moments of its members (count, Σb, Σb²).
+ *      An agent's belief change moves its cluster's moments by (after -
+ *      before); the belief loops record these per OpenMP thread and the
+ *      kernel merges them after the pass, so the hot loop never shares
+ *      writes and centroids stay the exact mean of their members.
+ *   3. Reassignment is amortized: each tick a sweep re-tests 1/sweepTicks
+ *      of the population against the current centroids, so every agent is
+ *      revisited once per sweep (one Lloyd step spread over sweepTicks).
+ *   4. Births/deaths add/remove their member moments; resync() rebuilds the
+ *      moments from scratch periodically to shed floating-point drift.
+ *
+ * Coherence uses the same variance formula as enrichClusters(), so tracker
+ * numbers agree with batch clusters over the same members.
  */
 class OnlineClustering {
 public:
-    OnlineClustering(int k, double learning_rate = 0.01);
-    
-    // Initialize centroids from agent population
-    void initialize(const std::vector<Agent>& agents);
-    
-    // Update a single agent's cluster assignment and centroid
-    void updateAgent(std::uint32_t agent_id, const std::array<double, 4>& new_beliefs);
-    
-    // Periodic full reassignment (every N ticks to handle drift)
+    using Point = BeliefVec;
+
+    // Exact first and second moments of one cluster's member beliefs
+    struct Moments {
+        std::int64_t count = 0;
+        Point sum{};
+        Point sumsq{};
+
+        void add(const BeliefState& b) {
+            ++count;
+            for (int d = 0; d < kBeliefDims; ++d) {
+                sum[d] += b[d];
+                sumsq[d] += b[d] * b[d];
+            }
+        }
+        void remove(const BeliefState& b) {
+            --count;
+            for (int d = 0; d < kBeliefDims; ++d) {
+                sum[d] -= b[d];
+                sumsq[d] -= b[d] * b[d];
+            }
+        }
+        void shift(const BeliefState& before, const BeliefState& after) {
+            for (int d = 0; d < kBeliefDims; ++d) {
+                sum[d] += after[d] - before[d];
+                sumsq[d] += after[d] * after[d] - before[d] * before[d];
+            }
+        }
+        void merge(const Moments& other) {
+            count += other.count;
+            for (int d = 0; d < kBeliefDims; ++d) {
+                sum[d] += other.sum[d];
+                sumsq[d] += other.sumsq[d];
+            }
+        }
+    };
+
+    explicit OnlineClustering(int k, int sweep_ticks = 20);
+
+    // Seed centroids (k-means++ over living agents) and assign everyone
+    void initialize(const std::vector<Agent>& agents, std::uint64_t seed = 0);
+    bool initialized() const { return initialized_; }
+
+    // --- Tick-loop hooks ---
+    // Size one delta buffer per thread; call before a parallel belief pass
+    void prepareDeltas(std::size_t threads);
+    // Thread-safe for distinct `thread` slots: accumulates into that slot only
+    void recordBeliefChange(std::size_t thread, std::uint32_t agent_id,
+                            const BeliefState& before, const BeliefState& after) {
+        const int c = agent_id < assignments_.size() ? assignments_[agent_id] : -1;
+        if (c >= 0) thread_deltas_[thread][static_cast<std::size_t>(c)].shift(before, after);
+    }
+    // Fold per-thread deltas into the moments and refresh centroids: O(threads·K)
+    void mergeDeltas();
+
+    // Serial single-agent hooks
+    void onBeliefChanged(std::uint32_t agent_id, const BeliefState& before, const BeliefState& after);
+    void onAgentAdded(const Agent& agent);
+    void onAgentRemoved(const Agent& agent);
+
+    // Amortized reassignment: re-test the next 1/sweepTicks of the population
+    void sweep(const std::vector<Agent>& agents);
+    // Periodic full reassignment (one complete Lloyd step)
     void fullReassignment(const std::vector<Agent>& agents);
-    
-    // Query
-    const std::vector<std::array<double, 4>>& centroids() const { return centroids_; }
+    // Rebuild moments from current assignments (drift correction), O(N)
+    void resync(const std::vector<Agent>& agents);
+
+    // --- O(1) queries ---
+    int k() const { return k_; }
+    int sweepTicks() const { return sweep_ticks_; }
+    const std::vector<Point>& centroids() const { return centroids_; }
+    std::uint32_t clusterSize(int cluster_id) const;
+    double clusterCoherence(int cluster_id) const;
+    std::uint32_t trackedAgents() const;
     int getCluster(std::uint32_t agent_id) const;
-    std::vector<std::uint32_t> getClusterMembers(int cluster_id) const;
-    double getClusterCoherence(int cluster_id, const std::vector<Agent>& agents) const;
-    
-    // Statistics
+    double inertia() const;  // Σ squared distance of members to their centroid
     std::vector<std::uint32_t> getClusterSizes() const;
-    double getTotalInertia(const std::vector<Agent>& agents) const;
+
+    // --- O(N) views ---
+    std::vector<std::uint32_t> getClusterMembers(int cluster_id) const;
+    // Enriched Cluster records for every tracked cluster with at least
+    // `min_size` members and coherence >= `min_coherence` (screened in O(K)
+    // before the single bucketing pass over assignments)
+    std::vector<Cluster> materialize(const Kernel& kernel, std::uint32_t min_size = 1,
+                                     double min_coherence = 0.0) const;
 
 private:
     int k_;
-    double learning_rate_;
-    
+    int sweep_ticks_;
+    bool initialized_ = false;
+
     // Cluster state
-    std::vector<std::array<double, 4>> centroids_;
-    std::vector<std::uint32_t> cluster_sizes_;  // Number of agents per cluster
-    std::vector<int> assignments_;  // Agent ID → cluster ID mapping
-    
+    std::vector<Point> centroids_;          // Exact member means (as of last merge)
+    std::vector<Moments> moments_;
+    std::vector<int> assignments_;          // Agent ID → cluster ID (-1 = untracked)
+    std::size_t sweep_cursor_ = 0;
+
+    // Per-thread moment deltas, K entries per thread
+    std::vector<std::vector<Moments>> thread_deltas_;
+
     // Helpers
-    int findNearestCentroid(const std::array<double, 4>& beliefs) const;
-    double squaredDistance(const std::array<double, 4>& a, const std::array<double, 4>& b) const;
-    void updateCentroid(int cluster_id, const std::array<double, 4>& agent_beliefs);
+    int findNearestCentroid(const BeliefState& beliefs) const;
+    void refreshCentroids();
+    void reassignRange(const std::vector<Agent>& agents, std::size_t begin, std::size_t end);
 };
 
 #endif
@@ -0,0 +1,70 @@
+#ifndef PAIRWISE_INFLUENCE_H
+#define PAIRWISE_INFLUENCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "kernel/BeliefSpace.h"
+#include "modules/EdgeReplicas.h"
+
+struct Agent;
+
+/**
+ * Packed-node kernel for the exact pairwise belief update
+ *
+ * Every live edge i <- j contributes w_ij · tanh(B_j - B_i) per axis, with
+ *   w_ij = η · susceptibility_i · gate_ij · lq_ij · (comm_i + comm_j) / 2
+ *   gate_ij = max(0, (cos(B_i, B_j) - simFloor) / (1 - simFloor)), or 1 when
+ *             |B_i|² · |B_j|² < 1e-9 (both near zero)
+ *   lq_ij = (fluency_i + fluency_j) / 2 for a shared language, else 0.1
+ *
+ * build() packs everything an edge reads from its neighbor into one
+ * cache-line aligned node per agent (beliefs, inverse norm, comm, fluency,
+ * language: 64 bytes for four double axes, 32 in a float build), so an edge
+ * touches one random line instead of the three it spans in Agent, and the
+ * cosine needs no square root. accumulate() walks a range of an agent's
+ * neighbor list; each edge is one vectorized pass over the belief axes with
+ * the branch-free Padé tanh. Dead and out-of-range neighbors map to a dead
+ * node and are skipped.
+ *
+ * With edge replicas (KernelConfig::edgeReplicas) the same sum runs over the
+ * agent's EdgeReplicas row instead; only configure() is needed then.
+ */
+class PairwiseInfluence {
+public:
+    void configure(double step_size, double sim_floor);
+
+    // Configure and pack agent nodes; call once per pairwise sweep
+    void build(const std::vector<Agent>& agents, double step_size, double sim_floor);
+
+    // acc += Σ w_ij · tanh(B_j - B_i) over neighbors[edge_begin, edge_end) of `id`,
+    // and weight += Σ w_ij (the linearized relaxation rate)
+    void accumulate(std::uint32_t id, const std::uint32_t* neighbors,
+                    std::uint32_t edge_begin, std::uint32_t edge_end,
+                    BeliefState& acc, state_t& weight) const;
+
+    // Same sums over replicas row[edge_begin, edge_end) of `self`
+    void accumulate(const Agent& self, const EdgeReplicas::Replica* row,
+                    std::uint32_t edge_begin, std::uint32_t edge_end,
+                    BeliefState& acc, state_t& weight) const;
+
+private:
+    static constexpr std::size_t kNodeBytes = (kBeliefDims + 4) * sizeof(state_t);
+
+    struct alignas(kNodeBytes <= 32 ? 32 : 64) Node {
+        BeliefState B{};
+        state_t inv_norm = 0;   // 1 / |B| (capped for near-zero beliefs)
+        state_t comm = 0;
+        state_t fluency = 0;
+        state_t lang = -1;      // Language family, -1 for dead agents
+    };
+
+    std::vector<Node> nodes_;     // One per agent plus the dead node
+    std::vector<state_t> gain_;   // η · susceptibility
+    double step_size_ = 0.0;
+    state_t floor_ = 0;
+    state_t floor_scale_ = 1;     // 1 / (1 - floor)
+};
+
+#endif
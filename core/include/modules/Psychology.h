@@ -7,7 +7,10 @@
 #include <random>
 #include <vector>
 
+#include "kernel/Precision.h"
+
 struct Agent;
+struct AgentEconomy;
 class Economy;
 
 enum class StressSource : std::uint8_t {
@@ -20,12 +23,12 @@ enum class StressSource : std::uint8_t {
 };
 
 struct PsychologicalState {
-    double stress_level = 0.0;
-    double resilience = 0.5;
-    double mental_health = 0.5;
-    double cognitive_bias = 1.0;
-    std::array<double, static_cast<std::size_t>(StressSource::COUNT)> stressors{};
-    double recovery_memory = 0.0;
+    state_t stress_level = 0.0;
+    state_t resilience = 0.5;
+    state_t mental_health = 0.5;
+    state_t cognitive_bias = 1.0;
+    std::array<state_t, static_cast<std::size_t>(StressSource::COUNT)> stressors{};
+    state_t recovery_memory = 0.0;
     std::uint64_t last_shock_tick = 0;
 };
 
@@ -43,17 +46,49 @@ struct RegionalPsychologyMetrics {
     double low_mental_health_share = 0.0;
 };
 
+// Personality-derived weights on each stressor (fixed for an agent's life)
+struct StressSensitivity {
+    double economic = 0.0;       // sensitivity to economic hardship
+    double media = 0.0;          // sensitivity to negative information
+    double institutional = 0.0;  // sensitivity to institutional failures
+    double disease = 0.0;        // sensitivity to health threats
+};
+
 class PsychologyModule {
 public:
     void configure(std::uint32_t regionCount, std::uint64_t seed);
     void initializeAgents(std::vector<Agent>& agents);
+    // Serial sweep over living agents (beginTick / updateAgent / finishTick)
     void updateAgents(std::vector<Agent>& agents, const Economy& economy, std::uint64_t tick);
 
+    // --- Per-agent interface for the kernel's fused parallel sweep ---
+    // Refresh regional stress profiles, extend the sensitivity cache to new
+    // agents and zero one accumulator slot per thread
+    void beginTick(const Economy& economy, const std::vector<Agent>& agents, std::size_t threads);
+    // Thread-safe for distinct `thread` slots
+    // `steps` > 1 integrates that many ticks at once (adaptive level of detail)
+    void updateAgent(Agent& agent, const AgentEconomy& econ, std::size_t thread, double steps = 1.0);
+    // Count an agent that is not updated this tick in the regional metrics
+    void accumulate(const Agent& agent, std::size_t thread);
+    // Fold the per-thread sums into the regional metrics
+    void finishTick();
+
     const std::vector<RegionalPsychologyMetrics>& regionalMetrics() const { return regional_metrics_; }
 
 private:
+    struct RegionSums {
+        double stress = 0.0;
+        double mentalHealth = 0.0;
+        double lowMentalHealth = 0.0;
+        std::uint32_t count = 0;
+    };
+
     std::vector<RegionalStressProfile> regional_profiles_;
     std::vector<RegionalPsychologyMetrics> regional_metrics_;
+    std::vector<std::vector<RegionSums>> thread_sums_;  // [thread][region]
+    // Traits are set at birth and agent IDs are never reused, so each agent's
+    // sensitivities are computed once (indexed by agent ID)
+    std::vector<StressSensitivity> sensitivities_;
     std::mt19937_64 rng_{};
 
     double clamp01(double value) const;
@@ -9,52 +9,119 @@
 
 /**
  * Matrix-based trade network using flow diffusion
- * 
+ *
  * Replaces pairwise trade loops with algebraic diffusion:
  *   Δq = -k(L · q)
- * 
+ *
  * where:
  *   - L is the Laplacian matrix (degree matrix - adjacency matrix)
  *   - q is the resource quantity vector
  *   - k is the diffusion coefficient
  *   - Δq is the change in quantities
- * 
+ *
  * This treats trade like heat/fluid flow through a network,
  * naturally balancing supply and demand through gradient descent.
+ *
+ * STORAGE: L is kept in compressed sparse row (CSR) form. Trade graphs have
+ * ~2-15 partners per region, so the dense R×R matrix was >99% zeros and
+ * every multiply was O(R²). CSR makes L·q O(E).
+ *
+ * FUSED KERNEL: All goods are diffused together (SpMM). The surplus block
+ * is laid out [region][kGoodTypes], so one traversal of a CSR row loads
+ * each neighbor's five goods as a single contiguous lane group. Clamping
+ * and the global conservation sums are accumulated in that same sweep;
+ * the conservation correction and transport loss are then folded into a
+ * single O(R) finishing pass (the correction needs the global total, so it
+ * cannot be applied before every row has been visited).
+ *
+ * EQUILIBRIUM MODE: A single explicit step never lets trade settle. When
+ * enabled, flows are instead taken from the implicit diffusion system
+ *   (I + τ·L_s) q* = q0
+ * over the symmetrized trade graph L_s, solved with Jacobi-preconditioned
+ * conjugate gradient (SPD, so CG converges in O(√κ) sparse sweeps). τ is the
+ * equilibrium horizon: τ→∞ levels surplus across each trading bloc. The
+ * solve is warm-started from the previous tick's flows, so a slowly drifting
+ * economy converges in a handful of iterations.
  */
+struct TradeSolverConfig {
+    bool equilibrium = false;   // false = one explicit diffusion step per update
+    double horizon = 5.0;       // τ: implicit diffusion horizon
+    double tolerance = 1e-4;    // relative residual ||r|| / ||q0|| (worst good)
+    int maxIterations = 100;
+};
+
+struct TradeSolveStats {
+    int iterations = 0;
+    double residual = 0.0;      // final relative residual (worst good)
+    bool converged = true;
+    bool warmStarted = false;
+};
+
 class TradeNetwork {
 public:
+    using GoodBlock = std::array<double, kGoodTypes>;
+
     void configure(std::uint32_t num_regions);
-    
+
     // Build adjacency from trade partner lists
     void buildTopology(const std::vector<std::vector<std::uint32_t>>& trade_partners);
-    
-    // Compute trade flows via matrix diffusion
-    // Returns: trade_balance[region][good] = net exports (positive) or imports (negative)
-    std::vector<std::array<double, kGoodTypes>> computeFlows(
-        const std::vector<std::array<double, kGoodTypes>>& production,
-        const std::vector<std::array<double, kGoodTypes>>& demand,
+
+    // Fused, allocation-free diffusion step.
+    //   surplus[region][good] = production - demand
+    //   flows[region][good]   = net trade balance (positive = imports, negative = exports)
+    // `flows` is caller-owned and resized only if its size differs from numRegions().
+    void computeFlows(const std::vector<GoodBlock>& surplus,
+                      std::vector<GoodBlock>& flows,
+                      double diffusion_rate = 0.1) const;
+
+    // Convenience wrapper: builds the surplus block from production/demand
+    // and returns a freshly allocated balance vector.
+    std::vector<GoodBlock> computeFlows(
+        const std::vector<GoodBlock>& production,
+        const std::vector<GoodBlock>& demand,
         const std::vector<std::uint32_t>& population,
         double diffusion_rate = 0.1
-    );
-    
-    // Query
-    const std::vector<std::vector<double>>& laplacian() const { return laplacian_; }
+    ) const;
+
+    // Equilibrium solve (see class comment). Stores flows for the next warm start.
+    void computeEquilibriumFlows(const std::vector<GoodBlock>& surplus,
+                                 std::vector<GoodBlock>& flows);
+
+    void setSolverConfig(const TradeSolverConfig& config) { solver_config_ = config; }
+    const TradeSolverConfig& solverConfig() const { return solver_config_; }
+    const TradeSolveStats& lastSolveStats() const { return last_stats_; }
+
+    // Query (CSR view of the Laplacian off-diagonal; diagonal = degree)
     std::uint32_t numRegions() const { return num_regions_; }
+    std::uint32_t degree(std::uint32_t region) const { return degree_[region]; }
+    const std::vector<std::uint32_t>& rowOffsets() const { return row_offsets_; }
+    const std::vector<std::uint32_t>& columns() const { return columns_; }
 
 private:
     std::uint32_t num_regions_ = 0;
-    
-    // Laplacian matrix: L[i][j] = degree(i) if i==j, -1 if edge(i,j), else 0
-    std::vector<std::vector<double>> laplacian_;
-    
-    // Adjacency for transport costs
-    std::vector<std::vector<std::uint32_t>> adjacency_;
-    
-    // Helpers
-    void computeLaplacian();
-    void matrixVectorMultiply(const std::vector<double>& vec, 
-                               std::vector<double>& result) const;
+
+    // Laplacian in CSR form: L[i][i] = degree_[i], L[i][columns_[e]] = -1
+    // for e in [row_offsets_[i], row_offsets_[i+1])
+    std::vector<std::uint32_t> row_offsets_;
+    std::vector<std::uint32_t> columns_;
+    std::vector<std::uint32_t> degree_;
+
+    // Per-region transport efficiency (precomputed from degree)
+    std::vector<double> transport_factor_;
+
+    // Symmetrized (undirected) adjacency for the SPD equilibrium system
+    std::vector<std::uint32_t> sym_offsets_;
+    std::vector<std::uint32_t> sym_columns_;
+
+    // Equilibrium solver state
+    TradeSolverConfig solver_config_;
+    TradeSolveStats last_stats_;
+    std::vector<GoodBlock> warm_flows_;  // previous tick's raw equilibrium flows
+    std::vector<GoodBlock> cg_x_, cg_r_, cg_z_, cg_p_, cg_ap_;  // CG scratch
+
+    void applyEquilibriumOperator(const std::vector<GoodBlock>& in,
+                                  std::vector<GoodBlock>& out) const;
+    void finishFlows(std::vector<GoodBlock>& flows, const GoodBlock& total_flow) const;
 };
 
 #endif
@@ -0,0 +1,47 @@
+#ifndef COUNTER_RNG_H
+#define COUNTER_RNG_H
+
+#include <cmath>
+#include <cstdint>
+
+/**
+ * Counter-based random numbers (SplitMix64 finalizer)
+ *
+ * A draw is a pure function of (seed, tick, agent, stream): no generator
+ * state is shared or advanced, so a parallel agent loop produces the same
+ * numbers for any thread count or schedule, and two draws for the same agent
+ * in the same tick only need distinct stream IDs.
+ */
+namespace CounterRng {
+
+// SplitMix64 output function: a bijective 64-bit mixer
+inline std::uint64_t mix(std::uint64_t z) {
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+inline std::uint64_t bits(std::uint64_t seed, std::uint64_t tick, std::uint32_t agent,
+                          std::uint32_t stream) {
+    const std::uint64_t key = (static_cast<std::uint64_t>(agent) << 32) | stream;
+    return mix(mix(seed ^ mix(tick)) ^ key);
+}
+
+// Uniform double in [0, 1) from the top 53 bits
+inline double uniform(std::uint64_t seed, std::uint64_t tick, std::uint32_t agent,
+                      std::uint32_t stream) {
+    return static_cast<double>(bits(seed, tick, agent, stream) >> 11) * 0x1.0p-53;
+}
+
+// Standard normal (Box-Muller); uses `stream` and its high-bit twin
+inline double normal(std::uint64_t seed, std::uint64_t tick, std::uint32_t agent,
+                     std::uint32_t stream) {
+    const double u1 = 1.0 - uniform(seed, tick, agent, stream);  // (0, 1]
+    const double u2 = uniform(seed, tick, agent, stream ^ 0x80000000u);
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+}
+
+}  // namespace CounterRng
+
+#endif
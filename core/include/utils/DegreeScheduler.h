@@ -0,0 +1,125 @@
+#ifndef DEGREE_SCHEDULER_H
+#define DEGREE_SCHEDULER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <omp.h>
+
+// Per-thread work done by the last DegreeScheduler::run()
+struct SchedulerLoad {
+    std::vector<std::size_t> tasks;   // Tasks taken by each thread
+    std::vector<std::size_t> cost;    // Items + edges processed by each thread
+    std::vector<double> seconds;      // Busy time of each thread
+
+    // Slowest thread's busy time over the mean (1 = perfectly balanced)
+    double imbalance() const;
+};
+
+/**
+ * Edge-balanced task partition for graph sweeps over items with neighbor lists
+ *
+ * An item costs 1 + degree. Tasks cut the prefix sum of costs into pieces of
+ * about equal cost, snapped to item boundaries, except that an item costing
+ * more than a whole task (a hub) is split across tasks by edge range. Tasks
+ * are handed out with `schedule(dynamic, 1)` from OpenMP's persistent thread
+ * pool, so a thread that drew cheap tasks keeps taking more.
+ *
+ * Each piece of a split item gets a partial slot: the visitor accumulates it
+ * there, and the caller folds slots into the item afterwards (see splits()).
+ * Task boundaries depend only on the costs, not on the thread count, so
+ * results are identical for any number of threads.
+ */
+class DegreeScheduler {
+public:
+    // A split item and its partial slots [slot_begin, slot_end), in edge order
+    struct Split {
+        std::uint32_t id;
+        std::uint32_t slot_begin;
+        std::uint32_t slot_end;
+    };
+
+    static constexpr std::size_t kTargetTasks = 512;
+    static constexpr std::size_t kMinTaskCost = 1024;
+
+    // `degree(i)` is the number of edges item i will visit (0 for items the
+    // sweep skips, which then cost 1)
+    template <typename DegreeFn>
+    void build(std::size_t items, DegreeFn&& degree);
+
+    // Call visit(id, edge_begin, edge_end, slot, thread) for every item with
+    // its edge range; slot is -1 for a whole item, else its partial slot
+    template <typename Visit>
+    void run(Visit&& visit);
+
+    std::size_t taskCount() const { return tasks_.size(); }
+    std::size_t partialSlots() const { return slots_; }
+    const std::vector<Split>& splits() const { return splits_; }
+    const SchedulerLoad& load() const { return load_; }
+
+private:
+    struct Task {
+        std::uint64_t begin, end;   // Cost range
+        std::uint32_t first;        // Item containing `begin`
+        std::int32_t first_slot;    // Slot of a partial first item, else -1
+        std::int32_t last_slot;     // Slot of a partial last item, else -1
+    };
+
+    std::vector<std::uint64_t> offsets_;   // Item i spans [offsets_[i], offsets_[i+1])
+    std::vector<Task> tasks_;
+    std::vector<Split> splits_;
+    std::size_t slots_ = 0;
+    SchedulerLoad load_;
+
+    void partition();
+};
+
+template <typename DegreeFn>
+void DegreeScheduler::build(std::size_t items, DegreeFn&& degree) {
+    offsets_.resize(items + 1);
+    offsets_[0] = 0;
+    for (std::size_t i = 0; i < items; ++i) {
+        offsets_[i + 1] = offsets_[i] + 1 + static_cast<std::uint64_t>(degree(i));
+    }
+    partition();
+}
+
+template <typename Visit>
+void DegreeScheduler::run(Visit&& visit) {
+    const std::size_t threads = static_cast<std::size_t>(std::max(1, omp_get_max_threads()));
+    load_.tasks.assign(threads, 0);
+    load_.cost.assign(threads, 0);
+    load_.seconds.assign(threads, 0.0);
+    const std::int64_t count = static_cast<std::int64_t>(tasks_.size());
+
+    #pragma omp parallel
+    {
+        const std::size_t tid = static_cast<std::size_t>(omp_get_thread_num());
+        const double start = omp_get_wtime();
+
+        #pragma omp for schedule(dynamic, 1) nowait
+        for (std::int64_t tt = 0; tt < count; ++tt) {
+            const Task& task = tasks_[static_cast<std::size_t>(tt)];
+            for (std::uint32_t i = task.first; offsets_[i] < task.end; ++i) {
+                const std::uint64_t lo = std::max(offsets_[i], task.begin);
+                const std::uint64_t hi = std::min(offsets_[i + 1], task.end);
+                std::int32_t slot = -1;
+                if (lo != offsets_[i] || hi != offsets_[i + 1]) {
+                    slot = (i == task.first && task.first_slot >= 0) ? task.first_slot : task.last_slot;
+                }
+                // Position 0 of an item is the item itself, position 1 + e is edge e
+                const std::uint64_t base = offsets_[i] + 1;
+                const auto edge_begin = static_cast<std::uint32_t>(lo > base ? lo - base : 0);
+                const auto edge_end = static_cast<std::uint32_t>(hi > base ? hi - base : 0);
+                visit(i, edge_begin, edge_end, slot, tid);
+            }
+            load_.tasks[tid]++;
+            load_.cost[tid] += task.end - task.begin;
+        }
+        load_.seconds[tid] = omp_get_wtime() - start;
+    }
+}
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef MEMBERSHIP_BITMAP_H
+#define MEMBERSHIP_BITMAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Compressed set of 32-bit agent IDs (roaring-style)
+ *
+ * IDs are split into a 16-bit high key and a 16-bit low value. Each key owns
+ * one container holding the low values either as a sorted uint16 array (up to
+ * 4096 entries, 2 bytes per member) or as a 65536-bit bitmap (8 KB, dense
+ * chunks). Containers convert automatically, so a movement concentrated in a
+ * few ID ranges costs ~1 bit per agent and a sparse one ~2 bytes per member.
+ *
+ * Set operations work container by container: array∩array is a merge,
+ * array∩bitmap probes bits, and bitmap∘bitmap runs 1024-word AND/OR/ANDNOT
+ * loops with popcount that the compiler vectorizes. Cardinality-only queries
+ * (andCardinality) never materialize a result.
+ */
+class MembershipBitmap {
+public:
+    static constexpr std::size_t kArrayMax = 4096;   // Array → bitmap threshold
+    static constexpr std::size_t kWords = 1024;      // 65536 bits per bitmap container
+
+    MembershipBitmap() = default;
+    // Build from ascending, duplicate-free IDs in O(n)
+    static MembershipBitmap fromSorted(const std::vector<std::uint32_t>& ids);
+
+    void add(std::uint32_t id);
+    bool remove(std::uint32_t id);
+    bool contains(std::uint32_t id) const;
+    void clear() { containers_.clear(); }
+
+    std::size_t cardinality() const;
+    bool empty() const { return containers_.empty(); }
+    std::vector<std::uint32_t> toVector() const;   // Ascending
+    std::size_t bytes() const;                     // Payload memory
+
+    // Set algebra
+    static std::size_t andCardinality(const MembershipBitmap& a, const MembershipBitmap& b);
+    static MembershipBitmap andOf(const MembershipBitmap& a, const MembershipBitmap& b);
+    static MembershipBitmap orOf(const MembershipBitmap& a, const MembershipBitmap& b);
+    static MembershipBitmap andNotOf(const MembershipBitmap& a, const MembershipBitmap& b);
+    // |a ∩ b| / |a ∪ b| (0 when both are empty)
+    static double jaccard(const MembershipBitmap& a, const MembershipBitmap& b);
+
+    bool operator==(const MembershipBitmap& other) const;
+
+private:
+    struct Container {
+        std::uint16_t key = 0;
+        std::uint32_t card = 0;
+        std::vector<std::uint16_t> array;   // Sorted low values (array form)
+        std::vector<std::uint64_t> words;   // kWords words (bitmap form), else empty
+
+        bool isBitmap() const { return !words.empty(); }
+        bool contains(std::uint16_t low) const;
+        void toBitmap();
+        void normalize();   // Bitmap → array once card <= kArrayMax
+    };
+
+    std::vector<Container> containers_;     // Ascending by key
+
+    std::size_t findContainer(std::uint16_t key) const;  // Index of first key >= `key`
+
+    enum class Op { And, Or, AndNot };
+    static Container combine(const Container& a, const Container& b, Op op);
+    static std::size_t andCardinality(const Container& a, const Container& b);
+};
+
+#endif
@@ -16,7 +16,7 @@ namespace serialization {
 
 // Magic number and version for checkpoint files
 constexpr std::uint32_t CHECKPOINT_MAGIC = 0x45435356;  // "VCSE" in hex
-constexpr std::uint32_t CHECKPOINT_VERSION = 1;
+constexpr std::uint32_t CHECKPOINT_VERSION = 2;  // v2: economic system stored as a 1-byte enum
 
 // Checkpoint header
 struct CheckpointHeader {
@@ -57,6 +57,30 @@ void readBinaryArray(std::ifstream& in, std::array<T, N>& arr) {
     in.read(reinterpret_cast<char*>(arr.data()), sizeof(T) * N);
 }
 
+// Agent state values are stored as double whatever the build's storage
+// precision (AGENT_FLOAT_STATE), so checkpoints load in either build
+template<typename T>
+void writeReal(std::ofstream& out, const T& value) {
+    writeBinary(out, static_cast<double>(value));
+}
+
+template<typename T>
+void readReal(std::ifstream& in, T& value) {
+    double stored = 0.0;
+    readBinary(in, stored);
+    value = stored;
+}
+
+template<typename T, std::size_t N>
+void writeRealArray(std::ofstream& out, const std::array<T, N>& arr) {
+    for (const auto& value : arr) writeReal(out, value);
+}
+
+template<typename T, std::size_t N>
+void readRealArray(std::ifstream& in, std::array<T, N>& arr) {
+    for (auto& value : arr) readReal(in, value);
+}
+
 // Write vector
 template<typename T>
 void writeBinaryVector(std::ofstream& out, const std::vector<T>& vec) {
@@ -0,0 +1,69 @@
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * Uniform-grid spatial index over 2D points (region coordinates)
+ *
+ * Points are bucketed into square cells with a counting sort, so build is
+ * O(P) and a query only visits cells in expanding Chebyshev rings around the
+ * query cell until no unvisited cell can beat the current k-th best.
+ *
+ * WEIGHTED k-NN: Queries may scale each candidate's Euclidean distance by a
+ * per-point weight (e.g. terrain/resource "closeness"). Pruning stays exact
+ * as long as the caller supplies a lower bound on the weights: a point in
+ * ring r+1 or beyond is at least r·cellSize away, so its effective distance
+ * is at least r·cellSize·minWeight.
+ *
+ * Results are ordered by (distance, index) - identical to sorting the full
+ * candidate list with std::pair ordering, so callers that previously did a
+ * brute-force sort get bit-identical neighbor lists.
+ *
+ * Queries are const and reentrant: safe to call from parallel loops with a
+ * per-thread output buffer.
+ */
+class SpatialGridIndex {
+public:
+    using Point = std::array<double, 2>;
+    using Neighbor = std::pair<double, std::uint32_t>;  // (effective distance, point index)
+
+    void build(const std::vector<Point>& points, double cell_size);
+
+    // k nearest points to `query` by distance · weights[j] (weights may be null = 1.0).
+    // `exclude` is skipped (pass a value >= size() to keep everything).
+    // `out` is cleared and receives at most k neighbors, nearest first.
+    void kNearest(const Point& query, std::size_t k,
+                  const std::vector<double>* weights, double min_weight,
+                  std::uint32_t exclude, std::vector<Neighbor>& out) const;
+
+    // All points within Euclidean `radius` of `query`, nearest first.
+    void withinRadius(const Point& query, double radius,
+                      std::vector<Neighbor>& out) const;
+
+    std::size_t size() const { return points_.size(); }
+    const Point& point(std::uint32_t index) const { return points_[index]; }
+
+private:
+    std::vector<Point> points_;
+    double cell_size_ = 1.0;
+    double min_x_ = 0.0;
+    double min_y_ = 0.0;
+    int cells_x_ = 0;
+    int cells_y_ = 0;
+
+    // Counting-sorted buckets: cell c holds cell_points_[cell_start_[c] .. cell_start_[c+1])
+    std::vector<std::uint32_t> cell_start_;
+    std::vector<std::uint32_t> cell_points_;
+
+    int cellCoord(double v, double origin, int cells) const;
+
+    // Visit every point in cells at Chebyshev ring `ring` around (cx, cy)
+    template <typename Visitor>
+    void visitRing(int cx, int cy, int ring, Visitor&& visit) const;
+};
+
+#endif
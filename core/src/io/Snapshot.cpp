@@ -25,8 +25,10 @@ std::string kernelToJson(const Kernel& kernel, bool includeTraits) {
         os << "\"id\":" << a.id << ",";
         os << "\"region\":" << a.region << ",";
         os << "\"lang\":" << static_cast<int>(a.primaryLang) << ",";
-        os << "\"beliefs\":[" << a.B[0] << "," << a.B[1] << "," 
-           << a.B[2] << "," << a.B[3] << "]";
+        os << "\"beliefs\":[";
+        for (int d = 0; d < kBeliefDims; ++d) {
+            os << a.B[d] << (d + 1 < kBeliefDims ? "," : "]");
+        }
         
         if (includeTraits) {
             os << ",\"traits\":{";
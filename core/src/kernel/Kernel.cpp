@@ -1,37 +1,27 @@
 #include "kernel/Kernel.h"
 #include "modules/Culture.h"
+#include "utils/CounterRng.h"
 #include "utils/Validation.h"
 #include <cmath>
 #include <algorithm>
 #include <numeric>
 #include <unordered_set>
 #include <functional>
-#include <thread>
-#include <atomic>
 #include <omp.h>
 
-// Thread-local RNG for parallel operations (prevents race conditions)
-// Uses a combination of random_device + thread ID + global counter for unique seeding
 namespace {
-    std::atomic<uint64_t> global_seed_counter{0};
-    
-    uint64_t generateThreadSeed() {
-        std::random_device rd;
-        uint64_t base = rd();
-        uint64_t thread_component = static_cast<uint64_t>(
-            std::hash<std::thread::id>{}(std::this_thread::get_id()));
-        uint64_t counter = global_seed_counter.fetch_add(1, std::memory_order_relaxed);
-        return base ^ (thread_component * 0x9e3779b97f4a7c15ULL) ^ (counter * 0xbf58476d1ce4e5b9ULL);
-    }
-    
-    thread_local std::mt19937_64 tl_rng{generateThreadSeed()};
-    
-    std::mt19937_64& getThreadLocalRNG() {
-        return tl_rng;
-    }
+    // Innovation noise is a counter-based draw per (tick, agent, axis): the
+    // hybrid update is reproducible for a seed at any thread count
+    constexpr std::uint64_t kInnovationSalt = 0x94D049BB133111EBULL;
 }
 
 Kernel::Kernel(const KernelConfig& cfg) : cfg_(cfg), rng_(cfg.seed) {
+    // Belief dimensionality is fixed at build time
+    if (cfg.beliefDims != kBeliefDims) {
+        throw std::invalid_argument("beliefDims " + std::to_string(cfg.beliefDims) +
+                                    " not available: built with BELIEF_DIMS=" + std::to_string(kBeliefDims));
+    }
+    
     // Validate demographic parameters
     if (cfg.demographyEnabled) {
         if (cfg.ticksPerYear <= 0) {
@@ -60,9 +50,13 @@ void Kernel::reset(const KernelConfig& cfg) {
     rng_.seed(cfg.seed);
     psychology_.configure(cfg_.regions, cfg_.seed ^ 0x9E3779B97F4A7C15ULL);
     health_.configure(cfg_.regions, cfg_.seed ^ 0xBF58476D1CE4E5B9ULL);
+    lod_.configure(cfg_.lod);
     mean_field_.configure(cfg_.regions);
     
     // Initialize economy FIRST so we have region coordinates
+    TradeSolverConfig tradeSolver = economy_.tradeSolverConfig();
+    tradeSolver.equilibrium = cfg_.tradeEquilibrium;
+    economy_.configureTradeSolver(tradeSolver);
     economy_.init(cfg_.regions, cfg_.population, rng_, cfg_.startCondition);
     
     initAgents();
@@ -73,6 +67,9 @@ void Kernel::reset(const KernelConfig& cfg) {
     
     psychology_.initializeAgents(agents_);
     health_.initializeAgents(agents_);
+    if (cfg_.networkEpidemic) {
+        health_.setEpidemicModel(EpidemicModel::Network, agents_);
+    }
     
     // Initialize incremental regional aggregates
     regional_aggregates_.resize(cfg_.regions);
@@ -80,6 +77,19 @@ void Kernel::reset(const KernelConfig& cfg) {
     sorted_attractive_regions_.resize(cfg_.regions);
     rebuildRegionalAggregates();
     aggregates_initialized_ = true;
+    
+    enableCultureTracker(cfg_.cultureTrackerK, cfg_.cultureTrackerSweepTicks);
+}
+
+void Kernel::enableCultureTracker(std::uint32_t k, int sweep_ticks) {
+    cfg_.cultureTrackerK = k;
+    cfg_.cultureTrackerSweepTicks = sweep_ticks;
+    if (k == 0) {
+        culture_tracker_.reset();
+        return;
+    }
+    culture_tracker_ = std::make_unique<OnlineClustering>(static_cast<int>(k), sweep_ticks);
+    culture_tracker_->initialize(agents_, cfg_.seed ^ generation_);
 }
 
 void Kernel::initAgents() {
@@ -152,19 +162,19 @@ void Kernel::initAgents() {
         // [1] Tradition-Progress: NW/NE positive (tradition), SW/SE negative (progress)
         // [2] Hierarchy-Equality: varies by wealth/development tendency
         // [3] Isolation-Unity: varies by coastal/central position
-        std::array<double, 4> regional_bias = {
-            (nw_pull + sw_pull) * 0.6 - (ne_pull + se_pull) * 0.6,  // Authority axis
-            (nw_pull + ne_pull) * 0.5 - (sw_pull + se_pull) * 0.5,  // Tradition axis
-            (nw_pull + se_pull) * 0.4 - (ne_pull + sw_pull) * 0.4,  // Hierarchy axis
-            (sw_pull + se_pull) * 0.3 - (nw_pull + ne_pull) * 0.3   // Unity axis
-        };
+        // Axes 4+ (wider builds) start unbiased
+        BeliefVec regional_bias{};
+        regional_bias[0] = (nw_pull + sw_pull) * 0.6 - (ne_pull + se_pull) * 0.6;  // Authority axis
+        regional_bias[1] = (nw_pull + ne_pull) * 0.5 - (sw_pull + se_pull) * 0.5;  // Tradition axis
+        regional_bias[2] = (nw_pull + se_pull) * 0.4 - (ne_pull + sw_pull) * 0.4;  // Hierarchy axis
+        regional_bias[3] = (sw_pull + se_pull) * 0.3 - (nw_pull + ne_pull) * 0.3;  // Unity axis
         
         // Initialize beliefs with geographic bias + individual noise
-        for (int k = 0; k < 4; ++k) {
+        for (int k = 0; k < kBeliefDims; ++k) {
             a.x[k] = regional_bias[k] + beliefNoise(rng_);
             a.B[k] = fastTanh(a.x[k]);
         }
-        a.B_norm_sq = a.B[0]*a.B[0] + a.B[1]*a.B[1] + a.B[2]*a.B[2] + a.B[3]*a.B[3];
+        a.B_norm_sq = belief::normSq<kBeliefDims>(a.B);
         
         // Module multipliers (initialized; modules will update)
         a.m_comm = 1.0;
@@ -255,6 +265,7 @@ void Kernel::buildSmallWorld() {
         }
         agent.neighbors = std::move(cleaned);
     }
+    replicas_.markStale();
 }
 
 void Kernel::assignLanguagesByGeography() {
@@ -356,64 +367,88 @@ void Kernel::updateBeliefs() {
         // Compute regional fields once
         mean_field_.computeFields(agents_, regionIndex_);
         
-        // Pre-compute neighbor influences in parallel
-        std::vector<NeighborInfluence> neighbor_influences(agents_.size());
+        // Pre-compute neighbor influences in parallel (only for agents due this tick)
         const std::size_t n = agents_.size();
+        const bool lod = lod_.enabled();
+        std::vector<NeighborInfluence> neighbor_influences(n);
+        const bool replicas = cfg_.edgeReplicas;
+        if (replicas) replicas_.refresh(agents_);
         
-        #pragma omp parallel for schedule(static)
-        for (std::size_t i = 0; i < n; ++i) {
+        // Tasks of equal edge count; hubs are split and their partial sums folded after
+        belief_sched_.build(n, [&](std::size_t i) {
             const Agent& agent = agents_[i];
-            if (!agent.alive) continue;
+            const bool active = agent.alive && !(lod && !lod_.due(static_cast<std::uint32_t>(i)));
+            if (!active) return std::size_t{0};
+            return replicas ? replicas_.rowSize(static_cast<std::uint32_t>(i)) : agent.neighbors.size();
+        });
+        std::vector<NeighborInfluence> partials(belief_sched_.partialSlots());
+        
+        belief_sched_.run([&](std::uint32_t i, std::uint32_t begin, std::uint32_t end,
+                              std::int32_t slot, std::size_t) {
+            const Agent& agent = agents_[i];
+            if (!agent.alive || (lod && !lod_.due(i))) return;
+            
+            auto& influence = slot < 0 ? neighbor_influences[i] : partials[static_cast<std::size_t>(slot)];
             
-            auto& influence = neighbor_influences[i];
+            if (replicas) {
+                // Same sum over the agent's own row of neighbor copies
+                const EdgeReplicas::Replica* row = replicas_.row(i);
+                for (std::uint32_t e = begin; e < end; ++e) {
+                    if (!EdgeReplicas::live(row[e])) continue;
+                    const BeliefState neighbor = EdgeReplicas::beliefs(row[e]);
+                    const double weight = homophilyWeight(agent.B, neighbor, row[e].lang == agent.primaryLang);
+                    belief::addScaled<kBeliefDims>(influence.belief_sum, neighbor, weight);
+                    influence.total_weight += weight;
+                    influence.neighbor_count++;
+                }
+                return;
+            }
             
-            for (std::uint32_t n_idx : agent.neighbors) {
+            for (std::uint32_t e = begin; e < end; ++e) {
+                const std::uint32_t n_idx = agent.neighbors[e];
                 if (n_idx >= agents_.size()) continue;
                 const Agent& neighbor = agents_[n_idx];
                 if (!neighbor.alive) continue;
                 
                 // EXPONENTIAL HOMOPHILY: Creates strong echo chamber effect
                 // Similar agents influence each other MUCH more than dissimilar ones
-                double dot = 0.0, norm_a = 0.0, norm_n = 0.0;
-                for (int b = 0; b < 4; ++b) {
-                    dot += agent.B[b] * neighbor.B[b];
-                    norm_a += agent.B[b] * agent.B[b];
-                    norm_n += neighbor.B[b] * neighbor.B[b];
-                }
-                double similarity = (norm_a > 1e-9 && norm_n > 1e-9) ?
-                    dot / (std::sqrt(norm_a) * std::sqrt(norm_n)) : 0.0;
-                
-                // EXPONENTIAL weighting: e^(similarity * kHomophilyExponent)
-                // This creates STRONG echo chambers - similar agents dominate influence
-                double weight = std::exp(similarity * TuningConstants::kHomophilyExponent);
-                weight = std::clamp(weight, TuningConstants::kHomophilyMinWeight, 
-                                   TuningConstants::kHomophilyMaxWeight);
-                
-                // Language bonus: shared language strengthens influence
-                if (neighbor.primaryLang == agent.primaryLang) {
-                    weight *= TuningConstants::kLanguageBonusMultiplier;
-                }
+                const double weight = homophilyWeight(agent.B, neighbor.B,
+                                                      neighbor.primaryLang == agent.primaryLang);
                 
                 // Accumulate weighted beliefs
-                for (int b = 0; b < 4; ++b) {
-                    influence.belief_sum[b] += neighbor.B[b] * weight;
-                }
+                belief::addScaled<kBeliefDims>(influence.belief_sum, neighbor.B, weight);
                 influence.total_weight += weight;
                 influence.neighbor_count++;
             }
+        });
+        
+        for (const auto& split : belief_sched_.splits()) {
+            for (std::uint32_t slot = split.slot_begin; slot < split.slot_end; ++slot) {
+                neighbor_influences[split.id].merge(partials[slot]);
+            }
         }
         
         // Apply blended influence with belief innovation
         const double stepSize = cfg_.stepSize;
+        const std::uint64_t innovation_seed = cfg_.seed ^ kInnovationSalt;
+        prepareBeliefDeltas();
         
-        #pragma omp parallel for schedule(dynamic)
+        #pragma omp parallel
+        {
+        const std::size_t tid = static_cast<std::size_t>(omp_get_thread_num());
+        auto& deltas = belief_deltas_[tid];
+        OnlineClustering* tracker = culture_tracker_.get();
+        
+        #pragma omp for schedule(dynamic, 64)
         for (std::size_t i = 0; i < n; ++i) {
             auto& agent = agents_[i];
-            if (!agent.alive) continue;
+            if (!agent.alive || (lod && !lod_.due(static_cast<std::uint32_t>(i)))) continue;
+            const BeliefState before = agent.B;
+            
+            const double dt = lod ? lod_.beliefElapsed(static_cast<std::uint32_t>(i)) : 1.0;
+            double drift = 0.0;
             
-            // Thread-local RNG for innovation noise
-            auto& rng = getThreadLocalRNG();
-            std::normal_distribution<double> noise_dist(0.0, TuningConstants::kInnovationNoise);
+            const NeighborInfluence& influence = neighbor_influences[i];
             
             // Calculate neighbor weight based on conformity and network size
             // HIGH neighbor weight = rely on close network (echo chambers)
@@ -423,14 +458,14 @@ void Kernel::updateBeliefs() {
                                    - agent.conformity * (TuningConstants::kNeighborWeightMax - TuningConstants::kNeighborWeightMin);
             
             // Isolated agents (few neighbors) must rely more on regional field
-            if (neighbor_influences[i].neighbor_count < 2) {
+            if (influence.neighbor_count < 2) {
                 neighbor_weight = 0.4;  // Still significant regional influence
             }
             neighbor_weight = std::clamp(neighbor_weight, 0.4, 0.9);
             
             // Get blended social influence
             auto social_influence = mean_field_.getBlendedInfluence(
-                neighbor_influences[i], agent.region, neighbor_weight
+                influence, agent.region, neighbor_weight
             );
             
             // BELIEF ANCHORING: Agents resist changing core beliefs
@@ -445,96 +480,152 @@ void Kernel::updateBeliefs() {
             adapt_rate *= (0.7 + agent.openness * 0.6);
             adapt_rate *= (1.0 - anchoring * 0.5);  // Anchoring reduces adaptation
             
-            for (int b = 0; b < 4; ++b) {
+            // Level of detail: integrate every tick since the last update
+            double drift_scale = 1.0, noise_scale = 1.0;
+            if (lod) LevelOfDetail::stepScales(adapt_rate, dt, drift_scale, noise_scale);
+            
+            for (int b = 0; b < kBeliefDims; ++b) {
                 // Social influence pull (reduced)
                 double delta = adapt_rate * fastTanh(social_influence[b] - agent.B[b]);
                 
                 // BELIEF INNOVATION: Random drift creates variation
                 // Young and open agents innovate more
-                double innovation = noise_dist(rng) * (1.5 - age_factor) * (0.5 + agent.openness);
+                double innovation = TuningConstants::kInnovationNoise
+                                  * CounterRng::normal(innovation_seed, generation_, agent.id, static_cast<std::uint32_t>(b))
+                                  * (1.5 - age_factor) * (0.5 + agent.openness);
                 
+                if (lod) {
+                    drift = std::max(drift, std::abs(delta));
+                    delta *= drift_scale;
+                    innovation *= noise_scale;
+                }
                 agent.x[b] += delta + innovation;
                 agent.B[b] = fastTanh(agent.x[b]);
             }
             
             // Update cached norm
-            agent.B_norm_sq = agent.B[0] * agent.B[0] +
-                             agent.B[1] * agent.B[1] +
-                             agent.B[2] * agent.B[2] +
-                             agent.B[3] * agent.B[3];
+            agent.B_norm_sq = belief::normSq<kBeliefDims>(agent.B);
             
             // Validate beliefs (debug builds only)
-            validation::checkBeliefs(agent.B.data(), 4, "updateBeliefs (hybrid)");
+            validation::checkBeliefs(agent.B.data(), kBeliefDims, "updateBeliefs (hybrid)");
             validation::checkNonNegative(agent.B_norm_sq, "B_norm_sq");
+            
+            deltas.record(agent.region, before, agent.B);
+            if (tracker) tracker->recordBeliefChange(tid, static_cast<std::uint32_t>(i), before, agent.B);
+            if (lod) lod_.recordBeliefUpdate(static_cast<std::uint32_t>(i), drift, tid);
         }
+        }  // omp parallel
+        
+        mergeBeliefDeltas();
+        if (lod) lod_.wakeNeighbors(agents_);
     } else {
         // **ORIGINAL PAIRWISE UPDATES**: O(N·k) complexity
-        // Compute deltas in parallel-friendly way
-        std::vector<std::array<double, 4>> dx(agents_.size());
-        
+        // Neighbor state is packed into one compact node per agent; each task
+        // runs the kernel over its range of the agent's neighbor list
+        // (or over the agent's own row of edge replicas)
         const std::size_t n = agents_.size();
-        const double stepSize = cfg_.stepSize;
+        const bool lod = lod_.enabled();
+        const bool replicas = cfg_.edgeReplicas;
+        if (replicas) {
+            replicas_.refresh(agents_);
+            pairwise_.configure(cfg_.stepSize, cfg_.simFloor);
+        } else {
+            pairwise_.build(agents_, cfg_.stepSize, cfg_.simFloor);
+        }
+        belief_dx_.resize(n);
+        belief_rate_.resize(n);
+        auto& dx = belief_dx_;
+        auto& rate = belief_rate_;
+        
+        // Tasks of equal edge count (agents not due this tick have none); hubs
+        // are split and their partial deltas folded after
+        belief_sched_.build(n, [&](std::size_t i) {
+            const bool active = agents_[i].alive && !(lod && !lod_.due(static_cast<std::uint32_t>(i)));
+            if (!active) return std::size_t{0};
+            return replicas ? replicas_.rowSize(static_cast<std::uint32_t>(i)) : agents_[i].neighbors.size();
+        });
+        belief_partials_.resize(belief_sched_.partialSlots());
+        belief_partial_rates_.resize(belief_sched_.partialSlots());
+        auto& partials = belief_partials_;
+        auto& partial_rates = belief_partial_rates_;
+        
+        belief_sched_.run([&](std::uint32_t i, std::uint32_t begin, std::uint32_t end,
+                              std::int32_t slot, std::size_t) {
+            BeliefState acc{};
+            state_t weight = 0;
+            if (replicas) {
+                pairwise_.accumulate(agents_[i], replicas_.row(i), begin, end, acc, weight);
+            } else {
+                pairwise_.accumulate(i, agents_[i].neighbors.data(), begin, end, acc, weight);
+            }
+            if (slot < 0) {
+                dx[i] = acc;
+                rate[i] = weight;
+            } else {
+                partials[static_cast<std::size_t>(slot)] = acc;
+                partial_rates[static_cast<std::size_t>(slot)] = weight;
+            }
+        });
         
-        #pragma omp parallel for schedule(dynamic)
-        for (std::size_t i = 0; i < n; ++i) {
-            const auto& ai = agents_[i];
-            if (!ai.alive) continue;  // Skip dead agents
-            
-            std::array<double, 4> acc{0, 0, 0, 0};
-            
-            // Cache agent properties used in inner loop
-            const double ai_susceptibility = ai.m_susceptibility;
-            const double ai_comm = ai.m_comm;
-            
-            for (auto jid : ai.neighbors) {
-                if (jid >= agents_.size()) continue;  // Safety check
-                const auto& aj = agents_[jid];
-                if (!aj.alive) continue;  // Skip dead neighbors
-                
-                double s = similarityGate(ai, aj);
-                double lq = languageQuality(ai, aj);
-                double comm = 0.5 * (ai_comm + aj.m_comm);
-                double weight = stepSize * s * lq * comm * ai_susceptibility;
-                
-                // Unroll belief dimension loop for better performance
-                acc[0] += weight * fastTanh(aj.B[0] - ai.B[0]);
-                acc[1] += weight * fastTanh(aj.B[1] - ai.B[1]);
-                acc[2] += weight * fastTanh(aj.B[2] - ai.B[2]);
-                acc[3] += weight * fastTanh(aj.B[3] - ai.B[3]);
+        for (const auto& split : belief_sched_.splits()) {
+            for (std::uint32_t slot = split.slot_begin; slot < split.slot_end; ++slot) {
+                belief::add<kBeliefDims>(dx[split.id], partials[slot]);
+                rate[split.id] += partial_rates[slot];
             }
-            
-            dx[i] = acc;
         }
         
         // Apply updates
-        #pragma omp parallel for
+        prepareBeliefDeltas();
+        
+        #pragma omp parallel
+        {
+        const std::size_t tid = static_cast<std::size_t>(omp_get_thread_num());
+        auto& deltas = belief_deltas_[tid];
+        OnlineClustering* tracker = culture_tracker_.get();
+        
+        #pragma omp for
         for (std::size_t i = 0; i < n; ++i) {
-            if (!agents_[i].alive) continue;  // Skip dead agents
+            // Skip dead agents and agents not due this tick
+            if (!agents_[i].alive || (lod && !lod_.due(static_cast<std::uint32_t>(i)))) continue;
+            const BeliefState before = agents_[i].B;
             
-            agents_[i].x[0] += dx[i][0];
-            agents_[i].x[1] += dx[i][1];
-            agents_[i].x[2] += dx[i][2];
-            agents_[i].x[3] += dx[i][3];
+            // Level of detail: integrate every tick since the last update,
+            // relaxing at the linearized rate Σ w_ij (no innovation noise here)
+            double drift = 0.0, drift_scale = 1.0, noise_scale = 1.0;
+            if (lod) {
+                for (int b = 0; b < kBeliefDims; ++b) drift = std::max(drift, std::abs(static_cast<double>(dx[i][b])));
+                LevelOfDetail::stepScales(rate[i], lod_.beliefElapsed(static_cast<std::uint32_t>(i)),
+                                          drift_scale, noise_scale);
+            }
             
-            agents_[i].B[0] = fastTanh(agents_[i].x[0]);
-            agents_[i].B[1] = fastTanh(agents_[i].x[1]);
-            agents_[i].B[2] = fastTanh(agents_[i].x[2]);
-            agents_[i].B[3] = fastTanh(agents_[i].x[3]);
+            for (int b = 0; b < kBeliefDims; ++b) {
+                agents_[i].x[b] += dx[i][b] * drift_scale;
+                agents_[i].B[b] = fastTanh(agents_[i].x[b]);
+            }
 
             // Update cached norm
-            agents_[i].B_norm_sq = agents_[i].B[0] * agents_[i].B[0] +
-                                   agents_[i].B[1] * agents_[i].B[1] +
-                                   agents_[i].B[2] * agents_[i].B[2] +
-                                   agents_[i].B[3] * agents_[i].B[3];
+            agents_[i].B_norm_sq = belief::normSq<kBeliefDims>(agents_[i].B);
             
             // Validate beliefs (debug builds only)
-            validation::checkBeliefs(agents_[i].B.data(), 4, "updateBeliefs (pairwise)");
+            validation::checkBeliefs(agents_[i].B.data(), kBeliefDims, "updateBeliefs (pairwise)");
             validation::checkNonNegative(agents_[i].B_norm_sq, "B_norm_sq");
+            
+            deltas.record(agents_[i].region, before, agents_[i].B);
+            if (tracker) tracker->recordBeliefChange(tid, static_cast<std::uint32_t>(i), before, agents_[i].B);
+            if (lod) lod_.recordBeliefUpdate(static_cast<std::uint32_t>(i), drift, tid);
         }
+        }  // omp parallel
+        
+        mergeBeliefDeltas();
+        if (lod) lod_.wakeNeighbors(agents_);
     }
 }
 
 void Kernel::step() {
+    if (lod_.enabled()) {
+        lod_.trackInfection(health_.epidemicModel() == EpidemicModel::Network);
+        lod_.beginTick(agents_, generation_, static_cast<std::size_t>(std::max(1, omp_get_max_threads())));
+    }
     updateBeliefs();
     ++generation_;
     
@@ -560,26 +651,33 @@ void Kernel::step() {
         // Periodically rebuild to correct any drift (every 100 ticks)
         if (generation_ % 100 == 0) {
             rebuildRegionalAggregates();
+            if (culture_tracker_) culture_tracker_->resync(agents_);
         }
         
         // Build population counts and belief centroids from cached aggregates
         std::vector<std::uint32_t> region_populations(cfg_.regions);
-        std::vector<std::array<double, 4>> region_belief_centroids(cfg_.regions);
+        std::vector<BeliefVec> region_belief_centroids(cfg_.regions);
         
         for (std::uint32_t r = 0; r < cfg_.regions; ++r) {
             region_populations[r] = regional_aggregates_[r].population;
             if (regional_aggregates_[r].population > 0) {
                 const double inv_pop = 1.0 / regional_aggregates_[r].population;
-                region_belief_centroids[r][0] = regional_aggregates_[r].belief_sum[0] * inv_pop;
-                region_belief_centroids[r][1] = regional_aggregates_[r].belief_sum[1] * inv_pop;
-                region_belief_centroids[r][2] = regional_aggregates_[r].belief_sum[2] * inv_pop;
-                region_belief_centroids[r][3] = regional_aggregates_[r].belief_sum[3] * inv_pop;
+                region_belief_centroids[r] = regional_aggregates_[r].belief_sum;
+                belief::scale<kBeliefDims>(region_belief_centroids[r], inv_pop);
             } else {
-                region_belief_centroids[r] = {0.0, 0.0, 0.0, 0.0};
+                region_belief_centroids[r] = BeliefVec{};
             }
         }
         
-        economy_.update(region_populations, region_belief_centroids, agents_, generation_, &regionIndex_);
+        // Regional belief profiles straight from the maintained moments: O(R)
+        belief_profiles_.resize(cfg_.regions);
+        for (std::uint32_t r = 0; r < cfg_.regions; ++r) {
+            belief_profiles_[r] = regional_aggregates_[r].profile();
+        }
+        
+        economy_.update(region_populations, region_belief_centroids, agents_, generation_,
+                        &regionIndex_, &belief_profiles_);
+        if (lod_.enabled()) lod_.checkEconomy(economy_, regionIndex_);
         
         // Apply economic feedback to agent beliefs and susceptibility
         for (auto& agent : agents_) {
@@ -590,11 +688,12 @@ void Kernel::step() {
             
             const auto& regional_econ = economy_.getRegion(agent.region);
             const auto& agent_econ = economy_.getAgentEconomy(agent.id);
+            const BeliefState before = agent.B;
             
             // Hardship increases susceptibility to radical beliefs
             agent.m_susceptibility = 0.7 + 0.6 * (agent.openness - 0.5);
             agent.m_susceptibility *= (1.0 + regional_econ.hardship);
-            agent.m_susceptibility = std::clamp(agent.m_susceptibility, 0.4, 2.0);
+            agent.m_susceptibility = std::clamp<state_t>(agent.m_susceptibility, 0.4, 2.0);
             
             // EMERGENT BELIEF EVOLUTION: Economic experience MAY influence beliefs
             // but the direction depends on personality, not predetermined mappings
@@ -648,15 +747,85 @@ void Kernel::step() {
             // Systems emerge FROM beliefs; beliefs shift from lived experiences + social influence.
             
             // Keep beliefs in [-1, 1] range
-            for (int d = 0; d < 4; ++d) {
-                agent.B[d] = std::clamp(agent.B[d], -1.0, 1.0);
+            for (int d = 0; d < kBeliefDims; ++d) {
+                agent.B[d] = std::clamp<state_t>(agent.B[d], -1.0, 1.0);
             }
+            regional_aggregates_[agent.region].update(before, agent.B);
+            if (culture_tracker_) culture_tracker_->onBeliefChanged(agent.id, before, agent.B);
         }
     }
 
     // Update health and psychology every tick using latest economic signals
-    health_.updateAgents(agents_, economy_, generation_);
-    psychology_.updateAgents(agents_, economy_, generation_);
+    updateWellbeing();
+    
+    // Amortized culture reassignment: 1/sweepTicks of the population per tick
+    if (culture_tracker_) {
+        culture_tracker_->sweep(agents_);
+    }
+    
+    if (lod_.enabled()) lod_.finishTick();
+}
+
+void Kernel::updateWellbeing() {
+    // One fused sweep: health first (infection feeds the disease stressor),
+    // then psychology, while the agent is still in cache. Draws are counter-based
+    // and regional sums are per-thread, so the result is thread-count invariant.
+    const std::size_t threads = static_cast<std::size_t>(std::max(1, omp_get_max_threads()));
+    health_.beginTick(economy_, threads);
+    health_.stepEpidemic(agents_, generation_);  // Network mode only; serial, sparse
+    psychology_.beginTick(economy_, agents_, threads);
+
+    // Level of detail: agents not due keep their state (and still count in the
+    // regional sums) unless an infection or hardship change calls them in early
+    const bool lod = lod_.enabled();
+    if (lod) lod_.resize(agents_.size());  // Births earlier this tick
+
+    const auto& econAgents = economy_.agents();
+    const std::int64_t n = static_cast<std::int64_t>(agents_.size());
+    #pragma omp parallel
+    {
+        const std::size_t tid = static_cast<std::size_t>(omp_get_thread_num());
+        #pragma omp for schedule(static)
+        for (std::int64_t ii = 0; ii < n; ++ii) {
+            Agent& agent = agents_[static_cast<std::size_t>(ii)];
+            if (!agent.alive) continue;
+            const AgentEconomy& econ = econAgents[agent.id];
+            if (!lod) {
+                health_.updateAgent(agent, generation_, tid);
+                psychology_.updateAgent(agent, econ, tid);
+                continue;
+            }
+            if (!lod_.due(agent.id) && !lod_.stressorsChanged(agent, econ.hardship)) {
+                health_.accumulate(agent, tid);
+                psychology_.accumulate(agent, tid);
+                continue;
+            }
+            const double steps = lod_.wellbeingElapsed(agent.id);
+            const double stressBefore = agent.psych.stress_level;
+            health_.updateAgent(agent, generation_, tid, steps);
+            psychology_.updateAgent(agent, econ, tid, steps);
+            lod_.recordWellbeingUpdate(agent, econ.hardship, stressBefore, steps, tid);
+        }
+    }
+
+    health_.finishTick();
+    psychology_.finishTick();
+}
+
+void Kernel::setEpidemicModel(EpidemicModel model) {
+    cfg_.networkEpidemic = (model == EpidemicModel::Network);
+    health_.setEpidemicModel(model, agents_);
+}
+
+std::uint32_t Kernel::seedInfections(std::uint32_t count) {
+    if (agents_.empty()) return 0;
+    std::uniform_int_distribution<std::size_t> pick(0, agents_.size() - 1);
+    std::uint32_t seeded = 0;
+    // Bounded attempts: most agents are susceptible unless an outbreak is already large
+    for (std::uint32_t attempt = 0; attempt < count * 8 && seeded < count; ++attempt) {
+        if (health_.seedInfection(agents_[pick(rng_)], generation_)) ++seeded;
+    }
+    return seeded;
 }
 
 void Kernel::stepN(int n) {
@@ -669,25 +838,17 @@ Kernel::Metrics Kernel::computeMetrics() const {
     Metrics m;
     
     // Compute region centroids
-    std::vector<std::array<double, 4>> centroids(cfg_.regions);
+    std::vector<BeliefVec> centroids(cfg_.regions);
     std::vector<int> counts(cfg_.regions, 0);
     
     for (std::uint32_t r = 0; r < cfg_.regions; ++r) {
-        std::array<double, 4> c{0, 0, 0, 0};
+        BeliefVec c{};
         for (auto id : regionIndex_[r]) {
-            const auto& B = agents_[id].B;
-            c[0] += B[0];
-            c[1] += B[1];
-            c[2] += B[2];
-            c[3] += B[3];
+            belief::add<kBeliefDims>(c, agents_[id].B);
         }
         int n = static_cast<int>(regionIndex_[r].size());
         if (n > 0) {
-            const double inv_n = 1.0 / n;
-            c[0] *= inv_n;
-            c[1] *= inv_n;
-            c[2] *= inv_n;
-            c[3] *= inv_n;
+            belief::scale<kBeliefDims>(c, 1.0 / n);
         }
         centroids[r] = c;
         counts[r] = n;
@@ -700,12 +861,7 @@ Kernel::Metrics Kernel::computeMetrics() const {
         if (counts[i] == 0) continue;
         for (std::uint32_t j = i + 1; j < cfg_.regions; ++j) {
             if (counts[j] == 0) continue;
-            // Unroll 4D distance calculation
-            const double d0 = centroids[i][0] - centroids[j][0];
-            const double d1 = centroids[i][1] - centroids[j][1];
-            const double d2 = centroids[i][2] - centroids[j][2];
-            const double d3 = centroids[i][3] - centroids[j][3];
-            dists.push_back(std::sqrt(d0*d0 + d1*d1 + d2*d2 + d3*d3));
+            dists.push_back(std::sqrt(belief::distanceSq<kBeliefDims>(centroids[i], centroids[j])));
         }
     }
     
@@ -796,7 +952,7 @@ double Kernel::fertilityPerTick(int age) const {
 
 // Region and agent-specific fertility rate (modulated by culture, development, and wealth)
 double Kernel::fertilityPerTick(int age, std::uint32_t region_id, const Agent& agent,
-                                const std::array<double, 4>& region_beliefs) const {
+                                const BeliefVec& region_beliefs) const {
     double base_annual = fertilityRateAnnual(age);
     if (base_annual == 0.0) return 0.0;
     
@@ -848,19 +1004,17 @@ void Kernel::stepDemography() {
     bool ageIncrement = (generation_ % cfg_.ticksPerYear == 0);
     
     // Use cached regional aggregates for belief centroids
-    std::vector<std::array<double, 4>> region_belief_centroids(cfg_.regions);
+    std::vector<BeliefVec> region_belief_centroids(cfg_.regions);
     std::vector<std::uint32_t> region_populations(cfg_.regions);
     
     for (std::uint32_t r = 0; r < cfg_.regions; ++r) {
         region_populations[r] = regional_aggregates_[r].population;
         if (regional_aggregates_[r].population > 0) {
             const double inv_pop = 1.0 / regional_aggregates_[r].population;
-            region_belief_centroids[r][0] = regional_aggregates_[r].belief_sum[0] * inv_pop;
-            region_belief_centroids[r][1] = regional_aggregates_[r].belief_sum[1] * inv_pop;
-            region_belief_centroids[r][2] = regional_aggregates_[r].belief_sum[2] * inv_pop;
-            region_belief_centroids[r][3] = regional_aggregates_[r].belief_sum[3] * inv_pop;
+            region_belief_centroids[r] = regional_aggregates_[r].belief_sum;
+            belief::scale<kBeliefDims>(region_belief_centroids[r], inv_pop);
         } else {
-            region_belief_centroids[r] = {0.0, 0.0, 0.0, 0.0};
+            region_belief_centroids[r] = BeliefVec{};
         }
     }
     
@@ -1025,18 +1179,17 @@ void Kernel::createChild(std::uint32_t motherId) {
     
     // Beliefs: cultural transmission from parents with noise
     std::normal_distribution<double> beliefNoise(0.0, 0.2);
-    for (int k = 0; k < 4; ++k) {
+    for (int k = 0; k < kBeliefDims; ++k) {
         double baseB = mother.B[k];
         if (father) {
             baseB = 0.5 * (mother.B[k] + father->B[k]);
         }
         child.B[k] = std::clamp(baseB + beliefNoise(rng_), -1.0, 1.0);
         // Convert B to internal state x = atanh(B)
-        double B_clamped = std::clamp(child.B[k], -0.99, 0.99);
+        double B_clamped = std::clamp<double>(child.B[k], -0.99, 0.99);
         child.x[k] = std::atanh(B_clamped);
     }
-    child.B_norm_sq = child.B[0]*child.B[0] + child.B[1]*child.B[1] + 
-                      child.B[2]*child.B[2] + child.B[3]*child.B[3];
+    child.B_norm_sq = belief::normSq<kBeliefDims>(child.B);
     
     // Module multipliers
     child.m_comm = 1.0;
@@ -1044,6 +1197,7 @@ void Kernel::createChild(std::uint32_t motherId) {
     child.m_mobility = 0.8 + 0.4 * child.sociality;
     
     // Network: connect to mother and some of her neighbors
+    replicas_.markStale();
     child.neighbors.clear();
     child.neighbors.push_back(motherId);
     mother.neighbors.push_back(child.id);  // Reciprocal link
@@ -1094,16 +1248,18 @@ void Kernel::compactDeadAgents() {
     }
     
     // Remove dead agents from neighbor lists
+    bool pruned = false;
     for (auto& agent : agents_) {
         if (!agent.alive) continue;
-        agent.neighbors.erase(
-            std::remove_if(agent.neighbors.begin(), agent.neighbors.end(),
-                [this](std::uint32_t id) {
-                    return id >= agents_.size() || !agents_[id].alive;
-                }),
-            agent.neighbors.end()
-        );
+        auto kept = std::remove_if(agent.neighbors.begin(), agent.neighbors.end(),
+            [this](std::uint32_t id) {
+                return id >= agents_.size() || !agents_[id].alive;
+            });
+        if (kept == agent.neighbors.end()) continue;
+        agent.neighbors.erase(kept, agent.neighbors.end());
+        pruned = true;
     }
+    if (pruned) replicas_.markStale();
 }
 
 void Kernel::stepMigration() {
@@ -1241,12 +1397,9 @@ void Kernel::stepMigration() {
                         if (!neighbor.alive) continue;
                         
                         // Connection value: combination of belief similarity and social factors
-                        double belief_similarity = 0.0;
-                        for (int d = 0; d < 4; ++d) {
-                            double diff = agent.B[d] - neighbor.B[d];
-                            belief_similarity += diff * diff;
-                        }
-                        belief_similarity = 1.0 - std::sqrt(belief_similarity) / 4.0;  // normalize to [0,1]
+                        double belief_similarity = belief::distanceSq<kBeliefDims>(agent.B, neighbor.B);
+                        // Normalize to [0,1] by the diameter of the belief cube, 2·sqrt(D)
+                        belief_similarity = 1.0 - std::sqrt(belief_similarity) / (2.0 * std::sqrt(double(kBeliefDims)));
                         
                         // Language bonus: shared language strengthens ties
                         double lang_bonus = (agent.primaryLang == neighbor.primaryLang) ? 0.2 : 0.0;
@@ -1282,6 +1435,7 @@ void Kernel::stepMigration() {
                     if (keep_count < 1) keep_count = 1;
                     
                     // Rebuild neighbors list with top valued connections
+                    replicas_.markStale();
                     agent.neighbors.clear();
                     for (std::size_t i = 0; i < keep_count && i < scored_neighbors.size(); ++i) {
                         agent.neighbors.push_back(scored_neighbors[i].second);
@@ -1305,7 +1459,7 @@ Kernel::Statistics Kernel::getStatistics() const {
     std::uint64_t connectionSum = 0;
     
     // Belief accumulators
-    std::array<double, 4> beliefSum = {0, 0, 0, 0};
+    BeliefVec beliefSum{};
     std::vector<double> polarizations;
     polarizations.reserve(agents_.size());
     
@@ -1339,9 +1493,7 @@ Kernel::Statistics Kernel::getStatistics() const {
         if (agent.neighbors.empty()) stats.isolatedAgents++;
         
         // Beliefs
-        for (int i = 0; i < 4; ++i) {
-            beliefSum[i] += agent.B[i];
-        }
+        belief::add<kBeliefDims>(beliefSum, agent.B);
         double polarization = std::sqrt(agent.B_norm_sq);
         polarizations.push_back(polarization);
         
@@ -1357,7 +1509,7 @@ Kernel::Statistics Kernel::getStatistics() const {
         stats.avgAge = static_cast<double>(ageSum) / stats.aliveAgents;
         stats.avgConnections = static_cast<double>(connectionSum) / stats.aliveAgents;
         
-        for (int i = 0; i < 4; ++i) {
+        for (int i = 0; i < kBeliefDims; ++i) {
             stats.avgBeliefs[i] = beliefSum[i] / stats.aliveAgents;
         }
         
@@ -1429,9 +1581,7 @@ Kernel::Statistics Kernel::getStatistics() const {
 void Kernel::rebuildRegionalAggregates() {
     // Full O(N) rebuild - used at init and periodically to correct drift
     for (auto& agg : regional_aggregates_) {
-        agg.population = 0;
-        agg.belief_sum = {0.0, 0.0, 0.0, 0.0};
-        agg.dirty = false;
+        agg = RegionalAggregates{};
     }
     
     for (const auto& agent : agents_) {
@@ -1442,12 +1592,7 @@ void Kernel::rebuildRegionalAggregates() {
             continue;  // Skip invalid (will be caught by validation)
         }
         
-        auto& agg = regional_aggregates_[agent.region];
-        agg.population++;
-        agg.belief_sum[0] += agent.B[0];
-        agg.belief_sum[1] += agent.B[1];
-        agg.belief_sum[2] += agent.B[2];
-        agg.belief_sum[3] += agent.B[3];
+        regional_aggregates_[agent.region].add(agent.B);
     }
 }
 
@@ -1456,12 +1601,8 @@ void Kernel::onAgentBorn(std::uint32_t agent_id) {
     const auto& agent = agents_[agent_id];
     if (!agent.alive || agent.region >= cfg_.regions) return;
     
-    auto& agg = regional_aggregates_[agent.region];
-    agg.population++;
-    agg.belief_sum[0] += agent.B[0];
-    agg.belief_sum[1] += agent.B[1];
-    agg.belief_sum[2] += agent.B[2];
-    agg.belief_sum[3] += agent.B[3];
+    regional_aggregates_[agent.region].add(agent.B);
+    if (culture_tracker_) culture_tracker_->onAgentAdded(agent);
 }
 
 void Kernel::onAgentDied(std::uint32_t agent_id) {
@@ -1472,12 +1613,9 @@ void Kernel::onAgentDied(std::uint32_t agent_id) {
     
     auto& agg = regional_aggregates_[agent.region];
     if (agg.population > 0) {
-        agg.population--;
-        agg.belief_sum[0] -= agent.B[0];
-        agg.belief_sum[1] -= agent.B[1];
-        agg.belief_sum[2] -= agent.B[2];
-        agg.belief_sum[3] -= agent.B[3];
+        agg.remove(agent.B);
     }
+    if (culture_tracker_) culture_tracker_->onAgentRemoved(agent);
 }
 
 void Kernel::onAgentMigrated(std::uint32_t agent_id, std::uint32_t from_region, std::uint32_t to_region) {
@@ -1489,26 +1627,48 @@ void Kernel::onAgentMigrated(std::uint32_t agent_id, std::uint32_t from_region,
     // Remove from old region
     auto& from_agg = regional_aggregates_[from_region];
     if (from_agg.population > 0) {
-        from_agg.population--;
-        from_agg.belief_sum[0] -= agent.B[0];
-        from_agg.belief_sum[1] -= agent.B[1];
-        from_agg.belief_sum[2] -= agent.B[2];
-        from_agg.belief_sum[3] -= agent.B[3];
+        from_agg.remove(agent.B);
     }
     
     // Add to new region
-    auto& to_agg = regional_aggregates_[to_region];
-    to_agg.population++;
-    to_agg.belief_sum[0] += agent.B[0];
-    to_agg.belief_sum[1] += agent.B[1];
-    to_agg.belief_sum[2] += agent.B[2];
-    to_agg.belief_sum[3] += agent.B[3];
+    regional_aggregates_[to_region].add(agent.B);
+    
+    // New surroundings: back to full update rate
+    lod_.promote(agent_id);
 }
 
 void Kernel::updateRegionalAggregates() {
-    // Update belief sums based on current agent beliefs
-    // This is called when beliefs change but population doesn't
-    // For now, we use periodic full rebuild instead (cheaper than tracking all belief changes)
+    // Belief changes are tracked as per-thread deltas (see mergeBeliefDeltas);
+    // this folds any pending deltas into the aggregates immediately
+    mergeBeliefDeltas();
+}
+
+void Kernel::prepareBeliefDeltas() {
+    const std::size_t threads = static_cast<std::size_t>(std::max(1, omp_get_max_threads()));
+    if (belief_deltas_.size() < threads) {
+        belief_deltas_.resize(threads);
+    }
+    for (auto& buffer : belief_deltas_) {
+        if (buffer.delta.size() != cfg_.regions) {
+            buffer.delta.assign(cfg_.regions, RegionalBeliefMoments{});
+            buffer.marked.assign(cfg_.regions, 0);
+            buffer.touched.clear();
+        }
+    }
+    if (culture_tracker_) culture_tracker_->prepareDeltas(threads);
+}
+
+void Kernel::mergeBeliefDeltas() {
+    // O(touched regions per thread); order-independent since every field is a sum
+    for (auto& buffer : belief_deltas_) {
+        for (std::uint32_t r : buffer.touched) {
+            regional_aggregates_[r].merge(buffer.delta[r]);
+            buffer.delta[r] = RegionalBeliefMoments{};
+            buffer.marked[r] = 0;
+        }
+        buffer.touched.clear();
+    }
+    if (culture_tracker_) culture_tracker_->mergeDeltas();
 }
 
 // ============================================================================
@@ -1589,14 +1749,7 @@ void Kernel::formLocalConnections(std::size_t agent_idx, int max_new_connections
         
         // Score by compatibility
         // 1. Belief similarity (40% weight)
-        double dot = 0.0, norm_a = 0.0, norm_c = 0.0;
-        for (int b = 0; b < 4; ++b) {
-            dot += agent.B[b] * candidate.B[b];
-            norm_a += agent.B[b] * agent.B[b];
-            norm_c += candidate.B[b] * candidate.B[b];
-        }
-        double belief_sim = (norm_a > 1e-9 && norm_c > 1e-9) ?
-            dot / (std::sqrt(norm_a) * std::sqrt(norm_c)) : 0.0;
+        double belief_sim = belief::cosine<kBeliefDims>(agent.B, candidate.B);
         
         // 2. Language bonus (30% weight)
         double language_bonus = (agent.primaryLang == candidate.primaryLang) ? 0.3 : 0.0;
@@ -1633,6 +1786,7 @@ void Kernel::formLocalConnections(std::size_t agent_idx, int max_new_connections
         
         if (prob_dist(rng_) < connect_prob) {
             // Add bidirectional connection
+            replicas_.markStale();
             agent.neighbors.push_back(c_idx);
             agents_[c_idx].neighbors.push_back(static_cast<std::uint32_t>(agent_idx));
             formed++;
@@ -2,371 +2,1250 @@
 #include "kernel/Kernel.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <limits>
 #include <numeric>
 #include <random>
-#include <unordered_map>
+#include <omp.h>
 
 namespace {
 
-double distance4d(const std::array<double, 4>& a, const std::array<double, 4>& b) {
-    double sum = 0.0;
-    for (int i = 0; i < 4; ++i) {
-        double d = a[i] - b[i];
-        sum += d * d;
-    }
-    return std::sqrt(sum);
+double beliefDistance(const BeliefVec& a, const BeliefVec& b) {
+    return std::sqrt(belief::distanceSq<kBeliefDims>(a, b));
+}
+
 }
 
+// -------------- Snapshot ----------------
+ClusteringSnapshot ClusteringSnapshot::capture(const Kernel& kernel) {
+    const auto& agents = kernel.agents();
+    ClusteringSnapshot snapshot;
+    snapshot.generation = kernel.generation();
+    snapshot.agentSlots = agents.size();
+    snapshot.regionCount = static_cast<std::uint32_t>(kernel.regionIndex().size());
+
+    std::size_t alive = 0;
+    for (const auto& agent : agents) {
+        if (agent.alive) ++alive;
+    }
+    snapshot.beliefs.reserve(alive);
+    snapshot.region.reserve(alive);
+    snapshot.lang.reserve(alive);
+    snapshot.dialect.reserve(alive);
+    snapshot.agentId.reserve(alive);
+    snapshot.rowOf.assign(agents.size(), -1);
+    for (std::size_t i = 0; i < agents.size(); ++i) {
+        const Agent& agent = agents[i];
+        if (!agent.alive) continue;
+        snapshot.rowOf[i] = static_cast<std::int32_t>(snapshot.beliefs.size());
+        snapshot.beliefs.push_back(belief::toVec(agent.B));
+        snapshot.region.push_back(agent.region);
+        snapshot.lang.push_back(agent.primaryLang);
+        snapshot.dialect.push_back(agent.dialect);
+        snapshot.agentId.push_back(agent.id);
+        snapshot.regionCount = std::max(snapshot.regionCount, agent.region + 1);
+    }
+    return snapshot;
 }
 
 // ---------------- KMeans -----------------
-KMeansClustering::KMeansClustering(int k, int maxIter, double tolerance)
-    : k_(std::max(2, k)), maxIter_(std::max(1, maxIter)), tolerance_(std::max(1e-6, tolerance)) {}
-
-void KMeansClustering::initialize(const std::vector<Agent>& agents,
-                                  std::vector<std::array<double, 4>>& centroids) {
-    centroids.clear();
-    centroids.reserve(k_);
-
-    std::mt19937_64 rng(agents.size());
-    std::uniform_int_distribution<std::size_t> pick(0, agents.size() - 1);
-
-    centroids.push_back(agents[pick(rng)].B);
-
-    while (static_cast<int>(centroids.size()) < k_) {
-        std::vector<double> minDists(agents.size(), std::numeric_limits<double>::max());
-        for (std::size_t i = 0; i < agents.size(); ++i) {
-            for (const auto& c : centroids) {
-                // Use squared distance to avoid sqrt
-                double d2 = 0.0;
-                for (int dim = 0; dim < 4; ++dim) {
-                    double diff = agents[i].B[dim] - c[dim];
-                    d2 += diff * diff;
-                }
-                if (d2 < minDists[i]) minDists[i] = d2;
-            }
+namespace {
+
+// Elkan keeps k lower bounds per point. Its O(k) bound scan per point only
+// beats Hamerly's single test once distances are expensive (high-dimensional
+// points) and k is large; in 4-D Hamerly was 2-3x faster up to k = 512.
+constexpr int kPointDims = kBeliefDims;
+constexpr int kElkanMinDims = 16;
+constexpr int kElkanMinK = 32;
+constexpr std::size_t kElkanBoundBudget = std::size_t{1} << 24;  // doubles (128 MB)
+
+double squaredBeliefDistance(const BeliefVec& a, const BeliefVec& b) {
+    return belief::distanceSq<kBeliefDims>(a, b);
+}
+
+int nearestCentroid(const BeliefVec& x,
+                    const std::vector<BeliefVec>& centroids,
+                    double& bestSq) {
+    int best = 0;
+    bestSq = std::numeric_limits<double>::max();
+    for (std::size_t c = 0; c < centroids.size(); ++c) {
+        double d2 = squaredBeliefDistance(x, centroids[c]);
+        if (d2 < bestSq) {
+            bestSq = d2;
+            best = static_cast<int>(c);
         }
-        std::discrete_distribution<std::size_t> dist(minDists.begin(), minDists.end());
-        centroids.push_back(agents[dist(rng)].B);
     }
+    return best;
 }
 
-void KMeansClustering::assign(const std::vector<Agent>& agents,
-                              const std::vector<std::array<double, 4>>& centroids,
-                              std::vector<int>& assignment) {
-    assignment.resize(agents.size());
-    for (std::size_t i = 0; i < agents.size(); ++i) {
-        double bestSq = std::numeric_limits<double>::max();
-        int bestCluster = 0;
-        // Compare squared distances to avoid sqrt
-        for (int k = 0; k < k_; ++k) {
-            double d2 = 0.0;
-            for (int dim = 0; dim < 4; ++dim) {
-                double diff = agents[i].B[dim] - centroids[k][dim];
-                d2 += diff * diff;
+// k-means++ seeding over `points`, extending `centroids` to k seeds (entries
+// already present, e.g. warm-start centroids, are kept and count as seeds).
+// minDist is updated against each new seed only (O(N·k) instead of O(N·k²)),
+// and each seed is drawn by walking the D² prefix sum rather than building a
+// distribution object over all N per seed.
+void seedKMeansPlusPlus(const std::vector<BeliefVec>& points, std::size_t k,
+                        std::mt19937_64& rng, std::vector<BeliefVec>& centroids) {
+    const std::size_t n = points.size();
+    if (centroids.size() > k) centroids.resize(k);
+    centroids.reserve(k);
+
+    std::uniform_int_distribution<std::size_t> pick(0, n - 1);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    if (centroids.empty()) centroids.push_back(points[pick(rng)]);
+
+    std::vector<double> minDists(n, std::numeric_limits<double>::max());
+    const std::int64_t count = static_cast<std::int64_t>(n);
+    std::size_t folded = 0;  // seeds already folded into minDists
+    while (centroids.size() < k) {
+        double total = 0.0;
+        for (; folded < centroids.size(); ++folded) {
+            const BeliefVec seed = centroids[folded];
+            total = 0.0;
+            #pragma omp parallel for schedule(static) reduction(+:total)
+            for (std::int64_t ii = 0; ii < count; ++ii) {
+                const std::size_t i = static_cast<std::size_t>(ii);
+                minDists[i] = std::min(minDists[i], squaredBeliefDistance(points[i], seed));
+                total += minDists[i];
             }
-            if (d2 < bestSq) {
-                bestSq = d2;
-                bestCluster = k;
+        }
+        if (total <= 0.0) {
+            centroids.push_back(points[pick(rng)]);  // All points coincide with a seed
+            continue;
+        }
+        const double target = unit(rng) * total;
+        double running = 0.0;
+        std::size_t chosen = n - 1;
+        for (std::size_t i = 0; i < n; ++i) {
+            running += minDists[i];
+            if (running > target) {
+                chosen = i;
+                break;
             }
         }
-        assignment[i] = bestCluster;
+        centroids.push_back(points[chosen]);
     }
 }
 
-void KMeansClustering::update(const std::vector<Agent>& agents,
-                              const std::vector<int>& assignment,
-                              std::vector<std::array<double, 4>>& centroids) {
-    std::vector<std::array<double, 4>> newC(k_, {0, 0, 0, 0});
-    std::vector<int> counts(k_, 0);
+}
+
+KMeansClustering::KMeansClustering(int k, int maxIter, double tolerance, KMeansBounds bounds)
+    : k_(std::max(2, k)), maxIter_(std::max(1, maxIter)), tolerance_(std::max(1e-6, tolerance)),
+      bounds_(bounds) {}
 
-    for (std::size_t i = 0; i < agents.size(); ++i) {
-        int cluster = assignment[i];
-        for (int d = 0; d < 4; ++d) {
-            newC[cluster][d] += agents[i].B[d];
+
+void KMeansClustering::warmStart(const std::vector<Cluster>& previous) {
+    warmCentroids_.clear();
+    warmCentroids_.reserve(previous.size());
+    for (const auto& cluster : previous) {
+        if (!cluster.members.empty()) warmCentroids_.push_back(cluster.centroid);
+    }
+}
+
+void KMeansClustering::initialize(std::size_t k, std::uint64_t seed) {
+    // Warm start: previous centroids seed directly (surplus dropped, missing
+    // ones drawn by k-means++ against them); empty ones are re-seeded as usual
+    std::mt19937_64 rng(seed);
+    centroids_.assign(warmCentroids_.begin(),
+                      warmCentroids_.begin() + std::min(k, warmCentroids_.size()));
+    warmStarted_ = !centroids_.empty();
+    seedKMeansPlusPlus(points_, k, rng, centroids_);
+}
+
+void KMeansClustering::computeCenterDistances() {
+    const int k = static_cast<int>(centroids_.size());
+    centerDist_.assign(static_cast<std::size_t>(k) * k, 0.0);
+    halfMinDist_.assign(k, std::numeric_limits<double>::max());
+    for (int a = 0; a < k; ++a) {
+        for (int b = a + 1; b < k; ++b) {
+            double d = beliefDistance(centroids_[a], centroids_[b]);
+            centerDist_[a * k + b] = d;
+            centerDist_[b * k + a] = d;
+            halfMinDist_[a] = std::min(halfMinDist_[a], 0.5 * d);
+            halfMinDist_[b] = std::min(halfMinDist_[b], 0.5 * d);
         }
-        counts[cluster]++;
     }
+}
 
-    std::mt19937_64 rng(agents.size() * 7919);
-    std::uniform_int_distribution<std::size_t> pick(0, agents.size() - 1);
+std::size_t KMeansClustering::assignPass(bool fullScan, bool exactInertia) {
+    const std::size_t k = centroids_.size();
+    const std::int64_t n = static_cast<std::int64_t>(points_.size());
+    const int threads = std::max(1, omp_get_max_threads());
+    partialSums_.assign(static_cast<std::size_t>(threads) * k, Point{});
+    partialCounts_.assign(static_cast<std::size_t>(threads) * k, 0);
 
-    for (int k = 0; k < k_; ++k) {
-        if (counts[k] == 0) {
-            newC[k] = agents[pick(rng)].B;
-        } else {
-            for (int d = 0; d < 4; ++d) {
-                newC[k][d] /= counts[k];
+    std::size_t changed = 0;
+    std::uint64_t evaluations = 0;
+    double inertia = 0.0;
+
+    #pragma omp parallel reduction(+:changed, evaluations, inertia)
+    {
+        const std::size_t t = static_cast<std::size_t>(omp_get_thread_num());
+        Point* sums = &partialSums_[t * k];
+        std::uint32_t* counts = &partialCounts_[t * k];
+
+        #pragma omp for schedule(static)
+        for (std::int64_t ii = 0; ii < n; ++ii) {
+            const std::size_t i = static_cast<std::size_t>(ii);
+            const Point& x = points_[i];
+            const int previous = assignment_[i];
+            int a = previous;
+            double u = upper_[i];
+            bool tight = false;  // u is the exact distance to centroid a
+
+            if (fullScan) {
+                // Initial pass: every distance, seeds every bound
+                double best = std::numeric_limits<double>::max();
+                double second = std::numeric_limits<double>::max();
+                for (std::size_t c = 0; c < k; ++c) {
+                    double d = beliefDistance(x, centroids_[c]);
+                    if (elkan_) lower_[i * k + c] = d;
+                    if (d < best) {
+                        second = best;
+                        best = d;
+                        a = static_cast<int>(c);
+                    } else if (d < second) {
+                        second = d;
+                    }
+                }
+                evaluations += k;
+                u = best;
+                tight = true;
+                if (!elkan_) lower_[i] = second;
+            } else if (elkan_) {
+                double* l = &lower_[i * k];
+                if (u > halfMinDist_[a]) {
+                    for (std::size_t c = 0; c < k; ++c) {
+                        if (static_cast<int>(c) == a) continue;
+                        double z = std::max(l[c], 0.5 * centerDist_[a * k + c]);
+                        if (u <= z) continue;
+                        if (!tight) {
+                            u = beliefDistance(x, centroids_[a]);
+                            l[a] = u;
+                            tight = true;
+                            ++evaluations;
+                            if (u <= z) continue;
+                        }
+                        double d = beliefDistance(x, centroids_[c]);
+                        l[c] = d;
+                        ++evaluations;
+                        if (d < u) {
+                            a = static_cast<int>(c);
+                            u = d;
+                        }
+                    }
+                }
+            } else {
+                // Hamerly: one test against max(½ nearest-centroid gap, second-closest bound)
+                double m = std::max(halfMinDist_[a], lower_[i]);
+                if (u > m) {
+                    u = beliefDistance(x, centroids_[a]);
+                    tight = true;
+                    ++evaluations;
+                    if (u > m) {
+                        double best = std::numeric_limits<double>::max();
+                        double second = std::numeric_limits<double>::max();
+                        for (std::size_t c = 0; c < k; ++c) {
+                            double d = beliefDistance(x, centroids_[c]);
+                            if (d < best) {
+                                second = best;
+                                best = d;
+                                a = static_cast<int>(c);
+                            } else if (d < second) {
+                                second = d;
+                            }
+                        }
+                        evaluations += k;
+                        u = best;
+                        lower_[i] = second;
+                    }
+                }
+            }
+
+            if (exactInertia && !tight) {
+                u = beliefDistance(x, centroids_[a]);
+                ++evaluations;
             }
+            if (exactInertia) inertia += u * u;
+
+            if (a != previous) ++changed;
+            assignment_[i] = a;
+            upper_[i] = u;
+            for (int d = 0; d < kBeliefDims; ++d) {
+                sums[a][d] += x[d];
+            }
+            counts[a]++;
         }
     }
 
-    centroids = std::move(newC);
+    distanceEvaluations_ += evaluations;
+    if (exactInertia) inertia_ = inertia;
+    return changed;
 }
 
-double KMeansClustering::inertia(const std::vector<Agent>& agents,
-                                 const std::vector<std::array<double, 4>>& centroids,
-                                 const std::vector<int>& assignment) const {
-    double total = 0.0;
-    for (std::size_t i = 0; i < agents.size(); ++i) {
-        double d = distance4d(agents[i].B, centroids[assignment[i]]);
-        total += d * d;
+void KMeansClustering::updateCentroids(std::mt19937_64& reseedRng) {
+    const std::size_t k = centroids_.size();
+    const std::size_t threads = partialCounts_.size() / k;
+    std::uniform_int_distribution<std::size_t> pick(0, points_.size() - 1);
+    drift_.assign(k, 0.0);
+
+    for (std::size_t c = 0; c < k; ++c) {
+        Point sum{};
+        std::uint64_t count = 0;
+        for (std::size_t t = 0; t < threads; ++t) {
+            for (int d = 0; d < kBeliefDims; ++d) {
+                sum[d] += partialSums_[t * k + c][d];
+            }
+            count += partialCounts_[t * k + c];
+        }
+
+        Point next;
+        if (count == 0) {
+            next = points_[pick(reseedRng)];  // Reseed empty cluster
+        } else {
+            for (int d = 0; d < kBeliefDims; ++d) {
+                next[d] = sum[d] / static_cast<double>(count);
+            }
+        }
+        drift_[c] = beliefDistance(centroids_[c], next);
+        centroids_[c] = next;
+    }
+}
+
+void KMeansClustering::updateBounds() {
+    // Centroid c moved drift_[c]: upper bounds grow, lower bounds shrink by it
+    const std::size_t k = centroids_.size();
+    const std::int64_t n = static_cast<std::int64_t>(points_.size());
+
+    if (elkan_) {
+        #pragma omp parallel for schedule(static)
+        for (std::int64_t ii = 0; ii < n; ++ii) {
+            const std::size_t i = static_cast<std::size_t>(ii);
+            upper_[i] += drift_[assignment_[i]];
+            double* l = &lower_[i * k];
+            for (std::size_t c = 0; c < k; ++c) {
+                l[c] = std::max(0.0, l[c] - drift_[c]);
+            }
+        }
+        return;
+    }
+
+    // Hamerly: the second-closest centroid may be any but the assigned one
+    std::size_t maxIdx = 0;
+    double maxDrift = 0.0, secondDrift = 0.0;
+    for (std::size_t c = 0; c < k; ++c) {
+        if (drift_[c] > maxDrift) {
+            secondDrift = maxDrift;
+            maxDrift = drift_[c];
+            maxIdx = c;
+        } else if (drift_[c] > secondDrift) {
+            secondDrift = drift_[c];
+        }
+    }
+    #pragma omp parallel for schedule(static)
+    for (std::int64_t ii = 0; ii < n; ++ii) {
+        const std::size_t i = static_cast<std::size_t>(ii);
+        const std::size_t a = static_cast<std::size_t>(assignment_[i]);
+        upper_[i] += drift_[a];
+        lower_[i] -= (a == maxIdx) ? secondDrift : maxDrift;
     }
-    return total;
 }
 
 std::vector<Cluster> KMeansClustering::run(const Kernel& kernel) {
-    const auto& agents = kernel.agents();
-    std::vector<std::array<double, 4>> centroids;
-    std::vector<int> assignment;
+    return run(ClusteringSnapshot::capture(kernel));
+}
 
-    initialize(agents, centroids);
+std::vector<Cluster> KMeansClustering::run(const ClusteringSnapshot& snapshot) {
+    points_ = snapshot.beliefs;
 
-    double prevInertia = std::numeric_limits<double>::max();
+    iterationsUsed_ = 0;
     converged_ = false;
+    inertia_ = 0.0;
+    distanceEvaluations_ = 0;
+
+    const std::size_t n = points_.size();
+    if (n == 0) {
+        return {};
+    }
+    const std::size_t k = std::min<std::size_t>(static_cast<std::size_t>(k_), n);
+    const bool elkanFits = n * k <= kElkanBoundBudget;
+    switch (bounds_) {
+        case KMeansBounds::Elkan:
+            elkan_ = elkanFits;
+            break;
+        case KMeansBounds::Hamerly:
+            elkan_ = false;
+            break;
+        case KMeansBounds::Auto:
+            elkan_ = elkanFits && kPointDims >= kElkanMinDims && static_cast<int>(k) >= kElkanMinK;
+            break;
+    }
+
+    initialize(k, snapshot.agentSlots);
+
+    assignment_.assign(n, 0);
+    upper_.assign(n, 0.0);
+    lower_.assign(elkan_ ? n * k : n, 0.0);
+
+    std::mt19937_64 reseedRng(snapshot.agentSlots * 7919);
 
     for (iterationsUsed_ = 0; iterationsUsed_ < maxIter_; ++iterationsUsed_) {
-        assign(agents, centroids, assignment);
-        update(agents, assignment, centroids);
-        double current = inertia(agents, centroids, assignment);
-        if (std::abs(prevInertia - current) < tolerance_) {
+        const bool first = (iterationsUsed_ == 0);
+        if (!first) computeCenterDistances();
+        std::size_t changed = assignPass(first, false);
+        if (!first && changed == 0) {
+            converged_ = true;  // Centroids are already the means of their members
+            break;
+        }
+        updateCentroids(reseedRng);
+        updateBounds();
+        if (*std::max_element(drift_.begin(), drift_.end()) < tolerance_) {
             converged_ = true;
             break;
         }
-        prevInertia = current;
     }
 
-    std::vector<Cluster> clusters(k_);
-    for (int k = 0; k < k_; ++k) {
-        clusters[k].id = static_cast<std::uint32_t>(k);
-        clusters[k].centroid = centroids[k];
-        clusters[k].birthTick = kernel.generation();
+    // Final assignment against the final centroids, with exact inertia
+    computeCenterDistances();
+    assignPass(false, true);
+
+    std::vector<Cluster> clusters(k);
+    for (std::size_t c = 0; c < k; ++c) {
+        clusters[c].id = static_cast<std::uint32_t>(c);
+        clusters[c].centroid = centroids_[c];
+        clusters[c].birthTick = snapshot.generation;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        clusters[assignment_[i]].members.push_back(snapshot.agentId[i]);
     }
 
-    for (std::size_t i = 0; i < agents.size(); ++i) {
-        clusters[assignment[i]].members.push_back(agents[i].id);
+    enrichClusters(clusters, snapshot);
+    return clusters;
+}
+
+// ------------ Mini-batch KMeans -----------
+MiniBatchKMeansClustering::MiniBatchKMeansClustering(int k, int batchSize, int maxIter, double tolerance)
+    : k_(std::max(2, k)), batchSize_(std::max(1, batchSize)), maxIter_(std::max(1, maxIter)),
+      tolerance_(std::max(1e-6, tolerance)) {}
+
+std::vector<Cluster> MiniBatchKMeansClustering::run(const Kernel& kernel) {
+    return run(ClusteringSnapshot::capture(kernel));
+}
+
+std::vector<Cluster> MiniBatchKMeansClustering::run(const ClusteringSnapshot& snapshot) {
+    iterationsUsed_ = 0;
+    converged_ = false;
+    inertia_ = 0.0;
+
+    // Reservoir-sample seeding candidates in one sweep over the snapshot
+    const auto& points = snapshot.beliefs;
+    std::mt19937_64 rng(snapshot.agentSlots);
+    const std::size_t reservoirSize = std::max<std::size_t>(static_cast<std::size_t>(batchSize_),
+                                                            static_cast<std::size_t>(k_) * 20);
+    std::vector<Point> reservoir;
+    reservoir.reserve(reservoirSize);
+    for (std::size_t seen = 0; seen < points.size(); ++seen) {
+        if (seen < reservoirSize) {
+            reservoir.push_back(points[seen]);
+        } else {
+            std::uniform_int_distribution<std::size_t> slot(0, seen);
+            std::size_t j = slot(rng);
+            if (j < reservoirSize) reservoir[j] = points[seen];
+        }
+    }
+
+    const std::size_t n = points.size();
+    if (n == 0) {
+        return {};
+    }
+    const std::size_t k = std::min<std::size_t>(static_cast<std::size_t>(k_), reservoir.size());
+    centroids_.clear();
+    seedKMeansPlusPlus(reservoir, k, rng, centroids_);
+    centroidCounts_.assign(k, 0);
+
+    const std::size_t b = static_cast<std::size_t>(batchSize_);
+    batch_.resize(b);
+    batchAssignment_.resize(b);
+    std::uniform_int_distribution<std::uint32_t> pick(0, static_cast<std::uint32_t>(n - 1));
+    const std::int64_t batchCount = static_cast<std::int64_t>(b);
+    heldOut_.resize(std::max(b, kHeldOut));
+    for (auto& p : heldOut_) p = pick(rng);
+    const std::int64_t heldOutCount = static_cast<std::int64_t>(heldOut_.size());
+    double lastHeldOut = std::numeric_limits<double>::max();
+    int nextCheck = kFirstCheck;
+
+    for (iterationsUsed_ = 0; iterationsUsed_ < maxIter_; ++iterationsUsed_) {
+        for (auto& p : batch_) p = pick(rng);
+
+        // Assign the batch against the centroids as they stood at batch start
+        #pragma omp parallel for schedule(static)
+        for (std::int64_t ii = 0; ii < batchCount; ++ii) {
+            const std::size_t i = static_cast<std::size_t>(ii);
+            double d2;
+            batchAssignment_[i] = nearestCentroid(points[batch_[i]], centroids_, d2);
+        }
+
+        // Streaming update: per-centroid learning rate 1/count
+        for (std::size_t i = 0; i < b; ++i) {
+            const int c = batchAssignment_[i];
+            const double eta = 1.0 / static_cast<double>(++centroidCounts_[c]);
+            const Point& x = points[batch_[i]];
+            for (int d = 0; d < kBeliefDims; ++d) {
+                centroids_[c][d] += eta * (x[d] - centroids_[c][d]);
+            }
+        }
+
+        // Held-out inertia at doubling checkpoints: each span holds as much
+        // centroid movement as everything before it, however small steps get
+        if (iterationsUsed_ + 1 < nextCheck) continue;
+        nextCheck *= 2;
+        double heldOut = 0.0;
+        #pragma omp parallel for schedule(static) reduction(+:heldOut)
+        for (std::int64_t ii = 0; ii < heldOutCount; ++ii) {
+            double d2;
+            nearestCentroid(points[heldOut_[static_cast<std::size_t>(ii)]], centroids_, d2);
+            heldOut += d2;
+        }
+        if (heldOut > lastHeldOut * (1.0 - tolerance_)) {
+            converged_ = true;
+            ++iterationsUsed_;
+            break;
+        }
+        lastHeldOut = heldOut;
     }
 
-    enrichClusters(clusters, kernel);
+    // Single full assignment pass: members and exact inertia
+    std::vector<int> assignment(n);
+    const std::int64_t count = static_cast<std::int64_t>(n);
+    double inertia = 0.0;
+    #pragma omp parallel for schedule(static) reduction(+:inertia)
+    for (std::int64_t ii = 0; ii < count; ++ii) {
+        const std::size_t i = static_cast<std::size_t>(ii);
+        double d2;
+        assignment[i] = nearestCentroid(points[i], centroids_, d2);
+        inertia += d2;
+    }
+    inertia_ = inertia;
+
+    std::vector<Cluster> clusters(k);
+    for (std::size_t c = 0; c < k; ++c) {
+        clusters[c].id = static_cast<std::uint32_t>(c);
+        clusters[c].centroid = centroids_[c];
+        clusters[c].birthTick = snapshot.generation;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        clusters[assignment[i]].members.push_back(snapshot.agentId[i]);
+    }
+
+    enrichClusters(clusters, snapshot);
     return clusters;
 }
 
 // --------------- DBSCAN -----------------
+namespace {
+
+// Sparse uniform grid over the first 4 belief axes for eps-neighborhood
+// queries. Cell side is eps/2, so all eps-neighbors of a point lie within ±2
+// cells per axis (a 5^4 stencil); with 4 belief axes a cell's diagonal is
+// exactly eps, so every pair of points sharing a cell are neighbors. Wider
+// belief spaces are indexed by their projection (still a valid prune) and
+// check same-cell pairs explicitly. Points are sorted by linearized cell key;
+// each occupied cell's occupied stencil cells are resolved once at build
+// time, so queries never search.
+class BeliefGrid {
+public:
+    static constexpr int kGridDims = 4;                  // indexed (leading) belief axes
+    static constexpr bool kCellIsClique = kGridDims == kBeliefDims;
+    static constexpr int kReach = 2;                     // stencil radius in cells
+    static constexpr int kSpan = 2 * kReach + 1;         // 5
+    static constexpr int kStencil = kSpan * kSpan * kSpan * kSpan;  // 625
+
+    void build(const std::vector<BeliefVec>& points, double eps) {
+        points_ = &points;
+        cellSize_ = 0.5 * eps;
+        const std::size_t n = points.size();
+
+        for (int d = 0; d < kGridDims; ++d) {
+            double lo = std::numeric_limits<double>::max();
+            double hi = std::numeric_limits<double>::lowest();
+            for (const auto& p : points) {
+                lo = std::min(lo, p[d]);
+                hi = std::max(hi, p[d]);
+            }
+            origin_[d] = lo;
+            // Guard cells on each side keep stencil offsets non-negative
+            extent_[d] = static_cast<std::int64_t>((hi - lo) / cellSize_) + 1 + 2 * kReach;
+        }
+
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> keyed(n);
+        const std::int64_t count = static_cast<std::int64_t>(n);
+        #pragma omp parallel for schedule(static)
+        for (std::int64_t ii = 0; ii < count; ++ii) {
+            const std::size_t i = static_cast<std::size_t>(ii);
+            keyed[i] = {keyOf(cellOf(points[i])), static_cast<std::uint32_t>(i)};
+        }
+        std::sort(keyed.begin(), keyed.end());
+
+        order_.resize(n);
+        pointCell_.resize(n);
+        keys_.clear();
+        starts_.clear();
+        for (std::size_t i = 0; i < n; ++i) {
+            if (i == 0 || keyed[i].first != keyed[i - 1].first) {
+                keys_.push_back(keyed[i].first);
+                starts_.push_back(static_cast<std::uint32_t>(i));
+            }
+            order_[i] = keyed[i].second;
+            pointCell_[keyed[i].second] = static_cast<std::uint32_t>(keys_.size() - 1);
+        }
+        starts_.push_back(static_cast<std::uint32_t>(n));
+
+        // Occupied stencil cells per occupied cell (CSR, ascending slot order)
+        const std::size_t cells = keys_.size();
+        std::vector<std::vector<std::uint32_t>> found(cells);
+        const std::int64_t cellCount = static_cast<std::int64_t>(cells);
+        #pragma omp parallel for schedule(dynamic, 64)
+        for (std::int64_t cc = 0; cc < cellCount; ++cc) {
+            const std::size_t cell = static_cast<std::size_t>(cc);
+            const auto base = cellOf(points[order_[starts_[cell]]]);
+            // The kSpan cells along the last axis have consecutive keys, so
+            // each of the kSpan^3 rows costs one search plus a short scan
+            for (int offset = 0; offset < kStencil / kSpan; ++offset) {
+                std::array<std::int64_t, kGridDims> c = base;
+                int rest = offset;
+                for (int d = 0; d < 3; ++d) {
+                    c[d] += rest % kSpan - kReach;
+                    rest /= kSpan;
+                }
+                c[3] -= kReach;
+                const std::uint64_t first = keyOf(c);
+                const std::uint64_t last = first + (kSpan - 1);
+                for (auto it = std::lower_bound(keys_.begin(), keys_.end(), first);
+                     it != keys_.end() && *it <= last; ++it) {
+                    found[cell].push_back(static_cast<std::uint32_t>(it - keys_.begin()));
+                }
+            }
+            std::sort(found[cell].begin(), found[cell].end());
+        }
+        neighborStarts_.assign(cells + 1, 0);
+        for (std::size_t c = 0; c < cells; ++c) {
+            neighborStarts_[c + 1] = neighborStarts_[c] + static_cast<std::uint32_t>(found[c].size());
+        }
+        neighborCells_.resize(neighborStarts_[cells]);
+        for (std::size_t c = 0; c < cells; ++c) {
+            std::copy(found[c].begin(), found[c].end(), neighborCells_.begin() + neighborStarts_[c]);
+        }
+    }
+
+    std::size_t cellCount() const { return keys_.size(); }
+    std::uint32_t cellOfPoint(std::uint32_t i) const { return pointCell_[i]; }
+    // Points of cell `slot` are order()[cellBegin(slot) .. cellEnd(slot))
+    std::uint32_t cellBegin(std::uint32_t slot) const { return starts_[slot]; }
+    std::uint32_t cellEnd(std::uint32_t slot) const { return starts_[slot + 1]; }
+    const std::vector<std::uint32_t>& order() const { return order_; }
+    // Occupied cells that may hold eps-neighbors of cell `slot` (itself included)
+    const std::uint32_t* neighborsBegin(std::uint32_t slot) const { return neighborCells_.data() + neighborStarts_[slot]; }
+    const std::uint32_t* neighborsEnd(std::uint32_t slot) const { return neighborCells_.data() + neighborStarts_[slot + 1]; }
+
+private:
+    const std::vector<BeliefVec>* points_ = nullptr;
+    double cellSize_ = 1.0;
+    std::array<double, kGridDims> origin_{};
+    std::array<std::int64_t, kGridDims> extent_{1, 1, 1, 1};
+    std::vector<std::uint32_t> order_;           // point indices sorted by cell
+    std::vector<std::uint32_t> pointCell_;       // point -> occupied cell slot
+    std::vector<std::uint64_t> keys_;            // distinct cell keys (ascending)
+    std::vector<std::uint32_t> starts_;          // cell slot -> first position in order_
+    std::vector<std::uint32_t> neighborStarts_;  // cell slot -> range in neighborCells_
+    std::vector<std::uint32_t> neighborCells_;   // occupied stencil cell slots
+
+    std::array<std::int64_t, kGridDims> cellOf(const BeliefVec& p) const {
+        std::array<std::int64_t, kGridDims> c;
+        for (int d = 0; d < kGridDims; ++d) {
+            c[d] = static_cast<std::int64_t>((p[d] - origin_[d]) / cellSize_) + kReach;
+        }
+        return c;
+    }
+
+    std::uint64_t keyOf(const std::array<std::int64_t, kGridDims>& c) const {
+        std::uint64_t key = 0;
+        for (int d = 0; d < kGridDims; ++d) {
+            key = key * static_cast<std::uint64_t>(extent_[d]) + static_cast<std::uint64_t>(c[d]);
+        }
+        return key;
+    }
+};
+
+// Lock-free union-find; every root is the lowest index in its set
+std::uint32_t findRoot(std::vector<std::atomic<std::uint32_t>>& parent, std::uint32_t x) {
+    while (true) {
+        std::uint32_t p = parent[x].load(std::memory_order_relaxed);
+        if (p == x) return x;
+        std::uint32_t gp = parent[p].load(std::memory_order_relaxed);
+        if (gp != p) {
+            parent[x].compare_exchange_weak(p, gp, std::memory_order_relaxed);  // Path halving
+        }
+        x = gp;
+    }
+}
+
+void uniteSets(std::vector<std::atomic<std::uint32_t>>& parent, std::uint32_t a, std::uint32_t b) {
+    while (true) {
+        a = findRoot(parent, a);
+        b = findRoot(parent, b);
+        if (a == b) return;
+        if (a < b) std::swap(a, b);  // Link the higher root under the lower
+        std::uint32_t expected = a;
+        if (parent[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) return;
+    }
+}
+
+}
+
 DBSCANClustering::DBSCANClustering(double eps, int minPts)
     : eps_(std::max(1e-3, eps)), minPts_(std::max(2, minPts)) {}
 
-std::vector<std::uint32_t> DBSCANClustering::regionQuery(const std::vector<Agent>& agents,
-                                                         std::uint32_t idx) const {
-    std::vector<std::uint32_t> neighbors;
-    neighbors.reserve(minPts_ * 2);  // Reserve reasonable space
-    const auto& point = agents[idx].B;
-    const double eps2 = eps_ * eps_;  // Compare squared distances to avoid sqrt
-    
-    for (std::uint32_t i = 0; i < agents.size(); ++i) {
-        // Compute squared distance
-        double d2 = 0.0;
-        for (int k = 0; k < 4; ++k) {
-            double diff = point[k] - agents[i].B[k];
-            d2 += diff * diff;
-        }
-        if (d2 <= eps2) {
-            neighbors.push_back(i);
-        }
-    }
-    return neighbors;
+std::vector<Cluster> DBSCANClustering::run(const Kernel& kernel) {
+    return run(ClusteringSnapshot::capture(kernel));
 }
 
-void DBSCANClustering::expandCluster(const std::vector<Agent>& agents,
-                                     std::uint32_t idx,
-                                     std::vector<std::uint32_t>& neighbors,
-                                     std::vector<int>& labels,
-                                     int clusterId) {
-    labels[idx] = clusterId;
-    std::size_t i = 0;
-    while (i < neighbors.size()) {
-        auto neighborIdx = neighbors[i];
-        if (labels[neighborIdx] == -1) {
-            labels[neighborIdx] = clusterId;
-        }
-        if (labels[neighborIdx] == 0) {
-            labels[neighborIdx] = clusterId;
-            auto neighborNeighbors = regionQuery(agents, neighborIdx);
-            if (static_cast<int>(neighborNeighbors.size()) >= minPts_) {
-                neighbors.insert(neighbors.end(), neighborNeighbors.begin(), neighborNeighbors.end());
+std::vector<Cluster> DBSCANClustering::run(const ClusteringSnapshot& snapshot) {
+    noisePoints_ = 0;
+
+    const auto& points = snapshot.beliefs;
+    const std::size_t n = points.size();
+    if (n == 0) {
+        return {};
+    }
+
+    BeliefGrid grid;
+    grid.build(points, eps_);
+    const auto& order = grid.order();
+    const std::int64_t count = static_cast<std::int64_t>(n);
+    const std::int64_t cells = static_cast<std::int64_t>(grid.cellCount());
+    const std::uint32_t minPts = static_cast<std::uint32_t>(minPts_);
+    const double eps2 = eps_ * eps_;
+
+    // 1. Core points. A cell holding minPts points is all core (its points are
+    //    mutual neighbors); otherwise count across the stencil, stopping at minPts.
+    std::vector<std::uint8_t> isCore(n, 0);
+    #pragma omp parallel for schedule(dynamic, 256)
+    for (std::int64_t ii = 0; ii < count; ++ii) {
+        const std::uint32_t i = static_cast<std::uint32_t>(ii);
+        const std::uint32_t cell = grid.cellOfPoint(i);
+        std::uint32_t neighbors = BeliefGrid::kCellIsClique ? grid.cellEnd(cell) - grid.cellBegin(cell) : 0;
+        for (auto it = grid.neighborsBegin(cell); it != grid.neighborsEnd(cell) && neighbors < minPts; ++it) {
+            if (BeliefGrid::kCellIsClique && *it == cell) continue;
+            for (std::uint32_t s = grid.cellBegin(*it); s < grid.cellEnd(*it); ++s) {
+                if (squaredBeliefDistance(points[i], points[order[s]]) <= eps2 && ++neighbors >= minPts) break;
             }
         }
-        ++i;
+        isCore[i] = neighbors >= minPts ? 1 : 0;
+    }
+
+    // Core points of each cell, in cell order
+    std::vector<std::uint32_t> coreStarts(grid.cellCount() + 1, 0);
+    std::vector<std::uint32_t> cores;
+    cores.reserve(n);
+    for (std::size_t c = 0; c < grid.cellCount(); ++c) {
+        for (std::uint32_t s = grid.cellBegin(static_cast<std::uint32_t>(c)); s < grid.cellEnd(static_cast<std::uint32_t>(c)); ++s) {
+            if (isCore[order[s]]) cores.push_back(order[s]);
+        }
+        coreStarts[c + 1] = static_cast<std::uint32_t>(cores.size());
     }
+
+    // 2. Connect core points: a cell's cores are mutually reachable, so two
+    //    cells' cores connect if any cross pair lies within eps (stop at the
+    //    first). Wider belief spaces check every pair within and across cells
+    std::vector<std::atomic<std::uint32_t>> parent(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        parent[i].store(static_cast<std::uint32_t>(i), std::memory_order_relaxed);
+    }
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (std::int64_t cc = 0; cc < cells; ++cc) {
+        const std::uint32_t cell = static_cast<std::uint32_t>(cc);
+        const std::uint32_t begin = coreStarts[cell], end = coreStarts[cell + 1];
+        if (begin == end) continue;
+        for (std::uint32_t a = begin + 1; a < end; ++a) {
+            if (BeliefGrid::kCellIsClique) {
+                uniteSets(parent, cores[begin], cores[a]);
+                continue;
+            }
+            for (std::uint32_t b = begin; b < a; ++b) {
+                if (squaredBeliefDistance(points[cores[a]], points[cores[b]]) <= eps2) {
+                    uniteSets(parent, cores[a], cores[b]);
+                }
+            }
+        }
+        for (auto it = grid.neighborsBegin(cell); it != grid.neighborsEnd(cell); ++it) {
+            const std::uint32_t other = *it;
+            if (other <= cell || coreStarts[other] == coreStarts[other + 1]) continue;
+            if (BeliefGrid::kCellIsClique) {
+                if (findRoot(parent, cores[begin]) == findRoot(parent, cores[coreStarts[other]])) continue;
+                bool linked = false;
+                for (std::uint32_t a = begin; a < end && !linked; ++a) {
+                    for (std::uint32_t b = coreStarts[other]; b < coreStarts[other + 1]; ++b) {
+                        if (squaredBeliefDistance(points[cores[a]], points[cores[b]]) <= eps2) {
+                            uniteSets(parent, cores[a], cores[b]);
+                            linked = true;
+                            break;
+                        }
+                    }
+                }
+                continue;
+            }
+            // A cell's cores may span several components: link every pair
+            for (std::uint32_t a = begin; a < end; ++a) {
+                for (std::uint32_t b = coreStarts[other]; b < coreStarts[other + 1]; ++b) {
+                    if (squaredBeliefDistance(points[cores[a]], points[cores[b]]) <= eps2) {
+                        uniteSets(parent, cores[a], cores[b]);
+                    }
+                }
+            }
+        }
+    }
+
+    // 3. Cluster ids in order of each component's lowest core index
+    std::vector<int> labels(n, -1);
+    int clusterCount = 0;
+    for (std::uint32_t i = 0; i < n; ++i) {
+        if (!isCore[i]) continue;
+        const std::uint32_t root = findRoot(parent, i);
+        labels[i] = (root == i) ? clusterCount++ : labels[root];
+    }
+
+    // Border points join the lowest-id adjacent cluster; the rest is noise
+    int noise = 0;
+    #pragma omp parallel for schedule(dynamic, 256) reduction(+:noise)
+    for (std::int64_t ii = 0; ii < count; ++ii) {
+        const std::uint32_t i = static_cast<std::uint32_t>(ii);
+        if (isCore[i]) continue;
+        const std::uint32_t cell = grid.cellOfPoint(i);
+        int best = -1;
+        for (auto it = grid.neighborsBegin(cell); it != grid.neighborsEnd(cell); ++it) {
+            for (std::uint32_t c = coreStarts[*it]; c < coreStarts[*it + 1]; ++c) {
+                const std::uint32_t j = cores[c];
+                if ((best < 0 || labels[j] < best) && squaredBeliefDistance(points[i], points[j]) <= eps2) {
+                    best = labels[j];
+                }
+            }
+        }
+        labels[i] = best;
+        if (best < 0) ++noise;
+    }
+    noisePoints_ = noise;
+
+    std::vector<Cluster> clusters(static_cast<std::size_t>(clusterCount));
+    for (int c = 0; c < clusterCount; ++c) {
+        clusters[c].id = static_cast<std::uint32_t>(c);
+        clusters[c].birthTick = snapshot.generation;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        if (labels[i] < 0) continue;
+        clusters[labels[i]].members.push_back(snapshot.agentId[i]);
+    }
+
+    enrichClusters(clusters, snapshot);
+    return clusters;
 }
 
-std::vector<Cluster> DBSCANClustering::run(const Kernel& kernel) {
-    const auto& agents = kernel.agents();
-    std::vector<int> labels(agents.size(), 0);
-    int clusterId = 0;
-    noisePoints_ = 0;
+// ------------ Cluster tracking ------------
+ClusterTracker::ClusterTracker(const ClusterTrackerConfig& cfg) : cfg_(cfg) {}
 
-    for (std::uint32_t i = 0; i < agents.size(); ++i) {
-        if (labels[i] != 0) continue;
-        auto neighbors = regionQuery(agents, i);
-        if (static_cast<int>(neighbors.size()) < minPts_) {
-            labels[i] = -1;
-            noisePoints_++;
+void ClusterTracker::clear() {
+    live_.clear();
+    retired_.clear();
+    labels_.clear();
+    nextId_ = 0;
+}
+
+void ClusterTracker::update(std::vector<Cluster>& clusters, std::uint64_t tick) {
+    const std::size_t fresh = clusters.size();
+    const std::size_t previous = live_.size();
+
+    // Candidate continuations, higher score = better match
+    struct Candidate {
+        double score;
+        std::uint32_t cluster;  // index into clusters
+        std::uint32_t record;   // index into live_
+    };
+    std::vector<Candidate> candidates;
+    if (fresh > 0 && previous > 0) {
+        if (cfg_.match == ClusterMatch::Overlap) {
+            // Intersections: each new cluster owns one row, so rows fill in parallel
+            overlap_.assign(fresh * previous, 0);
+            const std::int64_t count = static_cast<std::int64_t>(fresh);
+            #pragma omp parallel for schedule(dynamic)
+            for (std::int64_t jj = 0; jj < count; ++jj) {
+                const std::size_t j = static_cast<std::size_t>(jj);
+                std::uint32_t* row = &overlap_[j * previous];
+                for (std::uint32_t id : clusters[j].members) {
+                    if (id < labels_.size() && labels_[id] >= 0) {
+                        row[labels_[id]]++;
+                    }
+                }
+            }
+            for (std::size_t j = 0; j < fresh; ++j) {
+                for (std::size_t p = 0; p < previous; ++p) {
+                    const double shared = overlap_[j * previous + p];
+                    if (shared == 0.0) continue;
+                    const double united = clusters[j].members.size() + live_[p].size - shared;
+                    const double jaccard = shared / united;
+                    if (jaccard >= cfg_.minOverlap) {
+                        candidates.push_back({jaccard, static_cast<std::uint32_t>(j),
+                                              static_cast<std::uint32_t>(p)});
+                    }
+                }
+            }
         } else {
-            ++clusterId;
-            expandCluster(agents, i, neighbors, labels, clusterId);
+            for (std::size_t j = 0; j < fresh; ++j) {
+                for (std::size_t p = 0; p < previous; ++p) {
+                    const double dist = beliefDistance(clusters[j].centroid, live_[p].centroid);
+                    if (dist <= cfg_.maxCentroidDistance) {
+                        candidates.push_back({-dist, static_cast<std::uint32_t>(j),
+                                              static_cast<std::uint32_t>(p)});
+                    }
+                }
+            }
         }
     }
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        if (a.score != b.score) return a.score > b.score;
+        if (a.cluster != b.cluster) return a.cluster < b.cluster;
+        return a.record < b.record;
+    });
+
+    std::vector<int> continues(fresh, -1);
+    std::vector<std::uint8_t> taken(previous, 0);
+    for (const auto& candidate : candidates) {
+        if (continues[candidate.cluster] >= 0 || taken[candidate.record]) continue;
+        continues[candidate.cluster] = static_cast<int>(candidate.record);
+        taken[candidate.record] = 1;
+    }
 
-    std::unordered_map<int, Cluster> map;
-    for (std::uint32_t i = 0; i < agents.size(); ++i) {
-        if (labels[i] <= 0) continue;
-        int cid = labels[i] - 1;
-        auto& cluster = map[cid];
-        if (cluster.members.empty()) {
-            cluster.id = static_cast<std::uint32_t>(cid);
-            cluster.birthTick = kernel.generation();
+    std::vector<ClusterRecord> next(fresh);
+    for (std::size_t j = 0; j < fresh; ++j) {
+        ClusterRecord& record = next[j];
+        if (continues[j] >= 0) {
+            const ClusterRecord& before = live_[static_cast<std::size_t>(continues[j])];
+            record.id = before.id;
+            record.birthTick = before.birthTick;
+        } else {
+            record.id = nextId_++;
+            record.birthTick = tick;
         }
-        cluster.members.push_back(agents[i].id);
+        record.centroid = clusters[j].centroid;
+        record.size = static_cast<std::uint32_t>(clusters[j].members.size());
+        clusters[j].id = record.id;
+        clusters[j].birthTick = record.birthTick;
+        clusters[j].deathTick = 0;
     }
 
-    std::vector<Cluster> clusters;
-    clusters.reserve(map.size());
-    for (auto& kv : map) {
-        clusters.push_back(std::move(kv.second));
+    for (std::size_t p = 0; p < previous; ++p) {
+        if (taken[p]) continue;
+        retired_.push_back(live_[p]);
+        retired_.back().deathTick = tick;
     }
-    std::sort(clusters.begin(), clusters.end(), [](const Cluster& a, const Cluster& b) {
-        return a.id < b.id;
-    });
+    if (retired_.size() > kMaxRetired) {
+        retired_.erase(retired_.begin(), retired_.end() - kMaxRetired);
+    }
+    live_ = std::move(next);
 
-    enrichClusters(clusters, kernel);
-    return clusters;
+    // Agent labels for the next overlap pass
+    if (cfg_.match == ClusterMatch::Overlap) {
+        std::fill(labels_.begin(), labels_.end(), -1);
+        for (std::size_t j = 0; j < fresh; ++j) {
+            for (std::uint32_t id : clusters[j].members) {
+                if (id >= labels_.size()) labels_.resize(static_cast<std::size_t>(id) + 1, -1);
+                labels_[id] = static_cast<int>(j);
+            }
+        }
+    }
 }
 
 // ----------- Enrichment & Metrics --------
 
+namespace {
+
+constexpr std::size_t kLanguageFamilies = 4;
+constexpr std::size_t kDialectSlots = kLanguageFamilies * 256;  // lang * 256 + dialect
+constexpr std::size_t kTopRegions = 5;
+
+}
+
 void enrichClusters(std::vector<Cluster>& clusters, const Kernel& kernel) {
-    const auto& agents = kernel.agents();
-    for (auto& cluster : clusters) {
-        if (cluster.members.empty()) continue;
-        std::array<double, 4> sum{0, 0, 0, 0};
-        std::array<double, 4> sq{0, 0, 0, 0};
-        std::array<int, 4> langs{0, 0, 0, 0};
-        std::unordered_map<std::uint32_t, int> regionCounts;
-        std::unordered_map<std::uint16_t, int> dialectCounts;  // key = lang*256 + dialect
-
-        for (auto aid : cluster.members) {
-            const auto& agent = agents[aid];
-            for (int d = 0; d < 4; ++d) {
-                sum[d] += agent.B[d];
-                sq[d] += agent.B[d] * agent.B[d];
-            }
-            langs[agent.primaryLang]++;
-            regionCounts[agent.region]++;
-            // Track dialect distribution
-            std::uint16_t dialectKey = static_cast<std::uint16_t>(agent.primaryLang) * 256 + agent.dialect;
-            dialectCounts[dialectKey]++;
+    enrichClusters(clusters, ClusteringSnapshot::capture(kernel));
+}
+
+void enrichClusters(std::vector<Cluster>& clusters, const ClusteringSnapshot& snapshot) {
+    const std::size_t k = clusters.size();
+    if (k == 0 || snapshot.size() == 0) return;
+
+    // Snapshot row -> cluster labels (memberships are disjoint for every
+    // clustering here); members no longer alive in the snapshot are skipped
+    std::vector<int> label(snapshot.size(), -1);
+    std::vector<std::uint32_t> sizes(k, 0);
+    for (std::size_t c = 0; c < k; ++c) {
+        for (auto aid : clusters[c].members) {
+            const std::int32_t row = snapshot.row(aid);
+            if (row < 0) continue;
+            label[static_cast<std::size_t>(row)] = static_cast<int>(c);
+            sizes[c]++;
         }
+    }
+    const std::size_t regions = snapshot.regionCount;
+
+    // Dense per-thread, per-cluster tallies in one flat block:
+    //   ints    [languages | dialects | regions], doubles [Σb | Σb²]
+    const std::size_t intStride = kLanguageFamilies + kDialectSlots + regions;
+    const std::size_t threads = static_cast<std::size_t>(std::max(1, omp_get_max_threads()));
+    std::vector<std::uint32_t> counts(threads * k * intStride, 0);
+    constexpr std::size_t kMomentStride = 2 * kBeliefDims;
+    std::vector<double> moments(threads * k * kMomentStride, 0.0);
+
+    const std::int64_t n = static_cast<std::int64_t>(snapshot.size());
+    const std::int64_t clusterCount = static_cast<std::int64_t>(k);
+    #pragma omp parallel
+    {
+    const std::size_t tid = static_cast<std::size_t>(omp_get_thread_num());
+    std::uint32_t* myCounts = &counts[tid * k * intStride];
+    double* myMoments = &moments[tid * k * kMomentStride];
 
-        for (int d = 0; d < 4; ++d) {
-            cluster.centroid[d] = sum[d] / cluster.members.size();
+    #pragma omp for schedule(static)
+    for (std::int64_t ii = 0; ii < n; ++ii) {
+        const std::size_t i = static_cast<std::size_t>(ii);
+        if (label[i] < 0) continue;
+        const auto& b = snapshot.beliefs[i];
+        const std::size_t c = static_cast<std::size_t>(label[i]);
+        std::uint32_t* tally = myCounts + c * intStride;
+        double* m = myMoments + c * kMomentStride;
+        for (int d = 0; d < kBeliefDims; ++d) {
+            m[d] += b[d];
+            m[kBeliefDims + d] += b[d] * b[d];
+        }
+        const std::size_t lang = snapshot.lang[i] % kLanguageFamilies;
+        tally[lang]++;
+        tally[kLanguageFamilies + lang * 256 + snapshot.dialect[i]]++;
+        tally[kLanguageFamilies + kDialectSlots + snapshot.region[i]]++;
+    }
+
+    // Fold every thread's tallies into slot 0 and finish, one cluster per iteration
+    #pragma omp for schedule(dynamic)
+    for (std::int64_t cc = 0; cc < clusterCount; ++cc) {
+        const std::size_t c = static_cast<std::size_t>(cc);
+        Cluster& cluster = clusters[c];
+        if (sizes[c] == 0) continue;
+        std::uint32_t* tally = &counts[c * intStride];
+        double* m = &moments[c * kMomentStride];
+        for (std::size_t t = 1; t < threads; ++t) {
+            const std::uint32_t* other = &counts[(t * k + c) * intStride];
+            for (std::size_t j = 0; j < intStride; ++j) tally[j] += other[j];
+            const double* otherMoments = &moments[(t * k + c) * kMomentStride];
+            for (std::size_t j = 0; j < kMomentStride; ++j) m[j] += otherMoments[j];
         }
 
+        const double size = static_cast<double>(sizes[c]);
         double variance = 0.0;
-        for (int d = 0; d < 4; ++d) {
-            double mean = cluster.centroid[d];
-            variance += (sq[d] / cluster.members.size()) - mean * mean;
+        for (int d = 0; d < kBeliefDims; ++d) {
+            cluster.centroid[d] = m[d] / size;
+            variance += m[kBeliefDims + d] / size - cluster.centroid[d] * cluster.centroid[d];
         }
-        variance = std::max(0.0, variance / 4.0);
+        variance = std::max(0.0, variance / kBeliefDims);
         cluster.coherence = std::max(0.0, 1.0 - variance);
 
         // Language family shares
-        int maxLangCount = 0;
-        for (int l = 0; l < 4; ++l) {
-            cluster.languageShare[l] = static_cast<double>(langs[l]) / cluster.members.size();
-            if (langs[l] > maxLangCount) {
-                maxLangCount = langs[l];
+        std::uint32_t maxLangCount = 0;
+        double sumSqShare = 0.0;
+        for (std::size_t l = 0; l < kLanguageFamilies; ++l) {
+            cluster.languageShare[l] = tally[l] / size;
+            sumSqShare += cluster.languageShare[l] * cluster.languageShare[l];
+            if (tally[l] > maxLangCount) {
+                maxLangCount = tally[l];
                 cluster.dominantLang = static_cast<std::uint8_t>(l);
             }
         }
-        
-        // Find dominant dialect
-        int maxDialectCount = 0;
-        for (const auto& [key, count] : dialectCounts) {
-            if (count > maxDialectCount) {
-                maxDialectCount = count;
+
+        // Dominant dialect (lowest lang/dialect key wins ties)
+        const std::uint32_t* dialects = tally + kLanguageFamilies;
+        std::uint32_t maxDialectCount = 0;
+        for (std::size_t key = 0; key < kDialectSlots; ++key) {
+            if (dialects[key] > maxDialectCount) {
+                maxDialectCount = dialects[key];
                 cluster.dominantDialect = static_cast<std::uint8_t>(key & 0xFF);
             }
         }
-        
+
         // Linguistic homogeneity: how concentrated is the language distribution
         // 1.0 = everyone speaks same language, 0.25 = uniform across 4 languages
-        double sumSqShare = 0.0;
-        for (int l = 0; l < 4; ++l) {
-            sumSqShare += cluster.languageShare[l] * cluster.languageShare[l];
-        }
         // Normalize: (sumSq - 0.25) / 0.75 maps [0.25, 1.0] to [0.0, 1.0]
         cluster.linguisticHomogeneity = std::max(0.0, (sumSqShare - 0.25) / 0.75);
 
-        std::vector<std::pair<std::uint32_t, int>> regionVec(regionCounts.begin(), regionCounts.end());
-        std::sort(regionVec.begin(), regionVec.end(), [](const auto& a, const auto& b) {
-            return a.second > b.second;
-        });
+        // Top regions by partial insertion selection (count desc, region asc)
+        const std::uint32_t* regionCounts = tally + kLanguageFamilies + kDialectSlots;
+        std::array<std::pair<std::uint32_t, std::uint32_t>, kTopRegions> top{};  // (count, region)
+        std::size_t held = 0;
+        for (std::size_t r = 0; r < regions; ++r) {
+            const std::uint32_t count = regionCounts[r];
+            if (count == 0 || (held == kTopRegions && count <= top[held - 1].first)) continue;
+            std::size_t pos = std::min(held, kTopRegions - 1);
+            while (pos > 0 && top[pos - 1].first < count) {
+                top[pos] = top[pos - 1];
+                --pos;
+            }
+            top[pos] = {count, static_cast<std::uint32_t>(r)};
+            held = std::min(held + 1, kTopRegions);
+        }
         cluster.topRegions.clear();
-        for (std::size_t i = 0; i < std::min<std::size_t>(5, regionVec.size()); ++i) {
-            double share = static_cast<double>(regionVec[i].second) / cluster.members.size();
-            cluster.topRegions.emplace_back(regionVec[i].first, share);
+        for (std::size_t j = 0; j < held; ++j) {
+            cluster.topRegions.emplace_back(top[j].second, top[j].first / size);
         }
     }
+    }  // omp parallel
+}
+
+ClusterMetrics computeClusterMetrics(const std::vector<Cluster>& clusters, const Kernel& kernel,
+                                     const SilhouetteOptions& options) {
+    return computeClusterMetrics(clusters, ClusteringSnapshot::capture(kernel), options);
 }
 
-ClusterMetrics computeClusterMetrics(const std::vector<Cluster>& clusters, const Kernel& kernel) {
+ClusterMetrics computeClusterMetrics(const std::vector<Cluster>& clusters,
+                                     const ClusteringSnapshot& snapshot,
+                                     const SilhouetteOptions& options) {
     ClusterMetrics metrics;
-    const auto& agents = kernel.agents();
-    if (agents.empty() || clusters.empty()) {
+    const std::size_t alive = snapshot.size();
+    if (alive == 0 || clusters.empty()) {
         return metrics;
     }
+    const auto& beliefs = snapshot.beliefs;
 
-    double totalWithin = 0.0;
-    for (const auto& cluster : clusters) {
-        if (cluster.members.empty()) continue;
-        for (auto aid : cluster.members) {
-            totalWithin += std::pow(distance4d(agents[aid].B, cluster.centroid), 2);
+    // Member rows per cluster (members that died since clustering are dropped)
+    const std::size_t k = clusters.size();
+    std::vector<std::vector<std::uint32_t>> rows(k);
+    for (std::size_t c = 0; c < k; ++c) {
+        rows[c].reserve(clusters[c].members.size());
+        for (auto aid : clusters[c].members) {
+            const std::int32_t row = snapshot.row(aid);
+            if (row >= 0) rows[c].push_back(static_cast<std::uint32_t>(row));
         }
     }
-    metrics.withinVariance = totalWithin / agents.size();
 
-    std::array<double, 4> global{0, 0, 0, 0};
-    for (const auto& agent : agents) {
-        for (int d = 0; d < 4; ++d) {
-            global[d] += agent.B[d];
+    // Global mean over living agents
+    BeliefVec global{};
+    for (const auto& b : beliefs) {
+        for (int d = 0; d < kBeliefDims; ++d) {
+            global[d] += b[d];
         }
     }
-    for (int d = 0; d < 4; ++d) {
-        global[d] /= agents.size();
+    for (int d = 0; d < kBeliefDims; ++d) {
+        global[d] /= alive;
     }
 
+    double totalWithin = 0.0;
     double between = 0.0;
-    for (const auto& cluster : clusters) {
-        if (cluster.members.empty()) continue;
-        double weight = static_cast<double>(cluster.members.size()) / agents.size();
-        between += weight * std::pow(distance4d(cluster.centroid, global), 2);
+    double entropy = 0.0;
+    std::size_t nonEmpty = 0;
+    for (std::size_t c = 0; c < k; ++c) {
+        const auto& members = rows[c];
+        if (members.empty()) continue;
+        ++nonEmpty;
+        const auto& centroid = clusters[c].centroid;
+        const std::int64_t count = static_cast<std::int64_t>(members.size());
+        double within = 0.0;
+        #pragma omp parallel for schedule(static) reduction(+:within)
+        for (std::int64_t ii = 0; ii < count; ++ii) {
+            within += squaredBeliefDistance(beliefs[members[static_cast<std::size_t>(ii)]], centroid);
+        }
+        totalWithin += within;
+
+        double p = static_cast<double>(members.size()) / alive;
+        between += p * squaredBeliefDistance(centroid, global);
+        entropy -= p * std::log2(std::max(p, 1e-12));
     }
+    metrics.withinVariance = totalWithin / alive;
     metrics.betweenVariance = between;
+    metrics.diversity = entropy;
 
     double denom = std::max(metrics.withinVariance, metrics.betweenVariance);
     if (denom > 0) {
-        metrics.silhouette = (metrics.betweenVariance - metrics.withinVariance) / denom;
+        metrics.varianceRatio = (metrics.betweenVariance - metrics.withinVariance) / denom;
     }
 
-    double entropy = 0.0;
-    for (const auto& cluster : clusters) {
-        if (cluster.members.empty()) continue;
-        double p = static_cast<double>(cluster.members.size()) / agents.size();
-        entropy -= p * std::log2(std::max(p, 1e-12));
+    if (options.sampleSize == 0 || nonEmpty < 2) {
+        return metrics;
     }
-    metrics.diversity = entropy;
 
+    // ---- Sampled silhouette ----
+    // Per-cluster reference sets: every member of a small cluster (exact mean
+    // distances), otherwise `referencePerCluster` uniform draws
+    std::mt19937_64 rng(options.seed ^ (snapshot.generation * 0x9E3779B97F4A7C15ULL));
+    const std::size_t refCap = std::max<std::size_t>(1, options.referencePerCluster);
+    std::vector<std::vector<BeliefVec>> reference(k);
+    std::vector<std::uint8_t> exact(k, 0);
+    std::vector<std::size_t> offsets(k + 1, 0);
+    for (std::size_t c = 0; c < k; ++c) {
+        const auto& members = rows[c];
+        offsets[c + 1] = offsets[c] + members.size();
+        if (members.empty()) continue;
+        if (members.size() <= refCap) {
+            exact[c] = 1;
+            reference[c].reserve(members.size());
+            for (auto row : members) reference[c].push_back(beliefs[row]);
+        } else {
+            std::uniform_int_distribution<std::size_t> pick(0, members.size() - 1);
+            reference[c].reserve(refCap);
+            for (std::size_t j = 0; j < refCap; ++j) reference[c].push_back(beliefs[members[pick(rng)]]);
+        }
+    }
+
+    // Evaluation points: uniform over all clustered agents, with replacement
+    const std::size_t samples = options.sampleSize;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> drawn(samples);  // (cluster, row)
+    std::uniform_int_distribution<std::size_t> position(0, offsets[k] - 1);
+    for (auto& draw : drawn) {
+        const std::size_t pos = position(rng);
+        const std::size_t c = static_cast<std::size_t>(
+            std::upper_bound(offsets.begin(), offsets.end(), pos) - offsets.begin()) - 1;
+        draw = {static_cast<std::uint32_t>(c), rows[c][pos - offsets[c]]};
+    }
+
+    std::vector<double> values(samples, 0.0);
+    const std::int64_t sampleCount = static_cast<std::int64_t>(samples);
+    #pragma omp parallel for schedule(static)
+    for (std::int64_t ss = 0; ss < sampleCount; ++ss) {
+        const std::size_t s = static_cast<std::size_t>(ss);
+        const std::size_t own = drawn[s].first;
+        const auto& x = beliefs[drawn[s].second];
+        if (rows[own].size() < 2) continue;  // Singleton: s(i) = 0
+
+        auto meanDistance = [&](std::size_t c) {
+            double sum = 0.0;
+            for (const auto& y : reference[c]) sum += beliefDistance(x, y);
+            return sum;
+        };
+        // Exact own-cluster sets contain x itself (distance 0): divide by size - 1
+        const double a = meanDistance(own) /
+            (exact[own] ? static_cast<double>(reference[own].size() - 1)
+                        : static_cast<double>(reference[own].size()));
+        double b = std::numeric_limits<double>::max();
+        for (std::size_t c = 0; c < k; ++c) {
+            if (c == own || reference[c].empty()) continue;
+            b = std::min(b, meanDistance(c) / static_cast<double>(reference[c].size()));
+        }
+        const double scale = std::max(a, b);
+        values[s] = scale > 0.0 ? (b - a) / scale : 0.0;
+    }
+
+    double mean = 0.0;
+    for (double v : values) mean += v;
+    mean /= static_cast<double>(samples);
+    double var = 0.0;
+    for (double v : values) var += (v - mean) * (v - mean);
+    var = samples > 1 ? var / static_cast<double>(samples - 1) : 0.0;
+    const double halfWidth = options.zScore * std::sqrt(var / static_cast<double>(samples));
+
+    metrics.silhouette = mean;
+    metrics.silhouetteLow = std::max(-1.0, mean - halfWidth);
+    metrics.silhouetteHigh = std::min(1.0, mean + halfWidth);
+    metrics.silhouetteSamples = samples;
     return metrics;
 }
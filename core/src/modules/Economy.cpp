@@ -1,6 +1,7 @@
 #include "modules/Economy.h"
 #include "modules/TradeNetwork.h"
 #include "kernel/Kernel.h"  // For Agent definition
+#include "utils/SpatialIndex.h"
 #include <algorithm>
 #include <numeric>
 #include <cmath>
@@ -11,6 +12,7 @@
 #include <functional>
 #include <thread>
 #include <atomic>
+#include <limits>
 
 // Thread-local RNG for parallel operations (prevents race conditions)
 // Uses a combination of random_device + thread ID + global counter for unique seeding
@@ -86,9 +88,102 @@ constexpr double SPECIALIZATION_RATE = 0.001;  // per tick
 // Price adjustment rate
 constexpr double PRICE_ADJUSTMENT_RATE = 0.05;  // per tick based on supply/demand
 
+// Welfare-driven demand on top of subsistence, per good (trade demand)
+constexpr std::array<double, kGoodTypes> TRADE_DEMAND_WELFARE_WEIGHT = {0.2, 0.3, 0.2, 0.5, 0.4};
+
 // Transport cost (scales with distance)
 constexpr double BASE_TRANSPORT_COST = 0.02;  // 2% per hop
 
+// ---------- Economic system rule tables ----------
+// EMERGENT SYSTEMS: each rule is a box in (material conditions × beliefs)
+// space; the first box a region falls into names its ideal system, and
+// regions that fit no box default to a mixed economy. Bounds are open
+// intervals, matching the original strict `>`/`<` cascade exactly.
+namespace {
+    constexpr double kUnbounded = std::numeric_limits<double>::infinity();
+
+    struct SignalRange {
+        double lo = -kUnbounded;
+        double hi = kUnbounded;
+
+        bool contains(double v) const {
+            return (lo == -kUnbounded || v > lo) && (hi == kUnbounded || v < hi);
+        }
+    };
+
+    constexpr SignalRange kAny{};
+    constexpr SignalRange above(double v) { return {v, kUnbounded}; }
+    constexpr SignalRange below(double v) { return {-kUnbounded, v}; }
+
+    struct SystemSignals {
+        double development;
+        double hardship;
+        double inequality;
+        double polarization;
+        double authority;
+        double tradition;
+        double hierarchy;
+    };
+
+    struct SystemRule {
+        EconomicSystem system;
+        SignalRange development, hardship, inequality, polarization;
+        SignalRange authority, tradition, hierarchy;
+
+        bool matches(const SystemSignals& s) const {
+            return development.contains(s.development) && hardship.contains(s.hardship) &&
+                   inequality.contains(s.inequality) && polarization.contains(s.polarization) &&
+                   authority.contains(s.authority) && tradition.contains(s.tradition) &&
+                   hierarchy.contains(s.hierarchy);
+        }
+    };
+
+    using ES = EconomicSystem;
+
+    // Dominant-pole rules. Thresholds match the simulated development range (0.5-1.0).
+    //                 system          development   hardship     inequality   polarization  authority     tradition    hierarchy
+    constexpr SystemRule kPoleSystemRules[] = {
+        // Low development → feudal or cooperative (subsistence economies)
+        {ES::Feudal,      below(0.4),  kAny,        kAny,        kAny,        above(0.05),  kAny,        above(0.1)},
+        {ES::Cooperative, below(0.4),  kAny,        kAny,        kAny,        kAny,         kAny,        below(-0.05)},
+        // Crisis conditions → revolutionary pressure (equality-seeking plan or strongman restoration)
+        {ES::Planned,     kAny,        above(0.35), above(0.45), kAny,        kAny,         kAny,        below(-0.05)},
+        {ES::Feudal,      kAny,        above(0.35), above(0.45), kAny,        above(0.05),  kAny,        kAny},
+        // Highly polarized regions → the stronger faction decides, with a lower feudal bar
+        {ES::Cooperative, above(0.8),  kAny,        kAny,        above(0.05), below(-0.1),  kAny,        below(-0.1)},
+        {ES::Market,      above(0.5),  kAny,        kAny,        above(0.05), below(-0.05), kAny,        above(0.02)},
+        {ES::Planned,     above(0.5),  kAny,        kAny,        above(0.05), above(0.1),   kAny,        below(0.05)},
+        {ES::Feudal,      kAny,        kAny,        kAny,        above(0.05), above(0.08),  kAny,        above(0.12)},
+        // Developed: liberty+equality → cooperative, liberty+hierarchy → market, authority+equality → planned
+        {ES::Cooperative, above(0.8),  kAny,        kAny,        kAny,        below(-0.1),  kAny,        below(-0.1)},
+        {ES::Market,      above(0.5),  kAny,        kAny,        kAny,        below(-0.05), kAny,        above(0.02)},
+        {ES::Planned,     above(0.5),  kAny,        kAny,        kAny,        above(0.1),   kAny,        below(0.05)},
+        // Traditional + hierarchical → feudal remnants
+        {ES::Feudal,      below(0.7),  kAny,        kAny,        kAny,        kAny,         above(0.1),  above(0.12)},
+    };
+
+    // Legacy mean-based rules
+    constexpr SystemRule kMeanSystemRules[] = {
+        {ES::Feudal,      below(0.6),  kAny,        kAny,        kAny,        above(0.1),   kAny,        above(0.15)},
+        {ES::Cooperative, below(0.6),  kAny,        kAny,        kAny,        kAny,         kAny,        below(-0.1)},
+        {ES::Planned,     kAny,        above(0.4),  above(0.5),  kAny,        kAny,         kAny,        below(-0.1)},
+        {ES::Feudal,      kAny,        above(0.4),  above(0.5),  kAny,        above(0.1),   kAny,        kAny},
+        {ES::Cooperative, above(1.2),  kAny,        kAny,        kAny,        below(-0.15), kAny,        below(-0.15)},
+        {ES::Market,      above(0.8),  kAny,        kAny,        kAny,        below(-0.1),  kAny,        above(0.05)},
+        {ES::Planned,     above(0.8),  kAny,        kAny,        kAny,        above(0.15),  kAny,        below(0.1)},
+        {ES::Feudal,      below(1.0),  kAny,        kAny,        kAny,        kAny,         above(0.2),  above(0.2)},
+    };
+
+    template <std::size_t N>
+    EconomicSystem evaluateSystemRules(const SystemRule (&rules)[N], const SystemSignals& signals) {
+        for (const auto& rule : rules) {
+            if (rule.matches(signals)) return rule.system;
+        }
+        // Default: mixed economy (most common in moderate/contested conditions)
+        return EconomicSystem::Mixed;
+    }
+}
+
 Economy::~Economy() = default;
 
 void Economy::init(std::uint32_t num_regions,
@@ -105,6 +200,7 @@ void Economy::init(std::uint32_t num_regions,
     // Initialize trade network
     trade_network_ = std::make_unique<TradeNetwork>();
     trade_network_->configure(num_regions);
+    trade_network_->setSolverConfig(trade_solver_config_);
     
     std::normal_distribution<double> devNoise(0.0, start_profile_.developmentJitter);
     
@@ -139,10 +235,11 @@ void Economy::init(std::uint32_t num_regions,
 }
 
 void Economy::update(const std::vector<std::uint32_t>& region_populations,
-                    const std::vector<std::array<double, 4>>& region_belief_centroids,
+                    const std::vector<BeliefVec>& region_belief_centroids,
                     const std::vector<Agent>& agents,
                     std::uint64_t generation,
-                    const std::vector<std::vector<std::uint32_t>>* region_index) {
+                    const std::vector<std::vector<std::uint32_t>>* region_index,
+                    const std::vector<RegionalBeliefProfile>* belief_profiles) {
     // Update population counts
     for (std::size_t i = 0; i < regions_.size(); ++i) {
         regions_[i].population = region_populations[i];
@@ -152,8 +249,11 @@ void Economy::update(const std::vector<std::uint32_t>& region_populations,
     if (generation % 10 == 0) {
         evolveSpecialization();
         evolveDevelopment();
-        // Use dominant pole analysis when we have per-agent data
-        if (region_index != nullptr && !agents.empty()) {
+        // Use dominant pole analysis: maintained profiles (O(R)) if the caller
+        // keeps them, otherwise scan per-agent data
+        if (belief_profiles != nullptr && belief_profiles->size() == regions_.size()) {
+            evolveEconomicSystems(*belief_profiles);
+        } else if (region_index != nullptr && !agents.empty()) {
             evolveEconomicSystems(agents, *region_index);
         } else {
             // Fallback to mean-based analysis (legacy)
@@ -161,23 +261,29 @@ void Economy::update(const std::vector<std::uint32_t>& region_populations,
         }
     }
     
-    computeProduction();
-    computeTrade();
-    computeConsumption();
-    updatePrices();
+    // Fused per-region kernels: regional needs are computed once per update
+    computeSupply();    // production + needs + trade surplus
+    computeTrade();     // sparse diffusion over the surplus block
+    computeMarkets();   // consumption, prices, welfare, hardship
     distributeIncome(agents, region_index);
-    computeWelfare();
     computeInequality(agents, region_index);
-    computeHardship();
 }
 
-void Economy::computeProduction() {
-    for (auto& region : regions_) {
+void Economy::computeSupply() {
+    const std::size_t num_regions = regions_.size();
+    region_needs_.resize(num_regions);
+    trade_surplus_.resize(num_regions);
+    
+    const std::int64_t n = static_cast<std::int64_t>(num_regions);
+    #pragma omp parallel for schedule(static)
+    for (std::int64_t ii = 0; ii < n; ++ii) {
+        const std::size_t i = static_cast<std::size_t>(ii);
+        auto& region = regions_[i];
+        
+        // production = endowment_per_capita × population × specialization × tech × efficiency × development × (1 - war)
+        const double dev_bonus = 1.0 + region.development * 0.2;
         for (int g = 0; g < kGoodTypes; ++g) {
-            // production = endowment_per_capita × population × specialization × tech × efficiency × development × (1 - war)
             double spec_bonus = 1.0 + region.specialization[g];
-            double dev_bonus = 1.0 + region.development * 0.2;
-            
             region.production[g] = region.endowments[g] 
                                  * region.population
                                  * spec_bonus
@@ -186,18 +292,80 @@ void Economy::computeProduction() {
                                  * dev_bonus
                                  * (1.0 - war_allocation_);
         }
+        
+        // EMERGENT NEEDS: memoized for trade, prices and hardship this update
+        double pop_density = region.population / 500.0;  // normalized density
+        RegionalNeeds rn = computeRegionalNeeds(region.x, region.y, region.development, pop_density);
+        auto& needs = region_needs_[i];
+        needs[FOOD] = rn.food;
+        needs[ENERGY] = rn.energy;
+        needs[TOOLS] = rn.tools;
+        needs[LUXURY] = rn.luxury;
+        needs[SERVICES] = rn.services;
+        
+        // EMERGENT DEMAND: subsistence plus welfare-driven wants
+        auto& surplus = trade_surplus_[i];
+        surplus = region.production;
+        if (region.population > 0) {
+            const double pop = static_cast<double>(region.population);
+            for (int g = 0; g < kGoodTypes; ++g) {
+                surplus[g] -= pop * (needs[g] + region.welfare * TRADE_DEMAND_WELFARE_WEIGHT[g]);
+            }
+        }
     }
 }
 
-void Economy::computeWelfare() {
-    for (auto& region : regions_) {
+void Economy::computeMarkets() {
+    const std::int64_t n = static_cast<std::int64_t>(regions_.size());
+    
+    #pragma omp parallel for schedule(static)
+    for (std::int64_t ii = 0; ii < n; ++ii) {
+        const std::size_t i = static_cast<std::size_t>(ii);
+        auto& region = regions_[i];
+        
+        // Consumption = local production + net imports
+        for (int g = 0; g < kGoodTypes; ++g) {
+            region.consumption[g] = std::max(0.0, region.production[g] + region.trade_balance[g]);
+        }
+        
         if (region.population == 0) {
             region.welfare = 1.0;
+            region.hardship = 0.0;
             continue;
         }
         
-        // Welfare = weighted average consumption per capita
-        // Essentials weighted more heavily
+        const auto& needs = region_needs_[i];
+        
+        // PRICES: adjust on supply/demand balance (demand uses last update's welfare)
+        for (int g = 0; g < kGoodTypes; ++g) {
+            double supply = region.production[g];
+            double demand = region.population * (needs[g] + region.welfare * 0.5);  // demand increases with welfare
+            
+            double supply_demand_ratio = (demand > 0) ? (supply / demand) : 1.0;
+            
+            // Price adjusts: high demand → higher price, high supply → lower price
+            if (supply_demand_ratio < 0.8) {
+                // Shortage → price increases
+                region.prices[g] *= (1.0 + PRICE_ADJUSTMENT_RATE);
+            } else if (supply_demand_ratio > 1.2) {
+                // Surplus → price decreases
+                region.prices[g] *= (1.0 - PRICE_ADJUSTMENT_RATE * 0.5);
+            }
+            
+            // EMERGENT PRICE BOUNDS: Extreme prices naturally correct through market forces
+            // Very low prices attract buyers (demand spike), very high prices attract sellers (supply spike)
+            // Only prevent numerical instability (not economic "reasonableness")
+            double price = region.prices[g];
+            if (price < 0.01) {
+                // Price floor only for numerical stability - near-free goods get hoarded
+                region.prices[g] = 0.01 + supply_demand_ratio * 0.05;
+            } else if (price > 100.0) {
+                // Ceiling only for numerical stability - hyperinflation triggers barter/alternatives
+                region.prices[g] = 100.0 * (1.0 - (price - 100.0) / price * 0.1);
+            }
+        }
+        
+        // WELFARE: weighted average consumption per capita (essentials weighted more heavily)
         double essential_consumption = 
             region.consumption[FOOD] * 2.0 +
             region.consumption[ENERGY] * 1.5 +
@@ -210,6 +378,29 @@ void Economy::computeWelfare() {
         double weight_sum = 2.0 + 1.5 + 1.0 + 1.2 + 0.5;  // 6.2
         
         region.welfare = (total_weighted / weight_sum) / region.population;
+        
+        // HARDSHIP: fraction of basic needs unmet (using consumption, not production)
+        double food_per_capita = region.consumption[FOOD] / region.population;
+        double energy_per_capita = region.consumption[ENERGY] / region.population;
+        double tools_per_capita = region.consumption[TOOLS] / region.population;
+        double services_per_capita = region.consumption[SERVICES] / region.population;
+        
+        double food_deficit = std::max(0.0, needs[FOOD] - food_per_capita) / needs[FOOD];
+        double energy_deficit = std::max(0.0, needs[ENERGY] - energy_per_capita) / needs[ENERGY];
+        double tools_deficit = std::max(0.0, needs[TOOLS] - tools_per_capita) / std::max(0.01, needs[TOOLS]);
+        double services_deficit = std::max(0.0, needs[SERVICES] - services_per_capita) / std::max(0.01, needs[SERVICES]);
+        
+        // EMERGENT WEIGHTS: Priorities vary by development level
+        // Undeveloped regions: food is critical (survival focus)
+        // Developed regions: services/tools matter more (quality of life focus)
+        double food_weight = 0.5 - region.development * 0.15;      // 0.50 → 0.35
+        double energy_weight = 0.3 - region.development * 0.05;    // 0.30 → 0.25  
+        double tools_weight = 0.1 + region.development * 0.10;     // 0.10 → 0.20
+        double services_weight = 0.1 + region.development * 0.10;  // 0.10 → 0.20
+        
+        region.hardship = (food_deficit * food_weight + energy_deficit * energy_weight + 
+                          tools_deficit * tools_weight + services_deficit * services_weight);
+        region.hardship = std::max(0.0, std::min(1.0, region.hardship));
     }
 }
 
@@ -264,42 +455,6 @@ void Economy::computeInequality(const std::vector<Agent>& agents,
     }
 }
 
-void Economy::computeHardship() {
-    for (auto& region : regions_) {
-        if (region.population == 0) {
-            region.hardship = 0.0;
-            continue;
-        }
-        
-        // Hardship = fraction of basic needs unmet (using consumption, not production)
-        double food_per_capita = region.consumption[FOOD] / region.population;
-        double energy_per_capita = region.consumption[ENERGY] / region.population;
-        double tools_per_capita = region.consumption[TOOLS] / region.population;
-        double services_per_capita = region.consumption[SERVICES] / region.population;
-        
-        // EMERGENT NEEDS: Regional subsistence varies by geography and development
-        double pop_density = region.population / 500.0;  // normalized density
-        RegionalNeeds needs = computeRegionalNeeds(region.x, region.y, region.development, pop_density);
-        
-        double food_deficit = std::max(0.0, needs.food - food_per_capita) / needs.food;
-        double energy_deficit = std::max(0.0, needs.energy - energy_per_capita) / needs.energy;
-        double tools_deficit = std::max(0.0, needs.tools - tools_per_capita) / std::max(0.01, needs.tools);
-        double services_deficit = std::max(0.0, needs.services - services_per_capita) / std::max(0.01, needs.services);
-        
-        // EMERGENT WEIGHTS: Priorities vary by development level
-        // Undeveloped regions: food is critical (survival focus)
-        // Developed regions: services/tools matter more (quality of life focus)
-        double food_weight = 0.5 - region.development * 0.15;      // 0.50 → 0.35
-        double energy_weight = 0.3 - region.development * 0.05;    // 0.30 → 0.25  
-        double tools_weight = 0.1 + region.development * 0.10;     // 0.10 → 0.20
-        double services_weight = 0.1 + region.development * 0.10;  // 0.10 → 0.20
-        
-        region.hardship = (food_deficit * food_weight + energy_deficit * energy_weight + 
-                          tools_deficit * tools_weight + services_deficit * services_weight);
-        region.hardship = std::max(0.0, std::min(1.0, region.hardship));
-    }
-}
-
 void Economy::initializeEndowments(std::mt19937_64& rng) {
     // Create DRAMATIC geographic variation - regions are SPECIALIZED, not self-sufficient
     // This creates scarcity, trade necessity, and economic interdependence
@@ -377,41 +532,57 @@ void Economy::initializeEndowments(std::mt19937_64& rng) {
 void Economy::initializeTradeNetwork() {
     // EMERGENT TRADE NETWORK: Partner count varies by geographic position and development
     // Coastal/central regions naturally have more partners than isolated ones
-    std::vector<std::vector<std::uint32_t>> trade_partners(regions_.size());
+    const std::size_t num_regions = regions_.size();
+    std::vector<std::vector<std::uint32_t>> trade_partners(num_regions);
     
     // Grid dimensions for geographic distance
-    int grid_size = static_cast<int>(std::ceil(std::sqrt(regions_.size())));
+    int grid_size = static_cast<int>(std::ceil(std::sqrt(num_regions)));
+    
+    // Spatial index over conceptual grid positions (col, row). Resource-rich
+    // regions are "closer" (simulates terrain/historical routes), so each
+    // candidate's distance is scaled by a per-region weight; the index prunes
+    // exactly using the smallest weight.
+    std::vector<SpatialGridIndex::Point> grid_positions(num_regions);
+    std::vector<double> closeness(num_regions);
+    double min_closeness = 1.0;
+    for (std::size_t j = 0; j < num_regions; ++j) {
+        grid_positions[j] = {static_cast<double>(static_cast<int>(j) % grid_size),
+                             static_cast<double>(static_cast<int>(j) / grid_size)};
+        closeness[j] = 0.8 + regions_[j].endowments[0] * 0.4;
+        min_closeness = (j == 0) ? closeness[j] : std::min(min_closeness, closeness[j]);
+    }
+    // ~4 regions per bucket keeps rings small without scanning empty cells
+    region_grid_index_.build(grid_positions, 2.0);
     
-    for (std::size_t i = 0; i < regions_.size(); ++i) {
-        regions_[i].trade_partners.clear();
-        
-        // Position in conceptual grid
-        int row_i = static_cast<int>(i) / grid_size;
-        int col_i = static_cast<int>(i) % grid_size;
-        double centrality = 1.0 - (std::abs(row_i - grid_size/2.0) + std::abs(col_i - grid_size/2.0)) / grid_size;
-        
-        // Central regions have more trade connections (2-15 based on position)
-        int base_partners = 2 + static_cast<int>(centrality * 8);
-        int partner_variance = static_cast<int>(regions_[i].development * 5); // developed regions trade more
-        int max_partners = std::min(base_partners + partner_variance, static_cast<int>(regions_.size()) - 1);
-        
-        // Find partners by geographic proximity (not fixed offset)
-        std::vector<std::pair<double, std::uint32_t>> distance_to_region;
-        for (std::size_t j = 0; j < regions_.size(); ++j) {
-            if (i == j) continue;
-            int row_j = static_cast<int>(j) / grid_size;
-            int col_j = static_cast<int>(j) % grid_size;
-            double dist = std::sqrt((row_i - row_j) * (row_i - row_j) + (col_i - col_j) * (col_i - col_j));
-            // Add some randomness to distance (simulates terrain/historical routes)
-            dist *= (0.8 + regions_[j].endowments[0] * 0.4); // resource-rich regions are "closer"
-            distance_to_region.push_back({dist, static_cast<std::uint32_t>(j)});
-        }
+    const std::int64_t n = static_cast<std::int64_t>(num_regions);
+    #pragma omp parallel
+    {
+        std::vector<SpatialGridIndex::Neighbor> nearest;
         
-        // Sort by effective distance and take nearest partners
-        std::sort(distance_to_region.begin(), distance_to_region.end());
-        for (int k = 0; k < max_partners && k < static_cast<int>(distance_to_region.size()); ++k) {
-            regions_[i].trade_partners.push_back(distance_to_region[k].second);
-            trade_partners[i].push_back(distance_to_region[k].second);
+        #pragma omp for schedule(dynamic, 64)
+        for (std::int64_t ii = 0; ii < n; ++ii) {
+            const std::size_t i = static_cast<std::size_t>(ii);
+            regions_[i].trade_partners.clear();
+            
+            // Position in conceptual grid
+            int row_i = static_cast<int>(i) / grid_size;
+            int col_i = static_cast<int>(i) % grid_size;
+            double centrality = 1.0 - (std::abs(row_i - grid_size/2.0) + std::abs(col_i - grid_size/2.0)) / grid_size;
+            
+            // Central regions have more trade connections (2-15 based on position)
+            int base_partners = 2 + static_cast<int>(centrality * 8);
+            int partner_variance = static_cast<int>(regions_[i].development * 5); // developed regions trade more
+            int max_partners = std::min(base_partners + partner_variance, static_cast<int>(num_regions) - 1);
+            if (max_partners <= 0) continue;
+            
+            // Nearest partners by effective distance (ties broken by region id)
+            region_grid_index_.kNearest(grid_positions[i], static_cast<std::size_t>(max_partners),
+                                        &closeness, min_closeness,
+                                        static_cast<std::uint32_t>(i), nearest);
+            for (const auto& [dist, j] : nearest) {
+                regions_[i].trade_partners.push_back(j);
+                trade_partners[i].push_back(j);
+            }
         }
     }
     
@@ -475,13 +646,6 @@ void Economy::evolveSpecialization() {
 void Economy::computeTrade() {
     trade_links_.clear();
     
-    // Reset trade balances
-    for (auto& region : regions_) {
-        for (int g = 0; g < kGoodTypes; ++g) {
-            region.trade_balance[g] = 0.0;
-        }
-    }
-    
     if (!trade_network_) {
         // Trade network should always be initialized - this indicates a bug
         static bool warned = false;
@@ -489,92 +653,23 @@ void Economy::computeTrade() {
             std::cerr << "WARNING: Trade network not initialized, skipping trade computation\n";
             warned = true;
         }
+        for (auto& region : regions_) {
+            region.trade_balance.fill(0.0);
+        }
         return;
     }
     
-    // Build production and demand vectors
-    std::vector<std::array<double, kGoodTypes>> production(regions_.size());
-    std::vector<std::array<double, kGoodTypes>> demand(regions_.size());
-    std::vector<std::uint32_t> population(regions_.size());
-    
-    for (std::size_t i = 0; i < regions_.size(); ++i) {
-        production[i] = regions_[i].production;
-        population[i] = regions_[i].population;
-        
-        // EMERGENT DEMAND: Compute regional needs based on geography and development
-        if (population[i] > 0) {
-            double pop_density = population[i] / 500.0;
-            RegionalNeeds needs = computeRegionalNeeds(regions_[i].x, regions_[i].y, 
-                                                        regions_[i].development, pop_density);
-            demand[i][FOOD] = population[i] * (needs.food + regions_[i].welfare * 0.2);
-            demand[i][ENERGY] = population[i] * (needs.energy + regions_[i].welfare * 0.3);
-            demand[i][TOOLS] = population[i] * (needs.tools + regions_[i].welfare * 0.2);
-            demand[i][LUXURY] = population[i] * (needs.luxury + regions_[i].welfare * 0.5);
-            demand[i][SERVICES] = population[i] * (needs.services + regions_[i].welfare * 0.4);
-        } else {
-            demand[i].fill(0.0);
-        }
+    // Diffuse the surplus block built by computeSupply() (single sparse traversal),
+    // or solve for the settled trade pattern when equilibrium mode is on
+    if (trade_solver_config_.equilibrium) {
+        trade_network_->computeEquilibriumFlows(trade_surplus_, trade_flows_);
+    } else {
+        trade_network_->computeFlows(trade_surplus_, trade_flows_, 0.15);
     }
     
-    // Compute flows via matrix diffusion (single operation replaces all loops)
-    auto trade_balances = trade_network_->computeFlows(production, demand, population, 0.15);
-    
     // Apply trade balances to regions
     for (std::size_t i = 0; i < regions_.size(); ++i) {
-        regions_[i].trade_balance = trade_balances[i];
-    }
-}
-
-void Economy::computeConsumption() {
-    for (auto& region : regions_) {
-        for (int g = 0; g < kGoodTypes; ++g) {
-            // Consumption = local production + net imports
-            region.consumption[g] = region.production[g] + region.trade_balance[g];
-            region.consumption[g] = std::max(0.0, region.consumption[g]);
-        }
-    }
-}
-
-void Economy::updatePrices() {
-    // Adjust prices based on supply/demand balance
-    for (auto& region : regions_) {
-        if (region.population == 0) continue;
-        
-        // Get regional needs for price calculation
-        double pop_density = region.population / 500.0;
-        RegionalNeeds needs = computeRegionalNeeds(region.x, region.y, region.development, pop_density);
-        
-        for (int g = 0; g < kGoodTypes; ++g) {
-            double supply = region.production[g];
-            double subsistence = (g == FOOD) ? needs.food : 
-                               (g == ENERGY) ? needs.energy :
-                               (g == TOOLS) ? needs.tools :
-                               (g == SERVICES) ? needs.services : needs.luxury;
-            double demand = region.population * (subsistence + region.welfare * 0.5);  // demand increases with welfare
-            
-            double supply_demand_ratio = (demand > 0) ? (supply / demand) : 1.0;
-            
-            // Price adjusts: high demand → higher price, high supply → lower price
-            if (supply_demand_ratio < 0.8) {
-                // Shortage → price increases
-                region.prices[g] *= (1.0 + PRICE_ADJUSTMENT_RATE);
-            } else if (supply_demand_ratio > 1.2) {
-                // Surplus → price decreases
-                region.prices[g] *= (1.0 - PRICE_ADJUSTMENT_RATE * 0.5);
-            }
-            
-            // EMERGENT PRICE BOUNDS: Extreme prices naturally correct through market forces
-            // Very low prices attract buyers (demand spike), very high prices attract sellers (supply spike)
-            // Only prevent numerical instability (not economic "reasonableness")
-            double price = region.prices[g];
-            if (price < 0.01) {
-                // Price floor only for numerical stability - near-free goods get hoarded
-                region.prices[g] = 0.01 + supply_demand_ratio * 0.05;
-            } else if (price > 100.0) {
-                // Ceiling only for numerical stability - hyperinflation triggers barter/alternatives
-                region.prices[g] = 100.0 * (1.0 - (price - 100.0) / price * 0.1);
-            }
-        }
+        regions_[i].trade_balance = trade_flows_[i];
     }
 }
 
@@ -864,66 +959,23 @@ void Economy::evolveDevelopment() {
     }
 }
 
-RegionalBeliefProfile Economy::analyzeRegionalBeliefs(
-    uint32_t region_id,
-    const std::vector<Agent>& agents,
-    const std::vector<std::vector<std::uint32_t>>& region_index) const {
-    
+RegionalBeliefProfile RegionalBeliefMoments::profile() const {
     RegionalBeliefProfile profile;
-    
-    const auto& agent_indices = region_index[region_id];
-    if (agent_indices.empty()) {
-        return profile;  // Return zero-initialized profile
-    }
-    
-    // Pass 1: Compute means
-    for (std::uint32_t idx : agent_indices) {
-        const auto& agent = agents[idx];
-        for (int d = 0; d < 4; ++d) {
-            profile.mean[d] += agent.B[d];
-        }
-    }
-    double n = static_cast<double>(agent_indices.size());
-    for (int d = 0; d < 4; ++d) {
-        profile.mean[d] /= n;
+    profile.population = population;
+    if (population == 0) {
+        return profile;  // Zero-initialized profile
     }
     
-    // Pass 2: Compute variance and track positive/negative faction sizes
-    std::array<double, 4> sum_sq{0,0,0,0};
-    std::array<int, 4> pos_count{0,0,0,0};
-    std::array<int, 4> neg_count{0,0,0,0};
-    std::array<double, 4> pos_sum{0,0,0,0};
-    std::array<double, 4> neg_sum{0,0,0,0};
-    
-    for (std::uint32_t idx : agent_indices) {
-        const auto& agent = agents[idx];
-        for (int d = 0; d < 4; ++d) {
-            double diff = agent.B[d] - profile.mean[d];
-            sum_sq[d] += diff * diff;
-            
-            // Track positive and negative believers separately
-            if (agent.B[d] > 0.1) {
-                pos_count[d]++;
-                pos_sum[d] += agent.B[d];
-            } else if (agent.B[d] < -0.1) {
-                neg_count[d]++;
-                neg_sum[d] += agent.B[d];
-            }
-        }
-    }
-    
-    // Compute variance and dominant pole for each dimension
-    for (int d = 0; d < 4; ++d) {
-        profile.variance[d] = sum_sq[d] / n;
+    const double n = static_cast<double>(population);
+    for (int d = 0; d < kBeliefDims; ++d) {
+        profile.mean[d] = belief_sum[d] / n;
+        // E[B²] - E[B]²; beliefs are bounded in [-1, 1] so cancellation is bounded too
+        profile.variance[d] = std::max(0.0, belief_sumsq[d] / n - profile.mean[d] * profile.mean[d]);
         
         // Determine dominant pole: which faction is larger and more intense?
-        // Use faction size weighted by average intensity
-        double pos_weight = (pos_count[d] > 0) 
-            ? pos_count[d] * (pos_sum[d] / pos_count[d])  // count * avg intensity
-            : 0.0;
-        double neg_weight = (neg_count[d] > 0)
-            ? neg_count[d] * std::abs(neg_sum[d] / neg_count[d])  // count * avg |intensity|
-            : 0.0;
+        // Faction size weighted by average intensity = |faction sum|
+        double pos_weight = (pos_count[d] > 0) ? pos_sum[d] : 0.0;
+        double neg_weight = (neg_count[d] > 0) ? std::abs(neg_sum[d]) : 0.0;
         
         // Dominant pole is the direction of the stronger faction
         if (pos_weight > neg_weight * 1.2) {
@@ -939,130 +991,154 @@ RegionalBeliefProfile Economy::analyzeRegionalBeliefs(
     }
     
     // Overall polarization is average variance across dimensions
-    profile.polarization = (profile.variance[0] + profile.variance[1] + 
-                           profile.variance[2] + profile.variance[3]) / 4.0;
+    double variance_sum = 0.0;
+    for (int d = 0; d < kBeliefDims; ++d) {
+        variance_sum += profile.variance[d];
+    }
+    profile.polarization = variance_sum / kBeliefDims;
     
     return profile;
 }
 
-void Economy::evolveEconomicSystems(const std::vector<std::array<double, 4>>& region_belief_centroids) {
-    if (forced_model_ != "") {
-        // Global policy override
-        for (auto& region : regions_) {
-            region.economic_system = forced_model_;
-            region.system_stability = 0.5;  // forced systems less stable
-        }
-        return;
+RegionalBeliefProfile Economy::analyzeRegionalBeliefs(
+    uint32_t region_id,
+    const std::vector<Agent>& agents,
+    const std::vector<std::vector<std::uint32_t>>& region_index) const {
+    
+    // Single pass: accumulate the same sums the kernel maintains incrementally
+    RegionalBeliefMoments moments;
+    for (std::uint32_t idx : region_index[region_id]) {
+        const auto& agent = agents[idx];
+        if (!agent.alive) continue;
+        moments.add(agent.B);
     }
+    return moments.profile();
+}
+
+bool Economy::applyForcedModel() {
+    if (forced_model_ == EconomicSystem::None) return false;
     
-    // Economic systems emerge from beliefs + material conditions
-    for (std::size_t i = 0; i < regions_.size(); ++i) {
-        auto& region = regions_[i];
-        const auto& beliefs = region_belief_centroids[i];
-        
-        // INCREMENT YEARS IN CURRENT SYSTEM (path dependence tracking)
-        region.years_in_current_system++;
-        
-        // INSTITUTIONAL INERTIA: Increases over time (path dependence)
-        // Long-established systems become harder to change
-        double time_lock = std::min(0.3, region.years_in_current_system * 0.005);  // Cap at 30% from time
-        region.institutional_inertia = std::min(0.9, 
-            region.institutional_inertia * 0.99 + time_lock);
-        
-        std::string ideal_system = determineEconomicSystem(beliefs, region.development, 
-                                                           region.hardship, region.inequality);
-        
-        // EMERGENT SYSTEM TRANSITION WITH HYSTERESIS AND PATH DEPENDENCE
-        // Systems require sustained pressure over multiple ticks to change
-        // This prevents thrashing between systems in crisis regions
-        if (region.economic_system != ideal_system) {
-            // Check if we're continuing pressure toward the same target
-            if (region.pending_system == ideal_system) {
-                // Same pressure direction - accumulate
-                double hardship_pressure = std::max(0.0, (region.hardship - 0.3) * 0.5);
-                double prosperity_pressure = std::max(0.0, (region.welfare - 0.8) * 0.3);
-                double instability_pressure = (1.0 - region.system_stability) * 0.2;
-                double inequality_pressure = std::max(0.0, (region.inequality - 0.4) * 0.3);
-                double total_pressure = hardship_pressure + prosperity_pressure + instability_pressure + inequality_pressure;
-                
-                // APPLY INSTITUTIONAL INERTIA: Established systems resist change
-                double inertia_factor = 1.0 - region.institutional_inertia;
-                double adjusted_pressure = total_pressure * inertia_factor;
-                
-                // Pressure threshold determines how fast we accumulate transition ticks
-                int pressure_increment = (adjusted_pressure > 0.5) ? 2 : 
-                                        (adjusted_pressure > 0.2) ? 1 : 0;
-                region.transition_pressure_ticks += pressure_increment;
-                
-                // Stability degrades during transition pressure
-                region.system_stability = std::max(0.2, region.system_stability - 0.01 * adjusted_pressure);
-                
-                // DYNAMIC TRANSITION THRESHOLD: Entrenched systems need more sustained pressure
-                int required_ticks = static_cast<int>(
-                    RegionalEconomy::TRANSITION_THRESHOLD + region.years_in_current_system * 0.5
-                );
-                required_ticks = std::min(required_ticks, 200);  // Cap at 200 ticks (~20 years)
-                
-                // Check if we've reached the threshold for transition
-                if (region.transition_pressure_ticks >= required_ticks) {
-                    // Transition happens! This is a major disruption
-                    region.economic_system = ideal_system;
-                    region.pending_system = "";
-                    region.transition_pressure_ticks = 0;
-                    region.years_in_current_system = 0;  // Reset: new system
-                    region.institutional_inertia *= 0.5;  // Disruption reduces inertia
-                    region.system_stability = 0.3;  // New systems start unstable
-                    
-                    // Log the system change (if event logging available)
-                    // event_log_.logSystemChange(generation, i, old_system, ideal_system);
-                }
-            } else {
-                // Different pressure direction - reset and start new accumulation
-                // But pressure relief is slowed by inertia (system resists even oscillation)
-                region.pending_system = ideal_system;
-                region.transition_pressure_ticks = static_cast<int>(
-                    region.transition_pressure_ticks * (0.9 + region.institutional_inertia * 0.08)
-                );
-                if (region.transition_pressure_ticks < 1) {
-                    region.transition_pressure_ticks = 1;
-                }
+    // Global policy override
+    for (auto& region : regions_) {
+        region.economic_system = forced_model_;
+        region.system_stability = 0.5;  // forced systems less stable
+    }
+    return true;
+}
+
+void Economy::advanceSystemTransition(RegionalEconomy& region, EconomicSystem ideal_system) const {
+    // INCREMENT YEARS IN CURRENT SYSTEM (path dependence tracking)
+    region.years_in_current_system++;
+    
+    // INSTITUTIONAL INERTIA: Increases over time (path dependence)
+    // Long-established systems become harder to change
+    double time_lock = std::min(0.3, region.years_in_current_system * 0.005);  // Cap at 30% from time
+    region.institutional_inertia = std::min(0.9, 
+        region.institutional_inertia * 0.99 + time_lock);
+    
+    // EMERGENT SYSTEM TRANSITION WITH HYSTERESIS AND PATH DEPENDENCE
+    // Systems require sustained pressure over multiple ticks to change
+    // This prevents thrashing between systems in crisis regions
+    if (region.economic_system != ideal_system) {
+        // Check if we're continuing pressure toward the same target
+        if (region.pending_system == ideal_system) {
+            // Same pressure direction - accumulate
+            double hardship_pressure = std::max(0.0, (region.hardship - 0.3) * 0.5);
+            double prosperity_pressure = std::max(0.0, (region.welfare - 0.8) * 0.3);
+            double instability_pressure = (1.0 - region.system_stability) * 0.2;
+            double inequality_pressure = std::max(0.0, (region.inequality - 0.4) * 0.3);
+            double total_pressure = hardship_pressure + prosperity_pressure + instability_pressure + inequality_pressure;
+            
+            // APPLY INSTITUTIONAL INERTIA: Established systems resist change
+            double inertia_factor = 1.0 - region.institutional_inertia;
+            double adjusted_pressure = total_pressure * inertia_factor;
+            
+            // Pressure threshold determines how fast we accumulate transition ticks
+            int pressure_increment = (adjusted_pressure > 0.5) ? 2 : 
+                                    (adjusted_pressure > 0.2) ? 1 : 0;
+            region.transition_pressure_ticks += pressure_increment;
+            
+            // Stability degrades during transition pressure
+            region.system_stability = std::max(0.2, region.system_stability - 0.01 * adjusted_pressure);
+            
+            // DYNAMIC TRANSITION THRESHOLD: Entrenched systems need more sustained pressure
+            int required_ticks = static_cast<int>(
+                RegionalEconomy::TRANSITION_THRESHOLD + region.years_in_current_system * 0.5
+            );
+            required_ticks = std::min(required_ticks, 200);  // Cap at 200 ticks (~20 years)
+            
+            // Check if we've reached the threshold for transition
+            if (region.transition_pressure_ticks >= required_ticks) {
+                // Transition happens! This is a major disruption
+                region.economic_system = ideal_system;
+                region.pending_system = EconomicSystem::None;
+                region.transition_pressure_ticks = 0;
+                region.years_in_current_system = 0;  // Reset: new system
+                region.institutional_inertia *= 0.5;  // Disruption reduces inertia
+                region.system_stability = 0.3;  // New systems start unstable
             }
         } else {
-            // System matches ideal - no pressure, recover stability
-            region.pending_system = "";
-            // Pressure decay is also affected by inertia (stable systems shed pressure slowly)
+            // Different pressure direction - reset and start new accumulation
+            // But pressure relief is slowed by inertia (system resists even oscillation)
+            region.pending_system = ideal_system;
             region.transition_pressure_ticks = static_cast<int>(
-                region.transition_pressure_ticks * (0.8 + region.institutional_inertia * 0.15)
+                region.transition_pressure_ticks * (0.9 + region.institutional_inertia * 0.08)
             );
-            region.system_stability = std::min(1.0, region.system_stability + 0.02);
-        }
-        
-        // EMERGENT EFFICIENCY: Based on actual production performance, not system labels
-        // Efficiency emerges from: stability, development, and production/consumption ratio
-        double production_total = 0.0;
-        double consumption_total = 0.0;
-        for (int g = 0; g < kGoodTypes; ++g) {
-            production_total += region.production[g];
-            consumption_total += region.consumption[g];
+            if (region.transition_pressure_ticks < 1) {
+                region.transition_pressure_ticks = 1;
+            }
         }
-        
-        // Base efficiency from how well production meets consumption needs
-        double production_efficiency = (consumption_total > 0) 
-            ? std::min(1.0, production_total / (consumption_total + 1.0))
-            : 0.5;
-        
-        // Stability and development contribute to efficiency
-        double stability_bonus = region.system_stability * 0.2;
-        double development_bonus = std::min(0.2, region.development * 0.04);
-        
-        // Emergent efficiency: base + stability + development
-        region.efficiency = std::clamp(
-            0.5 + production_efficiency * 0.3 + stability_bonus + development_bonus,
-            0.3, 1.0
+    } else {
+        // System matches ideal - no pressure, recover stability
+        region.pending_system = EconomicSystem::None;
+        // Pressure decay is also affected by inertia (stable systems shed pressure slowly)
+        region.transition_pressure_ticks = static_cast<int>(
+            region.transition_pressure_ticks * (0.8 + region.institutional_inertia * 0.15)
         );
-        
-        // NOTE: Inequality is computed separately in computeInequality() from actual agent wealth
-        // No hardcoded inequality values here - it's fully emergent!
+        region.system_stability = std::min(1.0, region.system_stability + 0.02);
+    }
+    
+    // EMERGENT EFFICIENCY: Based on actual production performance, not system labels
+    // Efficiency emerges from: stability, development, and production/consumption ratio
+    double production_total = 0.0;
+    double consumption_total = 0.0;
+    for (int g = 0; g < kGoodTypes; ++g) {
+        production_total += region.production[g];
+        consumption_total += region.consumption[g];
+    }
+    
+    // Base efficiency from how well production meets consumption needs
+    double production_efficiency = (consumption_total > 0) 
+        ? std::min(1.0, production_total / (consumption_total + 1.0))
+        : 0.5;
+    
+    // Stability and development contribute to efficiency
+    double stability_bonus = region.system_stability * 0.2;
+    double development_bonus = std::min(0.2, region.development * 0.04);
+    
+    // Emergent efficiency: base + stability + development
+    region.efficiency = std::clamp(
+        0.5 + production_efficiency * 0.3 + stability_bonus + development_bonus,
+        0.3, 1.0
+    );
+    
+    // NOTE: Inequality is computed separately in computeInequality() from actual agent wealth
+    // No hardcoded inequality values here - it's fully emergent!
+}
+
+void Economy::evolveEconomicSystems(const std::vector<BeliefVec>& region_belief_centroids) {
+    if (applyForcedModel()) return;
+    
+    // Economic systems emerge from beliefs + material conditions.
+    // Regions are independent: each thread owns its regions outright.
+    const std::int64_t n = static_cast<std::int64_t>(regions_.size());
+    #pragma omp parallel for schedule(static)
+    for (std::int64_t ii = 0; ii < n; ++ii) {
+        auto& region = regions_[static_cast<std::size_t>(ii)];
+        EconomicSystem ideal_system = determineEconomicSystem(
+            region_belief_centroids[static_cast<std::size_t>(ii)],
+            region.development, region.hardship, region.inequality);
+        advanceSystemTransition(region, ideal_system);
     }
 }
 
@@ -1070,103 +1146,39 @@ void Economy::evolveEconomicSystems(
     const std::vector<Agent>& agents,
     const std::vector<std::vector<std::uint32_t>>& region_index) {
     
-    if (forced_model_ != "") {
-        // Global policy override
-        for (auto& region : regions_) {
-            region.economic_system = forced_model_;
-            region.system_stability = 0.5;  // forced systems less stable
-        }
-        return;
-    }
+    if (applyForcedModel()) return;
     
     // Economic systems emerge from beliefs + material conditions
-    // Now using DOMINANT POLE analysis for differentiated outcomes
-    for (std::size_t i = 0; i < regions_.size(); ++i) {
+    // Now using DOMINANT POLE analysis for differentiated outcomes.
+    // Profile cost scales with regional population, so schedule dynamically.
+    const std::int64_t n = static_cast<std::int64_t>(regions_.size());
+    #pragma omp parallel for schedule(dynamic, 8)
+    for (std::int64_t ii = 0; ii < n; ++ii) {
+        const auto i = static_cast<std::uint32_t>(ii);
         auto& region = regions_[i];
         
         // Analyze regional beliefs with dominant pole detection
-        RegionalBeliefProfile profile = analyzeRegionalBeliefs(
-            static_cast<uint32_t>(i), agents, region_index);
-        
-        // INCREMENT YEARS IN CURRENT SYSTEM (path dependence tracking)
-        region.years_in_current_system++;
-        
-        // INSTITUTIONAL INERTIA: Increases over time (path dependence)
-        double time_lock = std::min(0.3, region.years_in_current_system * 0.005);
-        region.institutional_inertia = std::min(0.9, 
-            region.institutional_inertia * 0.99 + time_lock);
+        RegionalBeliefProfile profile = analyzeRegionalBeliefs(i, agents, region_index);
         
         // Use dominant pole for system determination - NOT mean!
-        std::string ideal_system = determineEconomicSystem(profile, region.development, 
-                                                           region.hardship, region.inequality);
-        
-        // EMERGENT SYSTEM TRANSITION WITH HYSTERESIS AND PATH DEPENDENCE
-        if (region.economic_system != ideal_system) {
-            if (region.pending_system == ideal_system) {
-                double hardship_pressure = std::max(0.0, (region.hardship - 0.3) * 0.5);
-                double prosperity_pressure = std::max(0.0, (region.welfare - 0.8) * 0.3);
-                double instability_pressure = (1.0 - region.system_stability) * 0.2;
-                double inequality_pressure = std::max(0.0, (region.inequality - 0.4) * 0.3);
-                double total_pressure = hardship_pressure + prosperity_pressure + instability_pressure + inequality_pressure;
-                
-                double inertia_factor = 1.0 - region.institutional_inertia;
-                double adjusted_pressure = total_pressure * inertia_factor;
-                
-                int pressure_increment = (adjusted_pressure > 0.5) ? 2 : 
-                                        (adjusted_pressure > 0.2) ? 1 : 0;
-                region.transition_pressure_ticks += pressure_increment;
-                
-                region.system_stability = std::max(0.2, region.system_stability - 0.01 * adjusted_pressure);
-                
-                int required_ticks = static_cast<int>(
-                    RegionalEconomy::TRANSITION_THRESHOLD + region.years_in_current_system * 0.5
-                );
-                required_ticks = std::min(required_ticks, 200);
-                
-                if (region.transition_pressure_ticks >= required_ticks) {
-                    region.economic_system = ideal_system;
-                    region.pending_system = "";
-                    region.transition_pressure_ticks = 0;
-                    region.years_in_current_system = 0;
-                    region.institutional_inertia *= 0.5;
-                    region.system_stability = 0.3;
-                }
-            } else {
-                region.pending_system = ideal_system;
-                region.transition_pressure_ticks = static_cast<int>(
-                    region.transition_pressure_ticks * (0.9 + region.institutional_inertia * 0.08)
-                );
-                if (region.transition_pressure_ticks < 1) {
-                    region.transition_pressure_ticks = 1;
-                }
-            }
-        } else {
-            region.pending_system = "";
-            region.transition_pressure_ticks = static_cast<int>(
-                region.transition_pressure_ticks * (0.8 + region.institutional_inertia * 0.15)
-            );
-            region.system_stability = std::min(1.0, region.system_stability + 0.02);
-        }
-        
-        // EMERGENT EFFICIENCY
-        double production_total = 0.0;
-        double consumption_total = 0.0;
-        for (int g = 0; g < kGoodTypes; ++g) {
-            production_total += region.production[g];
-            consumption_total += region.consumption[g];
-        }
-        
-        double production_efficiency = (consumption_total > 0) 
-            ? std::min(1.0, production_total / (consumption_total + 1.0))
-            : 0.5;
-        
-        double stability_bonus = region.system_stability * 0.2;
-        double development_bonus = std::min(0.2, region.development * 0.04);
-        
-        region.efficiency = std::clamp(
-            0.5 + production_efficiency * 0.3 + stability_bonus + development_bonus,
-            0.3, 1.0
-        );
+        EconomicSystem ideal_system = determineEconomicSystem(profile, region.development, 
+                                                              region.hardship, region.inequality);
+        advanceSystemTransition(region, ideal_system);
+    }
+}
+
+void Economy::evolveEconomicSystems(const std::vector<RegionalBeliefProfile>& belief_profiles) {
+    if (applyForcedModel()) return;
+    
+    // Same dominant pole analysis, but profiles are maintained by the caller: O(R)
+    const std::int64_t n = static_cast<std::int64_t>(regions_.size());
+    #pragma omp parallel for schedule(static)
+    for (std::int64_t ii = 0; ii < n; ++ii) {
+        auto& region = regions_[static_cast<std::size_t>(ii)];
+        EconomicSystem ideal_system = determineEconomicSystem(
+            belief_profiles[static_cast<std::size_t>(ii)],
+            region.development, region.hardship, region.inequality);
+        advanceSystemTransition(region, ideal_system);
     }
 }
 
@@ -1189,7 +1201,7 @@ Economy::StartConditionProfile Economy::resolveStartCondition(const std::string&
                            const std::array<double, kGoodTypes>& multipliers,
                            double base_dev,
                            double jitter,
-                           std::string default_system,
+                           EconomicSystem default_system,
                            double wealth_mean,
                            double wealth_std,
                            double prod_mean,
@@ -1199,7 +1211,7 @@ Economy::StartConditionProfile Economy::resolveStartCondition(const std::string&
         profile.endowmentMultipliers = multipliers;
         profile.baseDevelopment = base_dev;
         profile.developmentJitter = jitter;
-        profile.defaultSystem = std::move(default_system);
+        profile.defaultSystem = default_system;
         profile.wealthLogMean = wealth_mean;
         profile.wealthLogStd = wealth_std;
         profile.productivityMean = prod_mean;
@@ -1214,7 +1226,7 @@ Economy::StartConditionProfile Economy::resolveStartCondition(const std::string&
                             {1.0, 1.0, 1.0, 0.85, 0.95},
                             0.8,
                             0.25,
-                            "mixed",
+                            EconomicSystem::Mixed,
                             0.1,
                             0.65,
                             1.0,
@@ -1226,7 +1238,7 @@ Economy::StartConditionProfile Economy::resolveStartCondition(const std::string&
                             {1.2, 1.1, 1.05, 1.35, 1.45},
                             2.4,
                             0.15,
-                            "cooperative",
+                            EconomicSystem::Cooperative,
                             0.3,
                             0.35,
                             1.2,
@@ -1238,7 +1250,7 @@ Economy::StartConditionProfile Economy::resolveStartCondition(const std::string&
                             {1.4, 0.6, 0.4, 0.2, 0.25},
                             0.35,
                             0.08,
-                            "feudal",
+                            EconomicSystem::Feudal,
                             -0.7,
                             1.05,
                             0.75,
@@ -1250,7 +1262,7 @@ Economy::StartConditionProfile Economy::resolveStartCondition(const std::string&
                             {0.9, 1.25, 1.35, 0.9, 0.95},
                             1.4,
                             0.30,
-                            "market",
+                            EconomicSystem::Market,
                             0.15,
                             0.55,
                             1.1,
@@ -1262,7 +1274,7 @@ Economy::StartConditionProfile Economy::resolveStartCondition(const std::string&
                             {0.65, 0.7, 0.75, 0.55, 0.6},
                             0.6,
                             0.2,
-                            "mixed",
+                            EconomicSystem::Mixed,
                             -0.2,
                             0.9,
                             0.9,
@@ -1275,142 +1287,34 @@ Economy::StartConditionProfile Economy::resolveStartCondition(const std::string&
                         {1.0, 1.0, 1.0, 0.85, 0.95},
                         0.8,
                         0.25,
-                        "mixed",
+                        EconomicSystem::Mixed,
                         0.1,
                         0.65,
                         1.0,
                         0.25);
 }
 
-std::string Economy::determineEconomicSystem(const std::array<double, 4>& beliefs,
-                                             double development,
-                                             double hardship,
-                                             double inequality) const {
+EconomicSystem Economy::determineEconomicSystem(const BeliefVec& beliefs,
+                                                double development,
+                                                double hardship,
+                                                double inequality) const {
     // Belief axes: [0]=Authority, [1]=Tradition, [2]=Hierarchy, [3]=Faith
     // Negative = (Liberty, Progress, Equality, Rationalism)
-    
-    double authority = beliefs[0];
-    double tradition = beliefs[1];
-    double hierarchy = beliefs[2];
-    
-    // Low development → feudal or cooperative (subsistence economies)
-    if (development < 0.6) {
-        if (hierarchy > 0.15 && authority > 0.1) {
-            return "feudal";  // traditional hierarchy
-        } else if (hierarchy < -0.1) {
-            return "cooperative";  // communal subsistence
-        }
-    }
-    
-    // Crisis conditions → revolutionary pressure
-    if (hardship > 0.4 && inequality > 0.5) {
-        if (hierarchy < -0.1) {  // egalitarian beliefs
-            return "planned";  // equality-seeking planned economy
-        } else if (authority > 0.1) {
-            return "feudal";  // strongman restoration
-        }
-    }
-    
-    // Developed + liberty + equality → cooperative/social democracy
-    if (development > 1.2 && authority < -0.15 && hierarchy < -0.15) {
-        return "cooperative";
-    }
-    
-    // Developed + liberty + accepts hierarchy → market capitalism
-    if (development > 0.8 && authority < -0.1 && hierarchy > 0.05) {
-        return "market";
-    }
-    
-    // Developed + authority + equality-leaning → planned economy
-    if (development > 0.8 && authority > 0.15 && hierarchy < 0.1) {
-        return "planned";
-    }
-    
-    // Traditional + hierarchical but developed → feudal remnants
-    if (tradition > 0.2 && hierarchy > 0.2 && development < 1.0) {
-        return "feudal";
-    }
-    
-    // Default: mixed economy (most common in moderate conditions)
-    return "mixed";
+    SystemSignals signals{development, hardship, inequality, 0.0,
+                          beliefs[0], beliefs[1], beliefs[2]};
+    return evaluateSystemRules(kMeanSystemRules, signals);
 }
 
-std::string Economy::determineEconomicSystem(const RegionalBeliefProfile& profile,
-                                             double development,
-                                             double hardship,
-                                             double inequality) const {
+EconomicSystem Economy::determineEconomicSystem(const RegionalBeliefProfile& profile,
+                                                double development,
+                                                double hardship,
+                                                double inequality) const {
     // NEW: Use DOMINANT POLE instead of mean for system determination
     // This prevents averaging cancellation where opposing factions neutralize each other
     // Instead, the dominant faction's beliefs drive system selection
-    
-    // Belief axes: [0]=Authority, [1]=Tradition, [2]=Hierarchy, [3]=Faith
-    // Negative = (Liberty, Progress, Equality, Rationalism)
-    
-    double authority = profile.dominant_pole[0];
-    double tradition = profile.dominant_pole[1];
-    double hierarchy = profile.dominant_pole[2];
-    
-    // ADJUSTED THRESHOLDS: Match actual simulation development range (0.5-1.0)
-    // Previously required development > 1.2 which was unrealistic
-    
-    // Low development → feudal or cooperative (subsistence economies)
-    if (development < 0.4) {
-        if (hierarchy > 0.1 && authority > 0.05) {
-            return "feudal";  // traditional hierarchy
-        } else if (hierarchy < -0.05) {
-            return "cooperative";  // communal subsistence
-        }
-    }
-    
-    // Crisis conditions → revolutionary pressure
-    if (hardship > 0.35 && inequality > 0.45) {
-        if (hierarchy < -0.05) {  // egalitarian beliefs
-            return "planned";  // equality-seeking planned economy
-        } else if (authority > 0.05) {
-            return "feudal";  // strongman restoration
-        }
-    }
-    
-    // Highly polarized regions → system determined by stronger faction
-    // This is where dominant pole really shines - contested areas have clear winners
-    if (profile.polarization > 0.05) {
-        // Polarized: use the dominant pole directly with LOWER thresholds
-        if (development > 0.8 && authority < -0.1 && hierarchy < -0.1) {
-            return "cooperative";
-        }
-        if (development > 0.5 && authority < -0.05 && hierarchy > 0.02) {
-            return "market";
-        }
-        if (development > 0.5 && authority > 0.1 && hierarchy < 0.05) {
-            return "planned";
-        }
-        if (hierarchy > 0.12 && authority > 0.08) {
-            return "feudal";
-        }
-    }
-    
-    // Developed + liberty + equality → cooperative/social democracy
-    if (development > 0.8 && authority < -0.1 && hierarchy < -0.1) {
-        return "cooperative";
-    }
-    
-    // Developed + liberty + accepts hierarchy → market capitalism  
-    if (development > 0.5 && authority < -0.05 && hierarchy > 0.02) {
-        return "market";
-    }
-    
-    // Developed + authority + equality-leaning → planned economy
-    if (development > 0.5 && authority > 0.1 && hierarchy < 0.05) {
-        return "planned";
-    }
-    
-    // Traditional + hierarchical → feudal remnants
-    if (tradition > 0.1 && hierarchy > 0.12 && development < 0.7) {
-        return "feudal";
-    }
-    
-    // Default: mixed economy (only for truly contested regions with no dominant pole)
-    return "mixed";
+    SystemSignals signals{development, hardship, inequality, profile.polarization,
+                          profile.dominant_pole[0], profile.dominant_pole[1], profile.dominant_pole[2]};
+    return evaluateSystemRules(kPoleSystemRules, signals);
 }
 
 
@@ -1603,13 +1507,33 @@ double Economy::getTotalTrade() const {
     return total / 2.0;  // Avoid double-counting
 }
 
+void Economy::configureTradeSolver(const TradeSolverConfig& config) {
+    trade_solver_config_ = config;
+    if (trade_network_) {
+        trade_network_->setSolverConfig(config);
+    }
+}
+
+const TradeSolveStats& Economy::tradeSolveStats() const {
+    static const TradeSolveStats kNoSolve{};
+    return trade_network_ ? trade_network_->lastSolveStats() : kNoSolve;
+}
+
 void Economy::setEconomicModel(const std::string& model) {
-    if (model == "market" || model == "planned" || model == "mixed" || 
-        model == "feudal" || model == "cooperative" || model == "") {
-        forced_model_ = model;
+    if (model.empty()) {
+        forced_model_ = EconomicSystem::None;
+        return;
+    }
+    EconomicSystem system;
+    if (parseEconomicSystem(model, system)) {
+        forced_model_ = system;
     }
 }
 
+void Economy::setEconomicModel(EconomicSystem model) {
+    forced_model_ = model;
+}
+
 void Economy::reallocateToWar(double fraction) {
     war_allocation_ = std::max(0.0, std::min(1.0, fraction));
 }
@@ -0,0 +1,87 @@
+#include "modules/EdgeReplicas.h"
+#include "kernel/Kernel.h"
+#include <algorithm>
+
+void EdgeReplicas::rebuild(const std::vector<Agent>& agents) {
+    const std::size_t n = agents.size();
+    offsets_.resize(n + 1);
+    offsets_[0] = 0;
+    for (std::size_t i = 0; i < n; ++i) offsets_[i + 1] = offsets_[i] + agents[i].neighbors.size();
+
+    cols_.resize(offsets_[n]);
+    const std::int64_t count = static_cast<std::int64_t>(n);
+    #pragma omp parallel for schedule(static)
+    for (std::int64_t ii = 0; ii < count; ++ii) {
+        const std::size_t i = static_cast<std::size_t>(ii);
+        std::uint32_t* out = cols_.data() + offsets_[i];
+        for (std::uint32_t j : agents[i].neighbors) *out++ = j < n ? j : static_cast<std::uint32_t>(n);
+    }
+    replicas_.resize(offsets_[n]);
+
+    // Reverse index: the edges reading each record, so changed records can be pushed
+    reader_offsets_.assign(n + 2, 0);
+    for (std::uint32_t j : cols_) ++reader_offsets_[j + 1];
+    for (std::size_t j = 0; j <= n; ++j) reader_offsets_[j + 1] += reader_offsets_[j];
+    readers_.resize(cols_.size());
+    std::vector<std::size_t> next(reader_offsets_.begin(), reader_offsets_.end() - 1);
+    for (std::size_t e = 0; e < cols_.size(); ++e) readers_[next[cols_[e]]++] = e;
+    stale_ = false;
+    ++rebuilds_;
+}
+
+void EdgeReplicas::refresh(const std::vector<Agent>& agents) {
+    const std::size_t n = agents.size();
+    // Births always come with markStale(); the size check covers a reset agent vector
+    const bool rebuilt = stale_ || offsets_.size() != n + 1;
+    if (rebuilt) rebuild(agents);
+
+    // Quantize each agent once, flagging records that changed since the last refresh
+    records_.resize(n + 1);
+    records_[n] = Replica{};
+    changed_.resize(n);
+    std::size_t changed = 0;
+    const std::int64_t count = static_cast<std::int64_t>(n);
+    #pragma omp parallel for schedule(static) reduction(+ : changed)
+    for (std::int64_t jj = 0; jj < count; ++jj) {
+        const std::size_t j = static_cast<std::size_t>(jj);
+        const Agent& agent = agents[j];
+        Replica record;
+        for (int d = 0; d < kBeliefDims; ++d) {
+            const double scaled = std::clamp<double>(agent.B[d], -1.0, 1.0) * kScale;
+            record.q[d] = static_cast<std::int16_t>(scaled + (scaled < 0.0 ? -0.5 : 0.5));  // Round half away
+        }
+        record.comm = static_cast<float>(agent.m_comm);
+        record.fluency = UnitQ16(static_cast<double>(agent.fluency)).raw();
+        record.lang = agent.alive ? static_cast<std::int16_t>(agent.primaryLang) : std::int16_t{-1};
+
+        Replica& old = records_[j];
+        const bool differs = record.q != old.q || record.comm != old.comm ||
+                             record.fluency != old.fluency || record.lang != old.lang;
+        if (differs) old = record;
+        changed_[j] = differs;
+        changed += differs;
+    }
+
+    const Replica* records = records_.data();
+    Replica* replicas = replicas_.data();
+    if (rebuilt || static_cast<double>(changed) > kGatherFraction * static_cast<double>(n)) {
+        // Most records moved: stream through all edges pulling each neighbor's record
+        const std::uint32_t* cols = cols_.data();
+        const std::int64_t edges = static_cast<std::int64_t>(replicas_.size());
+        #pragma omp parallel for schedule(static)
+        for (std::int64_t e = 0; e < edges; ++e) replicas[e] = records[cols[e]];
+        copied_ = replicas_.size();
+        return;
+    }
+
+    // Few records moved: push each one to the edges reading it (disjoint writes)
+    std::size_t copied = 0;
+    #pragma omp parallel for schedule(dynamic, 256) reduction(+ : copied)
+    for (std::int64_t jj = 0; jj < count; ++jj) {
+        const std::size_t j = static_cast<std::size_t>(jj);
+        if (!changed_[j]) continue;
+        for (std::size_t r = reader_offsets_[j]; r < reader_offsets_[j + 1]; ++r) replicas[readers_[r]] = records[j];
+        copied += reader_offsets_[j + 1] - reader_offsets_[j];
+    }
+    copied_ = copied;
+}
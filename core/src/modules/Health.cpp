@@ -1,14 +1,30 @@
 #include "modules/Health.h"
 
 #include <algorithm>
+#include <cmath>
 #include <random>
 
 #include "kernel/Kernel.h"
 #include "modules/Economy.h"
+#include "utils/CounterRng.h"
+
+namespace {
+// Counter-RNG streams for the per-agent draws of one tick
+constexpr std::uint32_t kInfectionStream = 0;
+constexpr std::uint32_t kRecoveryStream = 1;
+constexpr std::uint32_t kTransmissionStream = 2;
+}
 
 void HealthModule::configure(std::uint32_t regionCount, std::uint64_t seed) {
     regional_snapshots_.assign(regionCount, {});
+    thread_sums_.clear();
     rng_.seed(seed);
+    seed_ = seed;
+    model_ = EpidemicModel::Regional;
+    exposed_.clear();
+    infectious_.clear();
+    waning_.clear();
+    stats_ = {};
 }
 
 void HealthModule::initializeAgents(std::vector<Agent>& agents) {
@@ -19,16 +35,30 @@ void HealthModule::initializeAgents(std::vector<Agent>& agents) {
         health.nutrition_level = clamp01(0.8 + noise(rng_));
         health.age_factor = clamp01(0.2 + 0.6 * noise(rng_));
         health.infected = false;
+        health.stage = InfectionStage::Susceptible;
+        health.stage_tick = 0;
         health.current_disease = nullptr;
         health.immunity = clamp01(0.1 + 0.2 * agent.sociality + noise(rng_));
     }
+    exposed_.clear();
+    infectious_.clear();
+    waning_.clear();
+    stats_ = {};
 }
 
-void HealthModule::updateAgents(std::vector<Agent>& agents, const Economy& economy, std::uint64_t /*tick*/) {
+void HealthModule::updateAgents(std::vector<Agent>& agents, const Economy& economy, std::uint64_t tick) {
     if (regional_snapshots_.empty()) {
         return;
     }
+    beginTick(economy, 1);
+    stepEpidemic(agents, tick);
+    for (auto& agent : agents) {
+        if (agent.alive) updateAgent(agent, tick, 0);
+    }
+    finishTick();
+}
 
+void HealthModule::beginTick(const Economy& economy, std::size_t threads) {
     const std::uint32_t regionCount = static_cast<std::uint32_t>(regional_snapshots_.size());
     for (std::uint32_t r = 0; r < regionCount; ++r) {
         const auto& reg = economy.getRegion(r);
@@ -64,49 +94,221 @@ void HealthModule::updateAgents(std::vector<Agent>& agents, const Economy& econo
         snapshot.avg_health = 0.0;
     }
 
-    if (agents.empty()) {
-        return;
+    thread_sums_.resize(std::max<std::size_t>(1, threads));
+    for (auto& sums : thread_sums_) {
+        sums.assign(regionCount, RegionSums{});
     }
+}
 
-    std::vector<std::uint32_t> regionCounts(regionCount, 0);
-    std::uniform_real_distribution<double> uni(0.0, 1.0);
-
-    for (auto& agent : agents) {
-        auto& health = agent.health;
-        auto& snapshot = regional_snapshots_[agent.region];
-        regionCounts[agent.region]++;
+void HealthModule::updateAgent(Agent& agent, std::uint64_t tick, std::size_t thread, double steps) {
+    auto& health = agent.health;
+    const auto& snapshot = regional_snapshots_[agent.region];
+    const bool single = (steps == 1.0);
 
+    const double ageDecay = computeAgeDecay(health.age_factor);
+    const double diseaseMortality = (health.infected && health.current_disease) ? health.current_disease->mortality : 0.0;
+    const double medicalIntervention = 0.02 + 0.1 * snapshot.healthcare;
+    if (single) {
         health.nutrition_level = 0.7 * health.nutrition_level + 0.3 * snapshot.nutrition;
-        const double ageDecay = computeAgeDecay(health.age_factor);
-        const double diseaseMortality = (health.infected && health.current_disease) ? health.current_disease->mortality : 0.0;
-        const double medicalIntervention = 0.02 + 0.1 * snapshot.healthcare;
         health.physical_health = clamp01(health.physical_health * health.nutrition_level * (1.0 - ageDecay - diseaseMortality) + medicalIntervention);
+    } else {
+        // Both are linear recurrences x' = a·x + b: jump `steps` ticks in closed form
+        const double keep = std::pow(0.7, steps);
+        health.nutrition_level = keep * health.nutrition_level + (1.0 - keep) * snapshot.nutrition;
+        const double a = health.nutrition_level * (1.0 - ageDecay - diseaseMortality);
+        const double an = std::pow(a, steps);
+        const double geometric = (std::abs(1.0 - a) > 1e-12) ? (1.0 - an) / (1.0 - a) : steps;
+        health.physical_health = clamp01(an * health.physical_health + medicalIntervention * geometric);
+    }
 
-        // Disease dynamics
+    // Disease dynamics (network mode advances stages in stepEpidemic instead)
+    if (model_ == EpidemicModel::Regional) {
         if (!health.infected) {
-            const double infectionProb = snapshot.infection_pressure * (1.0 - health.physical_health) * (1.0 - health.immunity);
-            if (uni(rng_) < infectionProb) {
+            double infectionProb = snapshot.infection_pressure * (1.0 - health.physical_health) * (1.0 - health.immunity);
+            if (!single) infectionProb = 1.0 - std::pow(1.0 - infectionProb, steps);
+            if (CounterRng::uniform(seed_, tick, agent.id, kInfectionStream) < infectionProb) {
                 health.infected = true;
+                health.stage = InfectionStage::Infectious;
+                health.stage_tick = tick;
                 health.current_disease = &baseline_disease_;
             }
         } else {
-            const double recoveryProb = baseline_disease_.recovery * (health.physical_health + snapshot.healthcare);
-            if (uni(rng_) < recoveryProb) {
+            double recoveryProb = baseline_disease_.recovery * (health.physical_health + snapshot.healthcare);
+            if (!single) recoveryProb = 1.0 - std::pow(1.0 - std::min(1.0, recoveryProb), steps);
+            if (CounterRng::uniform(seed_, tick, agent.id, kRecoveryStream) < recoveryProb) {
                 health.infected = false;
+                health.stage = InfectionStage::Susceptible;
+                health.stage_tick = tick;
                 health.immunity = clamp01(health.immunity + baseline_disease_.immunity_boost);
                 health.current_disease = nullptr;
             }
         }
+    }
+
+    health.immunity = clamp01(health.immunity * (single ? 0.995 : std::pow(0.995, steps)));
+
+    accumulate(agent, thread);
+}
 
-        health.immunity = clamp01(health.immunity * 0.995);
-        snapshot.avg_health += health.physical_health;
+void HealthModule::accumulate(const Agent& agent, std::size_t thread) {
+    RegionSums& sums = thread_sums_[thread][agent.region];
+    sums.health += agent.health.physical_health;
+    sums.count++;
+}
+
+void HealthModule::finishTick() {
+    for (std::size_t r = 0; r < regional_snapshots_.size(); ++r) {
+        double health = 0.0;
+        std::uint32_t count = 0;
+        for (const auto& sums : thread_sums_) {
+            health += sums[r].health;
+            count += sums[r].count;
+        }
+        regional_snapshots_[r].avg_health = count > 0 ? health / count : 0.0;
     }
+}
 
-    for (std::uint32_t r = 0; r < regionCount; ++r) {
-        if (regionCounts[r] > 0) {
-            regional_snapshots_[r].avg_health /= regionCounts[r];
+void HealthModule::setEpidemicModel(EpidemicModel model, std::vector<Agent>& agents) {
+    model_ = model;
+    clearEpidemic(agents);
+}
+
+void HealthModule::clearEpidemic(std::vector<Agent>& agents) {
+    for (auto& agent : agents) {
+        auto& health = agent.health;
+        health.infected = false;
+        health.stage = InfectionStage::Susceptible;
+        health.current_disease = nullptr;
+    }
+    exposed_.clear();
+    infectious_.clear();
+    waning_.clear();
+    stats_ = {};
+}
+
+bool HealthModule::seedInfection(Agent& agent, std::uint64_t tick) {
+    if (model_ != EpidemicModel::Network || !agent.alive ||
+        agent.health.stage != InfectionStage::Susceptible) {
+        return false;
+    }
+    expose(agent, tick);
+    return true;
+}
+
+void HealthModule::expose(Agent& agent, std::uint64_t tick) {
+    agent.health.stage = InfectionStage::Exposed;
+    agent.health.stage_tick = tick;
+    exposed_.push_back(agent.id);
+    stats_.exposed = exposed_.size();
+    ++stats_.newExposures;
+    ++stats_.totalCases;
+}
+
+void HealthModule::stepEpidemic(std::vector<Agent>& agents, std::uint64_t tick) {
+    if (model_ != EpidemicModel::Network) {
+        return;
+    }
+    const Disease& disease = baseline_disease_;
+    stats_.newExposures = 0;
+    stats_.spillovers = 0;
+    stats_.recoveries = 0;
+    stats_.edgesScanned = 0;
+
+    // Outside introductions: a Poisson number of random agents, each accepted
+    // with its region's infection pressure so spillover still follows conditions
+    if (disease.spillover > 0.0 && !agents.empty()) {
+        std::poisson_distribution<int> arrivals(disease.spillover);
+        std::uniform_int_distribution<std::size_t> pick(0, agents.size() - 1);
+        std::uniform_real_distribution<double> accept(0.0, 1.0);
+        for (int n = arrivals(rng_); n > 0; --n) {
+            Agent& agent = agents[pick(rng_)];
+            if (!agent.alive || agent.health.stage != InfectionStage::Susceptible) continue;
+            if (accept(rng_) < regional_snapshots_[agent.region].infection_pressure) {
+                expose(agent, tick);
+                ++stats_.spillovers;
+            }
         }
     }
+
+    // Transmission from agents infectious at the start of the tick. Every
+    // contact has its own counter draw, so the exposed set does not depend on
+    // the order sources are visited. Dead sources drop out of the set here.
+    std::size_t live = 0;
+    for (std::size_t k = 0; k < infectious_.size(); ++k) {
+        const std::uint32_t id = infectious_[k];
+        const Agent& source = agents[id];
+        if (!source.alive || source.health.stage != InfectionStage::Infectious) continue;
+        infectious_[live++] = id;
+
+        const std::uint64_t sourceSeed = seed_ ^ CounterRng::mix(id);
+        stats_.edgesScanned += source.neighbors.size();
+        for (std::uint32_t nb : source.neighbors) {
+            if (nb >= agents.size()) continue;
+            Agent& target = agents[nb];
+            if (!target.alive || target.health.stage != InfectionStage::Susceptible) continue;
+            const double p = disease.transmission * (1.0 - target.health.immunity);
+            if (CounterRng::uniform(sourceSeed, tick, nb, kTransmissionStream) < p) {
+                expose(target, tick);
+            }
+        }
+    }
+    infectious_.resize(live);
+
+    // Recovery
+    live = 0;
+    for (std::uint32_t id : infectious_) {
+        Agent& agent = agents[id];
+        auto& health = agent.health;
+        const double recoveryProb = disease.recovery *
+            (health.physical_health + regional_snapshots_[agent.region].healthcare);
+        if (CounterRng::uniform(seed_, tick, id, kRecoveryStream) < recoveryProb) {
+            health.infected = false;
+            health.current_disease = nullptr;
+            health.stage = InfectionStage::Recovered;
+            health.stage_tick = tick;
+            health.immunity = clamp01(health.immunity + disease.immunity_boost);
+            if (disease.immune_ticks > 0) {
+                waning_.emplace_back(id, tick);
+            }
+            ++stats_.recoveries;
+        } else {
+            infectious_[live++] = id;
+        }
+    }
+    infectious_.resize(live);
+
+    // Exposed → infectious once the latent period has passed (same tick for SIR)
+    const std::uint64_t latent = static_cast<std::uint64_t>(std::max(0, disease.latent_ticks));
+    live = 0;
+    for (std::uint32_t id : exposed_) {
+        Agent& agent = agents[id];
+        auto& health = agent.health;
+        if (!agent.alive || health.stage != InfectionStage::Exposed) continue;
+        if (tick - health.stage_tick >= latent) {
+            health.stage = InfectionStage::Infectious;
+            health.stage_tick = tick;
+            health.infected = true;
+            health.current_disease = &baseline_disease_;
+            infectious_.push_back(id);
+        } else {
+            exposed_[live++] = id;
+        }
+    }
+    exposed_.resize(live);
+
+    // Waning immunity (recoveries are queued in tick order)
+    const std::uint64_t immune = static_cast<std::uint64_t>(std::max(0, disease.immune_ticks));
+    while (!waning_.empty() && tick - waning_.front().second >= immune) {
+        auto& health = agents[waning_.front().first].health;
+        if (health.stage == InfectionStage::Recovered) {
+            health.stage = InfectionStage::Susceptible;
+            health.stage_tick = tick;
+        }
+        waning_.pop_front();
+    }
+
+    stats_.exposed = exposed_.size();
+    stats_.infectious = infectious_.size();
 }
 
 double HealthModule::computeAgeDecay(double ageFactor) const {
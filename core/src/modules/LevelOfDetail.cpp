@@ -0,0 +1,164 @@
+#include "modules/LevelOfDetail.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "kernel/Kernel.h"
+#include "modules/Economy.h"
+
+void LevelOfDetail::configure(const LodConfig& cfg) {
+    cfg_ = cfg;
+    tick_ = 0;
+    tier_.clear();
+    quiet_.clear();
+    belief_last_.clear();
+    wellbeing_last_.clear();
+    hardship_.clear();
+    infected_.clear();
+    regions_.clear();
+    slots_.clear();
+    stats_ = {};
+}
+
+void LevelOfDetail::beginTick(const std::vector<Agent>& agents, std::uint64_t tick, std::size_t threads) {
+    tick_ = tick;
+    const std::size_t n = agents.size();
+    resize(n);
+
+    stats_ = {};
+    for (std::size_t i = 0; i < n; ++i) {
+        if (agents[i].alive) stats_.tierCounts[tier_[i]]++;
+    }
+
+    slots_.resize(std::max<std::size_t>(1, threads));
+    for (auto& slot : slots_) {
+        slot.loud.clear();
+        slot.beliefUpdates = 0;
+        slot.wellbeingUpdates = 0;
+        slot.demotions = 0;
+        slot.stressPromotions = 0;
+    }
+}
+
+void LevelOfDetail::resize(std::size_t agents) {
+    if (tier_.size() >= agents) return;
+    // New agents start at full rate; "last update" = now, so the first dt is 1
+    tier_.resize(agents, 0);
+    quiet_.resize(agents, 0);
+    belief_last_.resize(agents, tick_);
+    wellbeing_last_.resize(agents, tick_);
+    hardship_.resize(agents, 0.0f);
+    infected_.resize(agents, 0);
+}
+
+void LevelOfDetail::stepScales(double rate, double dt, double& drift, double& noise) {
+    if (dt <= 1.0) {
+        drift = 1.0;
+        noise = 1.0;
+        return;
+    }
+    const double k = std::clamp(rate, 1e-6, 0.99);
+    const double r = 1.0 - k;
+    const double rn = std::pow(r, dt);
+    drift = (1.0 - rn) / k;
+    noise = std::sqrt((1.0 - rn * rn) / (1.0 - r * r));
+}
+
+void LevelOfDetail::recordBeliefUpdate(std::uint32_t id, double drift, std::size_t thread) {
+    ThreadSlot& slot = slots_[thread];
+    slot.beliefUpdates++;
+    belief_last_[id] = tick_;
+
+    if (drift < cfg_.tolerance) {
+        if (tier_[id] + 1 < kTiers && ++quiet_[id] >= cfg_.quietUpdates) {
+            tier_[id]++;
+            quiet_[id] = 0;
+            slot.demotions++;
+        }
+        return;
+    }
+    quiet_[id] = 0;
+    tier_[id] = 0;
+    if (drift > cfg_.tolerance * cfg_.wakeFactor) {
+        slot.loud.push_back(id);
+    }
+}
+
+void LevelOfDetail::wakeNeighbors(const std::vector<Agent>& agents) {
+    for (const auto& slot : slots_) {
+        for (std::uint32_t id : slot.loud) {
+            for (std::uint32_t nb : agents[id].neighbors) {
+                if (nb >= tier_.size() || tier_[nb] == 0) continue;
+                tier_[nb] = 0;
+                quiet_[nb] = 0;
+                stats_.neighborPromotions++;
+            }
+        }
+    }
+}
+
+bool LevelOfDetail::stressorsChanged(const Agent& agent, double hardship) const {
+    const std::uint32_t id = agent.id;
+    return (track_infection_ && agent.health.infected != (infected_[id] != 0)) ||
+           std::abs(hardship - static_cast<double>(hardship_[id])) > cfg_.stressTrigger;
+}
+
+void LevelOfDetail::recordWellbeingUpdate(const Agent& agent, double hardship, double stressBefore,
+                                          double steps, std::size_t thread) {
+    const std::uint32_t id = agent.id;
+    ThreadSlot& slot = slots_[thread];
+    slot.wellbeingUpdates++;
+
+    const bool changed = stressorsChanged(agent, hardship) ||
+        std::abs(agent.psych.stress_level - stressBefore) > cfg_.stressTrigger * steps;
+    wellbeing_last_[id] = tick_;
+    hardship_[id] = static_cast<float>(hardship);
+    infected_[id] = agent.health.infected ? 1 : 0;
+
+    if (changed && tier_[id] != 0) {
+        tier_[id] = 0;
+        quiet_[id] = 0;
+        slot.stressPromotions++;
+    }
+}
+
+void LevelOfDetail::checkEconomy(const Economy& economy,
+                                 const std::vector<std::vector<std::uint32_t>>& region_index) {
+    regions_.resize(region_index.size());
+    for (std::size_t r = 0; r < region_index.size(); ++r) {
+        const auto& reg = economy.getRegion(static_cast<std::uint32_t>(r));
+        RegionConditions& last = regions_[r];
+        const bool moved = last.valid &&
+            (std::abs(reg.hardship - last.hardship) > cfg_.econTrigger ||
+             std::abs(reg.welfare - last.welfare) > cfg_.econTrigger ||
+             std::abs(reg.system_stability - last.stability) > cfg_.econTrigger);
+        last.hardship = reg.hardship;
+        last.welfare = reg.welfare;
+        last.stability = reg.system_stability;
+        last.valid = true;
+        if (!moved) continue;
+
+        for (std::uint32_t id : region_index[r]) {
+            if (id >= tier_.size() || tier_[id] == 0) continue;
+            tier_[id] = 0;
+            quiet_[id] = 0;
+            stats_.economyPromotions++;
+        }
+    }
+}
+
+void LevelOfDetail::promote(std::uint32_t id) {
+    if (id < tier_.size()) {
+        tier_[id] = 0;
+        quiet_[id] = 0;
+    }
+}
+
+void LevelOfDetail::finishTick() {
+    for (const auto& slot : slots_) {
+        stats_.beliefUpdates += slot.beliefUpdates;
+        stats_.wellbeingUpdates += slot.wellbeingUpdates;
+        stats_.demotions += slot.demotions;
+        stats_.stressPromotions += slot.stressPromotions;
+    }
+}
@@ -5,7 +5,7 @@
 
 void MeanFieldApproximation::configure(std::uint32_t num_regions) {
     num_regions_ = num_regions;
-    regional_fields_.assign(num_regions, {0.0, 0.0, 0.0, 0.0});
+    regional_fields_.assign(num_regions, BeliefVec{});
     field_strengths_.assign(num_regions, 1.0);
     region_populations_.assign(num_regions, 0);
 }
@@ -14,7 +14,7 @@ void MeanFieldApproximation::computeFields(const std::vector<Agent>& agents,
                                            const std::vector<std::vector<std::uint32_t>>& region_index) {
     // Reset fields
     for (auto& field : regional_fields_) {
-        field = {0.0, 0.0, 0.0, 0.0};
+        field = BeliefVec{};
     }
     region_populations_.assign(num_regions_, 0);
     
@@ -27,10 +27,7 @@ void MeanFieldApproximation::computeFields(const std::vector<Agent>& agents,
             const auto& agent = agents[agent_id];
             if (!agent.alive) continue;
             
-            regional_fields_[r][0] += agent.B[0];
-            regional_fields_[r][1] += agent.B[1];
-            regional_fields_[r][2] += agent.B[2];
-            regional_fields_[r][3] += agent.B[3];
+            belief::add<kBeliefDims>(regional_fields_[r], agent.B);
             region_populations_[r]++;
         }
     }
@@ -39,10 +36,7 @@ void MeanFieldApproximation::computeFields(const std::vector<Agent>& agents,
     for (std::uint32_t r = 0; r < num_regions_; ++r) {
         if (region_populations_[r] > 0) {
             const double inv_pop = 1.0 / region_populations_[r];
-            regional_fields_[r][0] *= inv_pop;
-            regional_fields_[r][1] *= inv_pop;
-            regional_fields_[r][2] *= inv_pop;
-            regional_fields_[r][3] *= inv_pop;
+            belief::scale<kBeliefDims>(regional_fields_[r], inv_pop);
             
             // Field strength: logarithmic scaling with population
             // Small groups have high variance, large groups have stable fields
@@ -50,14 +44,14 @@ void MeanFieldApproximation::computeFields(const std::vector<Agent>& agents,
             field_strengths_[r] = std::min(1.0, std::log(pop + 1.0) / std::log(100.0));
         } else {
             // Empty region: neutral field
-            regional_fields_[r] = {0.0, 0.0, 0.0, 0.0};
+            regional_fields_[r] = BeliefVec{};
             field_strengths_[r] = 0.0;
         }
     }
 }
 
-const std::array<double, 4>& MeanFieldApproximation::getRegionalField(std::uint32_t region) const {
-    static const std::array<double, 4> zero_field = {0.0, 0.0, 0.0, 0.0};
+const BeliefVec& MeanFieldApproximation::getRegionalField(std::uint32_t region) const {
+    static const BeliefVec zero_field{};
     if (region >= num_regions_) return zero_field;
     return regional_fields_[region];
 }
@@ -67,12 +61,12 @@ double MeanFieldApproximation::getFieldStrength(std::uint32_t region) const {
     return field_strengths_[region];
 }
 
-std::array<double, 4> MeanFieldApproximation::getBlendedInfluence(
+BeliefVec MeanFieldApproximation::getBlendedInfluence(
     const NeighborInfluence& neighbors,
     std::uint32_t region,
     double neighbor_weight
 ) const {
-    std::array<double, 4> result{0.0, 0.0, 0.0, 0.0};
+    BeliefVec result{};
     
     const auto& field = getRegionalField(region);
     double field_strength = getFieldStrength(region);
@@ -85,7 +79,7 @@ std::array<double, 4> MeanFieldApproximation::getBlendedInfluence(
     
     if (neighbors.neighbor_count > 0 && neighbors.total_weight > 0.0) {
         // Blend neighbor average with dampened regional field
-        for (int i = 0; i < 4; ++i) {
+        for (int i = 0; i < kBeliefDims; ++i) {
             double neighbor_avg = neighbors.belief_sum[i] / neighbors.total_weight;
             result[i] = neighbor_weight * neighbor_avg + 
                        regional_weight * field[i] * dampened_field_strength;
@@ -93,7 +87,7 @@ std::array<double, 4> MeanFieldApproximation::getBlendedInfluence(
     } else {
         // Isolated agents: very weak regional field influence
         // Isolated people don't absorb regional culture as quickly
-        for (int i = 0; i < 4; ++i) {
+        for (int i = 0; i < kBeliefDims; ++i) {
             result[i] = field[i] * dampened_field_strength * 0.3;
         }
     }
@@ -2,56 +2,74 @@
 #include "kernel/Kernel.h"
 #include <algorithm>
 #include <cmath>
+#include <functional>
 #include <limits>
 #include <random>
+#include <omp.h>
 
-OnlineClustering::OnlineClustering(int k, double learning_rate)
-    : k_(std::max(2, k)), learning_rate_(learning_rate) {
-    centroids_.resize(k_);
-    cluster_sizes_.assign(k_, 0);
-}
-
-void OnlineClustering::initialize(const std::vector<Agent>& agents) {
-    if (agents.empty()) return;
-    
-    // K-means++ initialization for good starting centroids
-    std::mt19937_64 rng(agents.size());
-    std::uniform_int_distribution<std::size_t> pick(0, agents.size() - 1);
-    
-    // First centroid: random agent
-    centroids_[0] = agents[pick(rng)].B;
-    
-    // Remaining centroids: weighted by distance to nearest existing centroid
+namespace {
+
+template <typename A, typename B>
+double squaredDistance(const std::array<A, kBeliefDims>& a, const std::array<B, kBeliefDims>& b) {
+    return belief::distanceSq<kBeliefDims>(a, b);
+}
+
+}
+
+OnlineClustering::OnlineClustering(int k, int sweep_ticks)
+    : k_(std::max(2, k)), sweep_ticks_(std::max(1, sweep_ticks)) {
+    centroids_.assign(k_, Point{0.0, 0.0, 0.0, 0.0});
+    moments_.assign(k_, Moments{});
+}
+
+void OnlineClustering::initialize(const std::vector<Agent>& agents, std::uint64_t seed) {
+    std::vector<std::uint32_t> alive;
+    alive.reserve(agents.size());
+    for (std::size_t i = 0; i < agents.size(); ++i) {
+        if (agents[i].alive) alive.push_back(static_cast<std::uint32_t>(i));
+    }
+    assignments_.assign(agents.size(), -1);
+    moments_.assign(k_, Moments{});
+    sweep_cursor_ = 0;
+    initialized_ = true;
+    if (alive.empty()) return;
+
+    // K-means++ seeding: minimum distances are updated against the newest
+    // centroid only and each seed is drawn by walking the D² prefix, O(N·K)
+    std::mt19937_64 rng(seed ^ alive.size());
+    std::uniform_int_distribution<std::size_t> pick(0, alive.size() - 1);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    centroids_[0] = belief::toVec(agents[alive[pick(rng)]].B);
+
+    std::vector<double> min_distances(alive.size(), std::numeric_limits<double>::max());
     for (int c = 1; c < k_; ++c) {
-        std::vector<double> min_distances(agents.size(), std::numeric_limits<double>::max());
-        
-        for (std::size_t i = 0; i < agents.size(); ++i) {
-            for (int existing = 0; existing < c; ++existing) {
-                double dist = squaredDistance(agents[i].B, centroids_[existing]);
-                min_distances[i] = std::min(min_distances[i], dist);
+        double total = 0.0;
+        for (std::size_t i = 0; i < alive.size(); ++i) {
+            double dist = squaredDistance(agents[alive[i]].B, centroids_[c - 1]);
+            min_distances[i] = std::min(min_distances[i], dist);
+            total += min_distances[i];
+        }
+        std::size_t chosen = pick(rng);
+        if (total > 0.0) {
+            double target = unit(rng) * total;
+            for (std::size_t i = 0; i < alive.size(); ++i) {
+                target -= min_distances[i];
+                if (target <= 0.0) {
+                    chosen = i;
+                    break;
+                }
             }
         }
-        
-        // Choose next centroid with probability proportional to distance squared
-        std::discrete_distribution<std::size_t> dist(min_distances.begin(), min_distances.end());
-        centroids_[c] = agents[dist(rng)].B;
-    }
-    
-    // Initial assignment
-    assignments_.assign(agents.size(), -1);
-    cluster_sizes_.assign(k_, 0);
-    
-    for (std::size_t i = 0; i < agents.size(); ++i) {
-        int cluster = findNearestCentroid(agents[i].B);
-        assignments_[i] = cluster;
-        cluster_sizes_[cluster]++;
+        centroids_[c] = belief::toVec(agents[alive[chosen]].B);
     }
+
+    fullReassignment(agents);
 }
 
-int OnlineClustering::findNearestCentroid(const std::array<double, 4>& beliefs) const {
+int OnlineClustering::findNearestCentroid(const BeliefState& beliefs) const {
     double best_dist = std::numeric_limits<double>::max();
     int best_cluster = 0;
-    
+
     for (int c = 0; c < k_; ++c) {
         double dist = squaredDistance(beliefs, centroids_[c]);
         if (dist < best_dist) {
@@ -59,114 +77,211 @@ int OnlineClustering::findNearestCentroid(const std::array<double, 4>& beliefs)
             best_cluster = c;
         }
     }
-    
+
     return best_cluster;
 }
 
-double OnlineClustering::squaredDistance(const std::array<double, 4>& a, 
-                                         const std::array<double, 4>& b) const {
-    double sum = 0.0;
-    for (int d = 0; d < 4; ++d) {
-        double diff = a[d] - b[d];
-        sum += diff * diff;
-    }
-    return sum;
-}
-
-void OnlineClustering::updateAgent(std::uint32_t agent_id, const std::array<double, 4>& new_beliefs) {
-    // Ensure assignments vector is large enough
-    if (agent_id >= assignments_.size()) {
-        assignments_.resize(agent_id + 1, -1);
-    }
-    
-    // Find nearest centroid for new beliefs
-    int new_cluster = findNearestCentroid(new_beliefs);
-    int old_cluster = assignments_[agent_id];
-    
-    // If cluster changed, update counts
-    if (old_cluster != new_cluster && old_cluster >= 0) {
-        cluster_sizes_[old_cluster] = (cluster_sizes_[old_cluster] > 0) ? 
-                                       (cluster_sizes_[old_cluster] - 1) : 0;
-        cluster_sizes_[new_cluster]++;
-        assignments_[agent_id] = new_cluster;
-    } else if (old_cluster < 0) {
-        // First assignment
-        cluster_sizes_[new_cluster]++;
-        assignments_[agent_id] = new_cluster;
-    }
-    
-    // Update centroid incrementally: C_new = C_old + α(Agent - C_old)
-    updateCentroid(new_cluster, new_beliefs);
-}
-
-void OnlineClustering::updateCentroid(int cluster_id, const std::array<double, 4>& agent_beliefs) {
-    if (cluster_id < 0 || cluster_id >= k_) return;
-    
-    // Adaptive learning rate based on cluster size
-    // Larger clusters → slower adaptation (more stable)
-    // Smaller clusters → faster adaptation (more responsive)
-    double adaptive_rate = learning_rate_;
-    if (cluster_sizes_[cluster_id] > 0) {
-        // Use logarithmic decay, and cap denominator to avoid vanishing rates
-        double denom = std::max(1.0, std::log(static_cast<double>(cluster_sizes_[cluster_id]) + 1.0));
-        adaptive_rate = learning_rate_ / denom;
-    }
-    adaptive_rate = std::min(0.1, adaptive_rate);  // Cap at 10% per update
-    
-    // Incremental update
-    for (int d = 0; d < 4; ++d) {
-        centroids_[cluster_id][d] += adaptive_rate * (agent_beliefs[d] - centroids_[cluster_id][d]);
+void OnlineClustering::refreshCentroids() {
+    // Empty clusters keep their last centroid until a sweep refills them
+    for (int c = 0; c < k_; ++c) {
+        const auto& m = moments_[c];
+        if (m.count <= 0) continue;
+        const double inv = 1.0 / static_cast<double>(m.count);
+        for (int d = 0; d < kBeliefDims; ++d) {
+            centroids_[c][d] = m.sum[d] * inv;
+        }
     }
 }
 
-void OnlineClustering::fullReassignment(const std::vector<Agent>& agents) {
-    // Reset counts
-    cluster_sizes_.assign(k_, 0);
-    
-    // Ensure assignments is large enough
+void OnlineClustering::prepareDeltas(std::size_t threads) {
+    if (thread_deltas_.size() < threads) {
+        thread_deltas_.resize(threads);
+    }
+    for (auto& buffer : thread_deltas_) {
+        if (buffer.size() != static_cast<std::size_t>(k_)) {
+            buffer.assign(k_, Moments{});
+        }
+    }
+}
+
+void OnlineClustering::mergeDeltas() {
+    for (auto& buffer : thread_deltas_) {
+        for (int c = 0; c < k_; ++c) {
+            moments_[c].merge(buffer[c]);
+            buffer[c] = Moments{};
+        }
+    }
+    refreshCentroids();
+}
+
+void OnlineClustering::onBeliefChanged(std::uint32_t agent_id, const BeliefState& before, const BeliefState& after) {
+    const int c = getCluster(agent_id);
+    if (c < 0) return;
+    moments_[c].shift(before, after);
+    const double inv = 1.0 / static_cast<double>(std::max<std::int64_t>(1, moments_[c].count));
+    for (int d = 0; d < kBeliefDims; ++d) {
+        centroids_[c][d] = moments_[c].sum[d] * inv;
+    }
+}
+
+void OnlineClustering::onAgentAdded(const Agent& agent) {
+    if (!initialized_ || !agent.alive) return;
+    if (agent.id >= assignments_.size()) {
+        assignments_.resize(agent.id + 1, -1);
+    }
+    if (assignments_[agent.id] >= 0) return;
+
+    // Joins its nearest culture; the centroid moves by (b - C) / n
+    const int c = findNearestCentroid(agent.B);
+    assignments_[agent.id] = c;
+    moments_[c].add(agent.B);
+    const double inv = 1.0 / static_cast<double>(moments_[c].count);
+    for (int d = 0; d < kBeliefDims; ++d) {
+        centroids_[c][d] = moments_[c].sum[d] * inv;
+    }
+}
+
+void OnlineClustering::onAgentRemoved(const Agent& agent) {
+    // Note: agent.alive may already be false when this is called
+    const int c = getCluster(agent.id);
+    if (c < 0) return;
+    assignments_[agent.id] = -1;
+    moments_[c].remove(agent.B);
+    if (moments_[c].count > 0) {
+        const double inv = 1.0 / static_cast<double>(moments_[c].count);
+        for (int d = 0; d < kBeliefDims; ++d) {
+            centroids_[c][d] = moments_[c].sum[d] * inv;
+        }
+    } else {
+        moments_[c] = Moments{};
+    }
+}
+
+void OnlineClustering::reassignRange(const std::vector<Agent>& agents,
+                                     std::size_t begin, std::size_t end) {
     if (assignments_.size() < agents.size()) {
         assignments_.resize(agents.size(), -1);
     }
-    
-    // Reassign all agents
-    for (std::size_t i = 0; i < agents.size(); ++i) {
-        if (!agents[i].alive) continue;
-        
-        int cluster = findNearestCentroid(agents[i].B);
-        assignments_[i] = cluster;
-        cluster_sizes_[cluster]++;
-    }
-    
-    // Recompute centroids from scratch (stabilization step)
-    std::vector<std::array<double, 4>> new_centroids(k_, {0.0, 0.0, 0.0, 0.0});
-    
-    for (std::size_t i = 0; i < agents.size(); ++i) {
-        if (!agents[i].alive) continue;
-        
-        int cluster = assignments_[i];
-        if (cluster >= 0 && cluster < k_) {
-            for (int d = 0; d < 4; ++d) {
-                new_centroids[cluster][d] += agents[i].B[d];
-            }
+    end = std::min(end, agents.size());
+    if (begin >= end) return;
+
+    const std::size_t threads = static_cast<std::size_t>(std::max(1, omp_get_max_threads()));
+    prepareDeltas(threads);
+    // Farthest member seen per thread: re-seeds clusters that empty out
+    std::vector<std::pair<double, std::int64_t>> farthest(threads, {-1.0, -1});
+
+    const std::int64_t first = static_cast<std::int64_t>(begin);
+    const std::int64_t last = static_cast<std::int64_t>(end);
+    #pragma omp parallel
+    {
+    const std::size_t tid = static_cast<std::size_t>(omp_get_thread_num());
+    auto& deltas = thread_deltas_[tid];
+    auto& far = farthest[tid];
+
+    #pragma omp for schedule(static)
+    for (std::int64_t ii = first; ii < last; ++ii) {
+        const std::size_t i = static_cast<std::size_t>(ii);
+        const Agent& agent = agents[i];
+        if (!agent.alive) continue;
+
+        const int c = findNearestCentroid(agent.B);
+        const int old = assignments_[i];
+        if (c != old) {
+            if (old >= 0) deltas[old].remove(agent.B);
+            deltas[c].add(agent.B);
+            assignments_[i] = c;
         }
+        const double dist = squaredDistance(agent.B, centroids_[c]);
+        if (dist > far.first) far = {dist, ii};
     }
-    
-    // Average and handle empty clusters
-    std::mt19937_64 rng(agents.size() * 7919);
-    std::uniform_int_distribution<std::size_t> pick(0, agents.size() - 1);
-    
-    for (int c = 0; c < k_; ++c) {
-        if (cluster_sizes_[c] == 0) {
-            // Reinitialize empty cluster to random agent
-            new_centroids[c] = agents[pick(rng)].B;
-        } else {
-            for (int d = 0; d < 4; ++d) {
-                new_centroids[c][d] /= cluster_sizes_[c];
-            }
+    }  // omp parallel
+
+    mergeDeltas();
+
+    // Refill any empty cluster with the worst-fitting agent of this range
+    std::sort(farthest.begin(), farthest.end(), std::greater<>());
+    std::size_t next = 0;
+    for (int c = 0; c < k_ && next < farthest.size(); ++c) {
+        if (moments_[c].count > 0) continue;
+        const std::int64_t donor = farthest[next++].second;
+        if (donor < 0) break;
+        const std::size_t i = static_cast<std::size_t>(donor);
+        const int old = assignments_[i];
+        if (old < 0 || moments_[old].count <= 1) continue;
+        moments_[old].remove(agents[i].B);
+        moments_[c] = Moments{};
+        moments_[c].add(agents[i].B);
+        assignments_[i] = c;
+    }
+    refreshCentroids();
+}
+
+void OnlineClustering::sweep(const std::vector<Agent>& agents) {
+    if (!initialized_ || agents.empty()) return;
+    const std::size_t n = agents.size();
+    const std::size_t slice = (n + sweep_ticks_ - 1) / static_cast<std::size_t>(sweep_ticks_);
+    if (sweep_cursor_ >= n) sweep_cursor_ = 0;
+    const std::size_t end = std::min(n, sweep_cursor_ + slice);
+    reassignRange(agents, sweep_cursor_, end);
+    sweep_cursor_ = (end >= n) ? 0 : end;
+}
+
+void OnlineClustering::fullReassignment(const std::vector<Agent>& agents) {
+    reassignRange(agents, 0, agents.size());
+    resync(agents);
+}
+
+void OnlineClustering::resync(const std::vector<Agent>& agents) {
+    const std::size_t threads = static_cast<std::size_t>(std::max(1, omp_get_max_threads()));
+    prepareDeltas(threads);
+    moments_.assign(k_, Moments{});
+
+    const std::int64_t count = static_cast<std::int64_t>(std::min(agents.size(), assignments_.size()));
+    #pragma omp parallel
+    {
+    auto& deltas = thread_deltas_[static_cast<std::size_t>(omp_get_thread_num())];
+
+    #pragma omp for schedule(static)
+    for (std::int64_t ii = 0; ii < count; ++ii) {
+        const std::size_t i = static_cast<std::size_t>(ii);
+        const int c = assignments_[i];
+        if (c < 0) continue;
+        if (!agents[i].alive) {
+            assignments_[i] = -1;
+            continue;
         }
+        deltas[c].add(agents[i].B);
+    }
+    }  // omp parallel
+
+    mergeDeltas();
+}
+
+std::uint32_t OnlineClustering::clusterSize(int cluster_id) const {
+    if (cluster_id < 0 || cluster_id >= k_) return 0;
+    return static_cast<std::uint32_t>(std::max<std::int64_t>(0, moments_[cluster_id].count));
+}
+
+double OnlineClustering::clusterCoherence(int cluster_id) const {
+    if (cluster_id < 0 || cluster_id >= k_) return 0.0;
+    const auto& m = moments_[cluster_id];
+    if (m.count <= 0) return 0.0;
+
+    // Same definition as enrichClusters(): 1 - mean per-dimension variance
+    const double inv = 1.0 / static_cast<double>(m.count);
+    double variance = 0.0;
+    for (int d = 0; d < kBeliefDims; ++d) {
+        double mean = m.sum[d] * inv;
+        variance += m.sumsq[d] * inv - mean * mean;
     }
-    
-    centroids_ = std::move(new_centroids);
+    variance = std::max(0.0, variance / kBeliefDims);
+    return std::max(0.0, 1.0 - variance);
+}
+
+std::uint32_t OnlineClustering::trackedAgents() const {
+    std::int64_t total = 0;
+    for (const auto& m : moments_) total += m.count;
+    return static_cast<std::uint32_t>(std::max<std::int64_t>(0, total));
 }
 
 int OnlineClustering::getCluster(std::uint32_t agent_id) const {
@@ -174,54 +289,69 @@ int OnlineClustering::getCluster(std::uint32_t agent_id) const {
     return assignments_[agent_id];
 }
 
+double OnlineClustering::inertia() const {
+    // Σ|b - μ|² = Σb² - |Σb|²/n per cluster, since centroids are exact means
+    double total = 0.0;
+    for (const auto& m : moments_) {
+        if (m.count <= 0) continue;
+        const double inv = 1.0 / static_cast<double>(m.count);
+        for (int d = 0; d < kBeliefDims; ++d) {
+            total += m.sumsq[d] - m.sum[d] * m.sum[d] * inv;
+        }
+    }
+    return std::max(0.0, total);
+}
+
+std::vector<std::uint32_t> OnlineClustering::getClusterSizes() const {
+    std::vector<std::uint32_t> sizes(k_);
+    for (int c = 0; c < k_; ++c) {
+        sizes[c] = clusterSize(c);
+    }
+    return sizes;
+}
+
 std::vector<std::uint32_t> OnlineClustering::getClusterMembers(int cluster_id) const {
     std::vector<std::uint32_t> members;
-    
+    if (cluster_id < 0 || cluster_id >= k_) return members;
+    members.reserve(clusterSize(cluster_id));
+
     for (std::size_t i = 0; i < assignments_.size(); ++i) {
         if (assignments_[i] == cluster_id) {
             members.push_back(static_cast<std::uint32_t>(i));
         }
     }
-    
+
     return members;
 }
 
-double OnlineClustering::getClusterCoherence(int cluster_id, const std::vector<Agent>& agents) const {
-    if (cluster_id < 0 || cluster_id >= k_) return 0.0;
-    
-    auto members = getClusterMembers(cluster_id);
-    if (members.empty()) return 0.0;
-    
-    // Compute average distance to centroid
-    double total_dist = 0.0;
-    for (auto agent_id : members) {
-        if (agent_id < agents.size() && agents[agent_id].alive) {
-            total_dist += std::sqrt(squaredDistance(agents[agent_id].B, centroids_[cluster_id]));
-        }
+std::vector<Cluster> OnlineClustering::materialize(const Kernel& kernel, std::uint32_t min_size,
+                                                   double min_coherence) const {
+    // Screen on the maintained moments first: O(K)
+    std::vector<int> slot(k_, -1);
+    std::vector<Cluster> clusters;
+    for (int c = 0; c < k_; ++c) {
+        const std::uint32_t size = clusterSize(c);
+        if (size == 0 || size < min_size || clusterCoherence(c) < min_coherence) continue;
+        slot[c] = static_cast<int>(clusters.size());
+        Cluster cluster;
+        cluster.id = static_cast<std::uint32_t>(c);
+        cluster.centroid = centroids_[c];
+        cluster.members.reserve(size);
+        clusters.push_back(std::move(cluster));
     }
-    
-    double avg_dist = total_dist / members.size();
-    
-    // Convert to coherence (1 = perfect, 0 = dispersed)
-    // Assume distance range [0, 4] (max distance in 4D [-1,1]^4 space)
-    return std::max(0.0, 1.0 - (avg_dist / 4.0));
-}
-
-std::vector<std::uint32_t> OnlineClustering::getClusterSizes() const {
-    return cluster_sizes_;
-}
+    if (clusters.empty()) return clusters;
 
-double OnlineClustering::getTotalInertia(const std::vector<Agent>& agents) const {
-    double total = 0.0;
-    
-    for (std::size_t i = 0; i < agents.size(); ++i) {
-        if (!agents[i].alive) continue;
-        
-        int cluster = (i < assignments_.size()) ? assignments_[i] : -1;
-        if (cluster >= 0 && cluster < k_) {
-            total += squaredDistance(agents[i].B, centroids_[cluster]);
+    // One bucketing pass over the assignments
+    for (std::size_t i = 0; i < assignments_.size(); ++i) {
+        const int c = assignments_[i];
+        if (c >= 0 && slot[c] >= 0) {
+            clusters[slot[c]].members.push_back(static_cast<std::uint32_t>(i));
         }
     }
-    
-    return total;
+
+    enrichClusters(clusters, kernel);
+    for (auto& cluster : clusters) {
+        cluster.birthTick = kernel.generation();
+    }
+    return clusters;
 }
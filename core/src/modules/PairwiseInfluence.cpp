@@ -0,0 +1,101 @@
+#include "modules/PairwiseInfluence.h"
+#include "kernel/Kernel.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// |B_i|² · |B_j|² < 1e-9 ("both near zero", gate 1) in inverse norms:
+// inv_i · inv_j > 1 / sqrt(1e-9)
+constexpr double kNearZeroInvProduct = 31622.776601683792;
+constexpr double kMinNormSq = 1e-30;  // Keeps inverse norms finite in float
+
+}  // namespace
+
+void PairwiseInfluence::configure(double step_size, double sim_floor) {
+    step_size_ = step_size;
+    floor_ = static_cast<state_t>(sim_floor);
+    floor_scale_ = static_cast<state_t>(1.0 / (1.0 - sim_floor));
+}
+
+void PairwiseInfluence::build(const std::vector<Agent>& agents, double step_size, double sim_floor) {
+    configure(step_size, sim_floor);
+    const std::size_t n = agents.size();
+    nodes_.resize(n + 1);
+    nodes_[n] = Node{};
+    gain_.resize(n);
+
+    const std::int64_t count = static_cast<std::int64_t>(n);
+    #pragma omp parallel for schedule(static)
+    for (std::int64_t ii = 0; ii < count; ++ii) {
+        const std::size_t i = static_cast<std::size_t>(ii);
+        const Agent& agent = agents[i];
+        Node& node = nodes_[i];
+        node.B = agent.B;
+        node.inv_norm = static_cast<state_t>(1.0 / std::sqrt(std::max<double>(agent.B_norm_sq, kMinNormSq)));
+        node.comm = agent.m_comm;
+        node.fluency = static_cast<state_t>(static_cast<double>(agent.fluency));
+        node.lang = agent.alive ? static_cast<state_t>(agent.primaryLang) : state_t(-1);
+        gain_[i] = static_cast<state_t>(step_size * agent.m_susceptibility);
+    }
+}
+
+void PairwiseInfluence::accumulate(std::uint32_t id, const std::uint32_t* neighbors,
+                                   std::uint32_t edge_begin, std::uint32_t edge_end,
+                                   BeliefState& acc, state_t& weight_sum) const {
+    const Node self = nodes_[id];
+    const std::uint32_t dead = static_cast<std::uint32_t>(gain_.size());
+    const state_t near_zero = static_cast<state_t>(kNearZeroInvProduct);
+    const state_t gain = gain_[id];
+
+    for (std::uint32_t e = edge_begin; e < edge_end; ++e) {
+        const Node& other = nodes_[std::min(neighbors[e], dead)];
+        if (other.lang < state_t(0)) continue;  // Dead or out of range
+
+        state_t dot = 0;
+        for (int d = 0; d < kBeliefDims; ++d) dot += self.B[d] * other.B[d];
+        const state_t inv = self.inv_norm * other.inv_norm;
+        const state_t gated = (dot * inv - floor_) * floor_scale_;
+        const state_t gate = inv > near_zero ? state_t(1) : std::max(gated, state_t(0));
+        const state_t lq = other.lang == self.lang ? state_t(0.5) * (self.fluency + other.fluency) : state_t(0.1);
+        const state_t weight = gain * gate * lq * (state_t(0.5) * (self.comm + other.comm));
+        weight_sum += weight;
+
+        // Constant trip count: unrolled and vectorized for the build's dimensionality
+        #pragma omp simd
+        for (int d = 0; d < kBeliefDims; ++d) acc[d] += weight * belief::fastTanh(other.B[d] - self.B[d]);
+    }
+}
+
+void PairwiseInfluence::accumulate(const Agent& self, const EdgeReplicas::Replica* row,
+                                   std::uint32_t edge_begin, std::uint32_t edge_end,
+                                   BeliefState& acc, state_t& weight_sum) const {
+    const state_t gain = static_cast<state_t>(step_size_ * self.m_susceptibility);
+    const state_t norm_sq_i = self.B_norm_sq;
+    const state_t fluency_i = static_cast<state_t>(static_cast<double>(self.fluency));
+    const state_t comm_i = self.m_comm;
+    const std::int16_t lang_i = self.primaryLang;
+
+    for (std::uint32_t e = edge_begin; e < edge_end; ++e) {
+        const EdgeReplicas::Replica& other = row[e];
+        if (!EdgeReplicas::live(other)) continue;
+        const BeliefState B = EdgeReplicas::beliefs(other);
+
+        // Gate on the replica's own norm, as the exact path does on cached norms
+        state_t dot = 0, norm_sq_j = 0;
+        for (int d = 0; d < kBeliefDims; ++d) {
+            dot += self.B[d] * B[d];
+            norm_sq_j += B[d] * B[d];
+        }
+        const state_t norm_prod_sq = norm_sq_i * norm_sq_j;
+        const state_t gate = norm_prod_sq < state_t(1e-9)
+            ? state_t(1) : std::max((dot / std::sqrt(norm_prod_sq) - floor_) * floor_scale_, state_t(0));
+        const state_t fluency_j = static_cast<state_t>(other.fluency * (1.0 / UnitQ16::kScale));
+        const state_t lq = other.lang == lang_i ? state_t(0.5) * (fluency_i + fluency_j) : state_t(0.1);
+        const state_t weight = gain * gate * lq * (state_t(0.5) * (comm_i + static_cast<state_t>(other.comm)));
+        weight_sum += weight;
+
+        #pragma omp simd
+        for (int d = 0; d < kBeliefDims; ++d) acc[d] += weight * belief::fastTanh(B[d] - self.B[d]);
+    }
+}
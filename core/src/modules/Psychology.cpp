@@ -12,13 +12,6 @@ constexpr double kStressShockFloor = 0.05;
 constexpr double kStressShockCeil = 1.5;
 
 // EMERGENT STRESS SENSITIVITY: Personality determines how different stressors affect individuals
-struct StressSensitivity {
-    double economic;      // sensitivity to economic hardship
-    double media;         // sensitivity to negative information
-    double institutional; // sensitivity to institutional failures
-    double disease;       // sensitivity to health threats
-};
-
 StressSensitivity computeStressSensitivity(const Agent& agent) {
     StressSensitivity sens;
     
@@ -41,6 +34,8 @@ StressSensitivity computeStressSensitivity(const Agent& agent) {
 void PsychologyModule::configure(std::uint32_t regionCount, std::uint64_t seed) {
     regional_profiles_.assign(regionCount, {});
     regional_metrics_.assign(regionCount, {});
+    thread_sums_.clear();
+    sensitivities_.clear();
     rng_.seed(seed);
 }
 
@@ -56,13 +51,22 @@ void PsychologyModule::initializeAgents(std::vector<Agent>& agents) {
         psych.recovery_memory = 0.0;
         psych.last_shock_tick = 0;
     }
+    sensitivities_.clear();  // Rebuilt for the new population on the next tick
 }
 
-void PsychologyModule::updateAgents(std::vector<Agent>& agents, const Economy& economy, std::uint64_t tick) {
+void PsychologyModule::updateAgents(std::vector<Agent>& agents, const Economy& economy, std::uint64_t /*tick*/) {
     if (regional_profiles_.empty()) {
         return;
     }
+    beginTick(economy, agents, 1);
+    const auto& econAgents = economy.agents();
+    for (auto& agent : agents) {
+        if (agent.alive) updateAgent(agent, econAgents[agent.id], 0);
+    }
+    finishTick();
+}
 
+void PsychologyModule::beginTick(const Economy& economy, const std::vector<Agent>& agents, std::size_t threads) {
     const std::uint32_t regionCount = static_cast<std::uint32_t>(regional_profiles_.size());
     for (std::uint32_t r = 0; r < regionCount; ++r) {
         const auto& reg = economy.getRegion(r);
@@ -72,71 +76,91 @@ void PsychologyModule::updateAgents(std::vector<Agent>& agents, const Economy& e
         profile.welfare = clamp01(reg.welfare);
         profile.institutional_support = clamp01(reg.efficiency);
         profile.media_negativity = clamp01(1.0 - reg.system_stability);
+    }
 
-        regional_metrics_[r].avg_stress = 0.0;
-        regional_metrics_[r].avg_mental_health = 0.0;
-        regional_metrics_[r].low_mental_health_share = 0.0;
+    // Sensitivities of agents born since the last tick
+    for (std::size_t i = sensitivities_.size(); i < agents.size(); ++i) {
+        sensitivities_.push_back(computeStressSensitivity(agents[i]));
     }
 
-    if (agents.empty()) {
-        return;
+    thread_sums_.resize(std::max<std::size_t>(1, threads));
+    for (auto& sums : thread_sums_) {
+        sums.assign(regionCount, RegionSums{});
     }
+}
 
-    const auto& econAgents = economy.agents();
-    for (auto& agent : agents) {
-        auto& psych = agent.psych;
-        const auto& econRegion = regional_profiles_[agent.region];
-        const auto& agentEcon = econAgents[agent.id];
-
-        // EMERGENT STRESS: Sensitivity varies by personality
-        StressSensitivity sens = computeStressSensitivity(agent);
-        
-        const double economicShock = sens.economic * (0.6 * agentEcon.hardship + 0.4 * econRegion.hardship);
-        const double mediaShock = sens.media * econRegion.media_negativity;
-        const double institutionalShock = sens.institutional * (1.0 - econRegion.institutional_support);
-        const double diseaseShock = sens.disease * agent.health.infected;
-
-        psych.stressors[toIndex(StressSource::EconomicHardship)] = economicShock;
-        psych.stressors[toIndex(StressSource::MediaNegativity)] = mediaShock;
-        psych.stressors[toIndex(StressSource::InstitutionalRigidity)] = institutionalShock;
-        psych.stressors[toIndex(StressSource::DiseaseImpact)] = diseaseShock;
-        psych.stressors[toIndex(StressSource::WarPressure)] = 0.0; // placeholder until war module integration
-
-        double totalShock = economicShock + mediaShock + institutionalShock + diseaseShock;
-        totalShock = std::clamp(totalShock, kStressShockFloor, kStressShockCeil);
-        totalShock *= (1.0 - psych.resilience);
-
-        const double socialSupport = clamp01(0.5 + 0.5 * (1.0 - econRegion.inequality));
-        const double recoveryRate = 0.05 + 0.3 * econRegion.welfare + 0.2 * socialSupport;
-        const double decay = psych.stress_level * psych.stress_level * (1.0 - socialSupport);
+void PsychologyModule::updateAgent(Agent& agent, const AgentEconomy& agentEcon, std::size_t thread, double steps) {
+    auto& psych = agent.psych;
+    const auto& econRegion = regional_profiles_[agent.region];
 
+    // EMERGENT STRESS: Sensitivity varies by personality
+    const StressSensitivity& sens = sensitivities_[agent.id];
+    
+    const double economicShock = sens.economic * (0.6 * agentEcon.hardship + 0.4 * econRegion.hardship);
+    const double mediaShock = sens.media * econRegion.media_negativity;
+    const double institutionalShock = sens.institutional * (1.0 - econRegion.institutional_support);
+    const double diseaseShock = sens.disease * agent.health.infected;
+
+    psych.stressors[toIndex(StressSource::EconomicHardship)] = economicShock;
+    psych.stressors[toIndex(StressSource::MediaNegativity)] = mediaShock;
+    psych.stressors[toIndex(StressSource::InstitutionalRigidity)] = institutionalShock;
+    psych.stressors[toIndex(StressSource::DiseaseImpact)] = diseaseShock;
+    psych.stressors[toIndex(StressSource::WarPressure)] = 0.0; // placeholder until war module integration
+
+    double totalShock = economicShock + mediaShock + institutionalShock + diseaseShock;
+    totalShock = std::clamp(totalShock, kStressShockFloor, kStressShockCeil);
+    totalShock *= (1.0 - psych.resilience);
+
+    const double socialSupport = clamp01(0.5 + 0.5 * (1.0 - econRegion.inequality));
+    const double recoveryRate = 0.05 + 0.3 * econRegion.welfare + 0.2 * socialSupport;
+    const double decay = psych.stress_level * psych.stress_level * (1.0 - socialSupport);
+
+    const double support = psych.resilience * (econRegion.welfare + socialSupport) * 0.25;
+    if (steps == 1.0) {
         psych.stress_level = clamp01(psych.stress_level + totalShock - recoveryRate * (0.5 + psych.mental_health));
-        psych.mental_health = clamp01(psych.mental_health * (1.0 - decay) + psych.resilience * (econRegion.welfare + socialSupport) * 0.25);
-        psych.cognitive_bias = std::clamp(1.0 + 0.5 * (psych.stress_level - 0.5) + 0.3 * (agent.assertiveness - agent.conformity), 0.25, 2.0);
-
-        const double comm = clamp01(1.0 - 0.4 * psych.stress_level + 0.3 * psych.mental_health);
-        const double mobility = clamp01(0.8 + 0.4 * agent.sociality + 0.3 * (psych.mental_health - 0.5) - 0.2 * psych.stress_level);
-        agent.m_comm = comm;
-        agent.m_mobility = std::clamp(mobility, 0.1, 1.5);
-
-        auto& metrics = regional_metrics_[agent.region];
-        metrics.avg_stress += psych.stress_level;
-        metrics.avg_mental_health += psych.mental_health;
-        if (psych.mental_health < 0.3) {
-            metrics.low_mental_health_share += 1.0;
-        }
+        psych.mental_health = clamp01(psych.mental_health * (1.0 - decay) + support);
+    } else {
+        // Stress: one Euler step of length `steps`; mental health: closed form
+        // of its linear recurrence with the decay frozen at the current stress
+        psych.stress_level = clamp01(psych.stress_level + steps * (totalShock - recoveryRate * (0.5 + psych.mental_health)));
+        const double keep = std::pow(1.0 - decay, steps);
+        const double geometric = (decay > 1e-12) ? (1.0 - keep) / decay : steps;
+        psych.mental_health = clamp01(psych.mental_health * keep + support * geometric);
     }
+    psych.cognitive_bias = std::clamp(1.0 + 0.5 * (psych.stress_level - 0.5) + 0.3 * (agent.assertiveness - agent.conformity), 0.25, 2.0);
+
+    const double comm = clamp01(1.0 - 0.4 * psych.stress_level + 0.3 * psych.mental_health);
+    const double mobility = clamp01(0.8 + 0.4 * agent.sociality + 0.3 * (psych.mental_health - 0.5) - 0.2 * psych.stress_level);
+    agent.m_comm = comm;
+    agent.m_mobility = std::clamp(mobility, 0.1, 1.5);
+
+    accumulate(agent, thread);
+}
 
-    // Normalize metrics
-    std::vector<std::uint32_t> regionCounts(regional_profiles_.size(), 0);
-    for (const auto& agent : agents) {
-        regionCounts[agent.region]++;
+void PsychologyModule::accumulate(const Agent& agent, std::size_t thread) {
+    const auto& psych = agent.psych;
+    RegionSums& sums = thread_sums_[thread][agent.region];
+    sums.stress += psych.stress_level;
+    sums.mentalHealth += psych.mental_health;
+    if (psych.mental_health < 0.3) {
+        sums.lowMentalHealth += 1.0;
     }
-    for (std::uint32_t r = 0; r < regionCount; ++r) {
-        const double inv = regionCounts[r] > 0 ? 1.0 / regionCounts[r] : 0.0;
-        regional_metrics_[r].avg_stress *= inv;
-        regional_metrics_[r].avg_mental_health *= inv;
-        regional_metrics_[r].low_mental_health_share *= inv;
+    sums.count++;
+}
+
+void PsychologyModule::finishTick() {
+    for (std::size_t r = 0; r < regional_metrics_.size(); ++r) {
+        RegionSums total;
+        for (const auto& sums : thread_sums_) {
+            total.stress += sums[r].stress;
+            total.mentalHealth += sums[r].mentalHealth;
+            total.lowMentalHealth += sums[r].lowMentalHealth;
+            total.count += sums[r].count;
+        }
+        const double inv = total.count > 0 ? 1.0 / total.count : 0.0;
+        regional_metrics_[r].avg_stress = total.stress * inv;
+        regional_metrics_[r].avg_mental_health = total.mentalHealth * inv;
+        regional_metrics_[r].low_mental_health_share = total.lowMentalHealth * inv;
     }
 }
 
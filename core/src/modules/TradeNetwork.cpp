@@ -4,134 +4,306 @@
 #include <cmath>
 #include <numeric>
 
+namespace {
+    constexpr double TRANSPORT_LOSS = 0.02;  // 2% loss per hop
+    constexpr double CONSERVATION_EPSILON = 1e-6;
+}
+
 void TradeNetwork::configure(std::uint32_t num_regions) {
     num_regions_ = num_regions;
-    laplacian_.assign(num_regions, std::vector<double>(num_regions, 0.0));
-    adjacency_.assign(num_regions, std::vector<std::uint32_t>());
+    row_offsets_.assign(num_regions + 1, 0);
+    columns_.clear();
+    degree_.assign(num_regions, 0);
+    transport_factor_.assign(num_regions, 1.0);
 }
 
 void TradeNetwork::buildTopology(const std::vector<std::vector<std::uint32_t>>& trade_partners) {
-    adjacency_.clear();
-    adjacency_.resize(num_regions_);
-    
-    // Build adjacency from trade partner lists
+    // Laplacian = Degree matrix - Adjacency matrix, stored as CSR
+    row_offsets_.assign(num_regions_ + 1, 0);
+    columns_.clear();
+    degree_.assign(num_regions_, 0);
+    transport_factor_.assign(num_regions_, 1.0);
+
+    std::size_t total_edges = 0;
     for (std::uint32_t i = 0; i < num_regions_ && i < trade_partners.size(); ++i) {
-        adjacency_[i] = trade_partners[i];
+        total_edges += trade_partners[i].size();
+    }
+    columns_.reserve(total_edges);
+
+    for (std::uint32_t i = 0; i < num_regions_; ++i) {
+        if (i < trade_partners.size()) {
+            const auto& partners = trade_partners[i];
+            degree_[i] = static_cast<std::uint32_t>(partners.size());
+            for (auto j : partners) {
+                if (j < num_regions_) {
+                    columns_.push_back(j);
+                }
+            }
+        }
+        row_offsets_[i + 1] = static_cast<std::uint32_t>(columns_.size());
+
+        // Average transport cost based on network degree
+        if (degree_[i] > 0) {
+            double factor = 1.0 - TRANSPORT_LOSS * std::sqrt(static_cast<double>(degree_[i]));
+            transport_factor_[i] = std::max(0.5, factor);  // Cap at 50% loss
+        }
     }
-    
-    computeLaplacian();
+
+    // Symmetrized adjacency: edge {i,j} if either side lists the other
+    std::vector<std::vector<std::uint32_t>> undirected(num_regions_);
+    for (std::uint32_t i = 0; i < num_regions_; ++i) {
+        for (std::uint32_t e = row_offsets_[i]; e < row_offsets_[i + 1]; ++e) {
+            std::uint32_t j = columns_[e];
+            if (j == i) continue;
+            undirected[i].push_back(j);
+            undirected[j].push_back(i);
+        }
+    }
+    sym_offsets_.assign(num_regions_ + 1, 0);
+    sym_columns_.clear();
+    sym_columns_.reserve(2 * columns_.size());
+    for (std::uint32_t i = 0; i < num_regions_; ++i) {
+        auto& row = undirected[i];
+        std::sort(row.begin(), row.end());
+        row.erase(std::unique(row.begin(), row.end()), row.end());
+        sym_columns_.insert(sym_columns_.end(), row.begin(), row.end());
+        sym_offsets_[i + 1] = static_cast<std::uint32_t>(sym_columns_.size());
+    }
+
+    // Topology changed: previous equilibrium is no longer a valid warm start
+    warm_flows_.clear();
 }
 
-void TradeNetwork::computeLaplacian() {
-    // Reset Laplacian
-    for (auto& row : laplacian_) {
-        std::fill(row.begin(), row.end(), 0.0);
+void TradeNetwork::computeFlows(const std::vector<GoodBlock>& surplus,
+                                std::vector<GoodBlock>& flows,
+                                double diffusion_rate) const {
+    if (flows.size() != num_regions_) {
+        flows.resize(num_regions_);
     }
-    
-    // Laplacian = Degree matrix - Adjacency matrix
+
+    GoodBlock total_flow{};
+
+    // SWEEP: gradient = L · surplus for all goods at once, then clamp
     for (std::uint32_t i = 0; i < num_regions_; ++i) {
-        int degree = static_cast<int>(adjacency_[i].size());
-        laplacian_[i][i] = static_cast<double>(degree);
-        
-        // Off-diagonal: -1 for each edge
-        for (auto j : adjacency_[i]) {
-            if (j < num_regions_) {
-                laplacian_[i][j] = -1.0;
+        const GoodBlock& q = surplus[i];
+        const double deg = static_cast<double>(degree_[i]);
+
+        GoodBlock gradient;
+        #pragma omp simd
+        for (int g = 0; g < kGoodTypes; ++g) {
+            gradient[g] = deg * q[g];
+        }
+        for (std::uint32_t e = row_offsets_[i]; e < row_offsets_[i + 1]; ++e) {
+            const GoodBlock& qj = surplus[columns_[e]];
+            #pragma omp simd
+            for (int g = 0; g < kGoodTypes; ++g) {
+                gradient[g] -= qj[g];
+            }
+        }
+
+        GoodBlock& out = flows[i];
+        for (int g = 0; g < kGoodTypes; ++g) {
+            // Flow = -k * gradient (negative sign makes flow go down gradient)
+            double flow = -diffusion_rate * gradient[g];
+
+            // Constrain flow to available surplus
+            if (flow > 0.0) {
+                flow = std::min(flow, std::max(0.0, q[g]));
+            } else {
+                // Limit by available exports in network
+                // (This is implicitly handled by the flow conservation property of Laplacian)
+                flow = std::max(flow, q[g]);
             }
+
+            out[g] = flow;
+            total_flow[g] += flow;
         }
     }
+
+    finishFlows(flows, total_flow);
 }
 
-void TradeNetwork::matrixVectorMultiply(const std::vector<double>& vec, 
-                                         std::vector<double>& result) const {
-    // result = L · vec
-    result.assign(num_regions_, 0.0);
-    
+void TradeNetwork::finishFlows(std::vector<GoodBlock>& flows, const GoodBlock& total_flow) const {
+    // Normalize flows to ensure conservation (exports = imports globally):
+    // any net imbalance from clamping is spread evenly over all regions
+    GoodBlock correction{};
+    for (int g = 0; g < kGoodTypes; ++g) {
+        if (std::abs(total_flow[g]) > CONSERVATION_EPSILON) {
+            correction[g] = -total_flow[g] / num_regions_;
+        }
+    }
+
+    // Conservation correction + transport loss in one pass.
+    // Scaling by a positive factor preserves sign, so sign·|f|·t == f·t.
     for (std::uint32_t i = 0; i < num_regions_; ++i) {
-        double sum = 0.0;
-        for (std::uint32_t j = 0; j < num_regions_; ++j) {
-            sum += laplacian_[i][j] * vec[j];
+        const double factor = transport_factor_[i];
+        GoodBlock& out = flows[i];
+        #pragma omp simd
+        for (int g = 0; g < kGoodTypes; ++g) {
+            out[g] = (out[g] + correction[g]) * factor;
         }
-        result[i] = sum;
     }
 }
 
-std::vector<std::array<double, kGoodTypes>> TradeNetwork::computeFlows(
-    const std::vector<std::array<double, kGoodTypes>>& production,
-    const std::vector<std::array<double, kGoodTypes>>& demand,
+std::vector<TradeNetwork::GoodBlock> TradeNetwork::computeFlows(
+    const std::vector<GoodBlock>& production,
+    const std::vector<GoodBlock>& demand,
     const std::vector<std::uint32_t>& population,
     double diffusion_rate
-) {
-    std::vector<std::array<double, kGoodTypes>> trade_balance(num_regions_);
-    
-    // Initialize to zero
-    for (auto& bal : trade_balance) {
-        bal.fill(0.0);
+) const {
+    (void)population;
+
+    std::vector<GoodBlock> surplus(num_regions_);
+    for (std::uint32_t i = 0; i < num_regions_; ++i) {
+        for (int g = 0; g < kGoodTypes; ++g) {
+            surplus[i][g] = production[i][g] - demand[i][g];
+        }
     }
-    
-    // Process each good type independently
-    for (int g = 0; g < kGoodTypes; ++g) {
-        // Build surplus vector: q[i] = production[i][g] - demand[i][g]
-        std::vector<double> surplus(num_regions_);
-        for (std::uint32_t i = 0; i < num_regions_; ++i) {
-            surplus[i] = production[i][g] - demand[i][g];
-        }
-        
-        // Compute flow gradient: Δq = -k(L · surplus)
-        std::vector<double> gradient;
-        matrixVectorMultiply(surplus, gradient);
-        
-        // Apply diffusion: flow from high surplus to low surplus
-        // Negative gradient means flow inward (imports)
-        // Positive gradient means flow outward (exports)
-        for (std::uint32_t i = 0; i < num_regions_; ++i) {
-            // Flow = -k * gradient (negative sign makes flow go down gradient)
-            double flow = -diffusion_rate * gradient[i];
-            
-            // Constrain flow to available surplus (can't export more than you have)
-            if (flow > 0.0) {  // Exporting
-                flow = std::min(flow, std::max(0.0, surplus[i]));
-            } else {  // Importing
-                // Limit imports by available exports in network
-                // (This is implicitly handled by the flow conservation property of Laplacian)
-                flow = std::max(flow, surplus[i]);
+
+    std::vector<GoodBlock> trade_balance;
+    computeFlows(surplus, trade_balance, diffusion_rate);
+    return trade_balance;
+}
+
+void TradeNetwork::applyEquilibriumOperator(const std::vector<GoodBlock>& in,
+                                            std::vector<GoodBlock>& out) const {
+    // out = (I + τ·L_s) · in, all goods per row traversal
+    const double tau = solver_config_.horizon;
+    const std::int64_t n = static_cast<std::int64_t>(num_regions_);
+
+    #pragma omp parallel for schedule(static) if(n >= 4096)
+    for (std::int64_t ii = 0; ii < n; ++ii) {
+        const auto i = static_cast<std::uint32_t>(ii);
+        const double diag = 1.0 + tau * static_cast<double>(sym_offsets_[i + 1] - sym_offsets_[i]);
+        GoodBlock acc;
+        #pragma omp simd
+        for (int g = 0; g < kGoodTypes; ++g) {
+            acc[g] = diag * in[i][g];
+        }
+        for (std::uint32_t e = sym_offsets_[i]; e < sym_offsets_[i + 1]; ++e) {
+            const GoodBlock& v = in[sym_columns_[e]];
+            #pragma omp simd
+            for (int g = 0; g < kGoodTypes; ++g) {
+                acc[g] -= tau * v[g];
+            }
+        }
+        out[i] = acc;
+    }
+}
+
+void TradeNetwork::computeEquilibriumFlows(const std::vector<GoodBlock>& surplus,
+                                           std::vector<GoodBlock>& flows) {
+    const std::uint32_t R = num_regions_;
+    const double tau = solver_config_.horizon;
+    if (flows.size() != R) {
+        flows.resize(R);
+    }
+    cg_x_.resize(R);
+    cg_r_.resize(R);
+    cg_z_.resize(R);
+    cg_p_.resize(R);
+    cg_ap_.resize(R);
+
+    last_stats_ = TradeSolveStats{};
+    last_stats_.warmStarted = (warm_flows_.size() == R);
+
+    // Initial guess: this tick's surplus shifted by last tick's settled flows
+    for (std::uint32_t i = 0; i < R; ++i) {
+        for (int g = 0; g < kGoodTypes; ++g) {
+            cg_x_[i][g] = surplus[i][g] + (last_stats_.warmStarted ? warm_flows_[i][g] : 0.0);
+        }
+    }
+
+    // r = b - A·x, z = M⁻¹·r (Jacobi), p = z
+    applyEquilibriumOperator(cg_x_, cg_ap_);
+    GoodBlock rz{}, b_norm_sq{};
+    for (std::uint32_t i = 0; i < R; ++i) {
+        const double inv_diag = 1.0 / (1.0 + tau * static_cast<double>(sym_offsets_[i + 1] - sym_offsets_[i]));
+        for (int g = 0; g < kGoodTypes; ++g) {
+            cg_r_[i][g] = surplus[i][g] - cg_ap_[i][g];
+            cg_z_[i][g] = cg_r_[i][g] * inv_diag;
+            cg_p_[i][g] = cg_z_[i][g];
+            rz[g] += cg_r_[i][g] * cg_z_[i][g];
+            b_norm_sq[g] += surplus[i][g] * surplus[i][g];
+        }
+    }
+
+    auto relativeResidual = [&]() {
+        GoodBlock r_norm_sq{};
+        for (std::uint32_t i = 0; i < R; ++i) {
+            for (int g = 0; g < kGoodTypes; ++g) {
+                r_norm_sq[g] += cg_r_[i][g] * cg_r_[i][g];
+            }
+        }
+        double worst = 0.0;
+        for (int g = 0; g < kGoodTypes; ++g) {
+            double scale = (b_norm_sq[g] > 0.0) ? b_norm_sq[g] : 1.0;
+            worst = std::max(worst, std::sqrt(r_norm_sq[g] / scale));
+        }
+        return worst;
+    };
+
+    double residual = relativeResidual();
+    int iterations = 0;
+    while (residual > solver_config_.tolerance && iterations < solver_config_.maxIterations) {
+        applyEquilibriumOperator(cg_p_, cg_ap_);
+
+        GoodBlock p_ap{};
+        for (std::uint32_t i = 0; i < R; ++i) {
+            for (int g = 0; g < kGoodTypes; ++g) {
+                p_ap[g] += cg_p_[i][g] * cg_ap_[i][g];
             }
-            
-            trade_balance[i][g] = flow;
-        }
-        
-        // Normalize flows to ensure conservation (exports = imports globally)
-        double total_flow = 0.0;
-        for (std::uint32_t i = 0; i < num_regions_; ++i) {
-            total_flow += trade_balance[i][g];
-        }
-        
-        // If there's a net imbalance (numerical error), distribute it proportionally
-        if (std::abs(total_flow) > 1e-6) {
-            double correction = -total_flow / num_regions_;
-            for (std::uint32_t i = 0; i < num_regions_; ++i) {
-                trade_balance[i][g] += correction;
+        }
+        GoodBlock alpha{};
+        for (int g = 0; g < kGoodTypes; ++g) {
+            alpha[g] = (p_ap[g] > 0.0) ? rz[g] / p_ap[g] : 0.0;  // converged goods stall at 0
+        }
+
+        for (std::uint32_t i = 0; i < R; ++i) {
+            for (int g = 0; g < kGoodTypes; ++g) {
+                cg_x_[i][g] += alpha[g] * cg_p_[i][g];
+                cg_r_[i][g] -= alpha[g] * cg_ap_[i][g];
+            }
+        }
+        ++iterations;
+
+        residual = relativeResidual();
+        if (residual <= solver_config_.tolerance) break;
+
+        GoodBlock rz_next{};
+        for (std::uint32_t i = 0; i < R; ++i) {
+            const double inv_diag = 1.0 / (1.0 + tau * static_cast<double>(sym_offsets_[i + 1] - sym_offsets_[i]));
+            for (int g = 0; g < kGoodTypes; ++g) {
+                cg_z_[i][g] = cg_r_[i][g] * inv_diag;
+                rz_next[g] += cg_r_[i][g] * cg_z_[i][g];
+            }
+        }
+        for (int g = 0; g < kGoodTypes; ++g) {
+            double beta = (rz[g] > 0.0) ? rz_next[g] / rz[g] : 0.0;
+            rz[g] = rz_next[g];
+            for (std::uint32_t i = 0; i < R; ++i) {
+                cg_p_[i][g] = cg_z_[i][g] + beta * cg_p_[i][g];
             }
         }
     }
-    
-    // Apply transport costs (reduce flow efficiency)
-    constexpr double TRANSPORT_LOSS = 0.02;  // 2% loss per hop
-    for (std::uint32_t i = 0; i < num_regions_; ++i) {
-        int num_partners = static_cast<int>(adjacency_[i].size());
-        if (num_partners == 0) continue;
-        
-        // Average transport cost based on network degree
-        double transport_factor = 1.0 - TRANSPORT_LOSS * std::sqrt(num_partners);
-        transport_factor = std::max(0.5, transport_factor);  // Cap at 50% loss
-        
+
+    last_stats_.iterations = iterations;
+    last_stats_.residual = residual;
+    last_stats_.converged = (residual <= solver_config_.tolerance);
+
+    // Raw equilibrium flow = settled surplus - initial surplus (kept for warm start).
+    // Exporters cannot ship more than they actually have.
+    warm_flows_.resize(R);
+    GoodBlock total_flow{};
+    for (std::uint32_t i = 0; i < R; ++i) {
         for (int g = 0; g < kGoodTypes; ++g) {
-            // Reduce absolute flow by transport costs
-            double flow_magnitude = std::abs(trade_balance[i][g]);
-            double sign = (trade_balance[i][g] >= 0.0) ? 1.0 : -1.0;
-            trade_balance[i][g] = sign * flow_magnitude * transport_factor;
+            double flow = cg_x_[i][g] - surplus[i][g];
+            warm_flows_[i][g] = flow;
+            flow = std::max(flow, -std::max(0.0, surplus[i][g]));
+            flows[i][g] = flow;
+            total_flow[g] += flow;
         }
     }
-    
-    return trade_balance;
+
+    finishFlows(flows, total_flow);
 }
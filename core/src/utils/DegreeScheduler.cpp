@@ -0,0 +1,62 @@
+#include "utils/DegreeScheduler.h"
+#include <algorithm>
+#include <numeric>
+
+double SchedulerLoad::imbalance() const {
+    if (seconds.empty()) return 1.0;
+    const double total = std::accumulate(seconds.begin(), seconds.end(), 0.0);
+    const double mean = total / static_cast<double>(seconds.size());
+    if (mean <= 0.0) return 1.0;
+    return *std::max_element(seconds.begin(), seconds.end()) / mean;
+}
+
+void DegreeScheduler::partition() {
+    tasks_.clear();
+    splits_.clear();
+    slots_ = 0;
+
+    const std::size_t items = offsets_.size() - 1;
+    const std::uint64_t total = offsets_[items];
+    if (total == 0) return;
+    const std::uint64_t target = std::max<std::uint64_t>(kMinTaskCost, (total + kTargetTasks - 1) / kTargetTasks);
+
+    // Item containing cost position `pos` (pos < total)
+    auto itemAt = [&](std::uint64_t pos) {
+        return static_cast<std::uint32_t>(
+            std::upper_bound(offsets_.begin(), offsets_.end(), pos) - offsets_.begin() - 1);
+    };
+    auto assignSlot = [&](std::uint32_t id) {
+        const auto slot = static_cast<std::uint32_t>(slots_++);
+        if (splits_.empty() || splits_.back().id != id) {
+            splits_.push_back({id, slot, slot + 1});
+        } else {
+            splits_.back().slot_end = slot + 1;
+        }
+        return static_cast<std::int32_t>(slot);
+    };
+
+    std::uint64_t pos = 0;
+    while (pos < total) {
+        std::uint64_t end = std::min(total, pos + target);
+        if (end < total) {
+            // Snap to the nearest item boundary unless the item is a hub
+            const std::uint32_t j = itemAt(end);
+            const std::uint64_t lo = offsets_[j], hi = offsets_[j + 1];
+            if (hi - lo <= target && end != lo) {
+                end = (end - lo < hi - end && lo > pos) ? lo : hi;
+            }
+        }
+
+        Task task{pos, end, itemAt(pos), -1, -1};
+        const std::uint32_t last = itemAt(end - 1);
+        const bool firstPartial = pos > offsets_[task.first] || end < offsets_[task.first + 1];
+        if (firstPartial) task.first_slot = assignSlot(task.first);
+        if (last == task.first) {
+            task.last_slot = task.first_slot;
+        } else if (end < offsets_[last + 1]) {
+            task.last_slot = assignSlot(last);
+        }
+        tasks_.push_back(task);
+        pos = end;
+    }
+}
@@ -0,0 +1,399 @@
+#include "utils/MembershipBitmap.h"
+#include <algorithm>
+#include <iterator>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace {
+
+inline int popcount64(std::uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#elif defined(_MSC_VER)
+    return static_cast<int>(__popcnt64(x));
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<int>((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+inline int countTrailingZeros64(std::uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    return popcount64((x & (~x + 1)) - 1);
+#endif
+}
+
+inline bool testBit(const std::vector<std::uint64_t>& words, std::uint16_t low) {
+    return (words[low >> 6] >> (low & 63)) & 1ULL;
+}
+
+}  // namespace
+
+// --- Container ---
+
+bool MembershipBitmap::Container::contains(std::uint16_t low) const {
+    if (isBitmap()) return testBit(words, low);
+    return std::binary_search(array.begin(), array.end(), low);
+}
+
+void MembershipBitmap::Container::toBitmap() {
+    if (isBitmap()) return;
+    words.assign(kWords, 0);
+    for (auto low : array) {
+        words[low >> 6] |= 1ULL << (low & 63);
+    }
+    array.clear();
+    array.shrink_to_fit();
+}
+
+void MembershipBitmap::Container::normalize() {
+    if (!isBitmap() || card > kArrayMax) return;
+    array.clear();
+    array.reserve(card);
+    for (std::size_t w = 0; w < kWords; ++w) {
+        std::uint64_t bits = words[w];
+        while (bits) {
+            array.push_back(static_cast<std::uint16_t>(w * 64 + countTrailingZeros64(bits)));
+            bits &= bits - 1;
+        }
+    }
+    words.clear();
+    words.shrink_to_fit();
+}
+
+// --- Construction and point operations ---
+
+MembershipBitmap MembershipBitmap::fromSorted(const std::vector<std::uint32_t>& ids) {
+    MembershipBitmap out;
+    std::size_t i = 0;
+    while (i < ids.size()) {
+        const std::uint16_t key = static_cast<std::uint16_t>(ids[i] >> 16);
+        std::size_t j = i;
+        while (j < ids.size() && (ids[j] >> 16) == key) ++j;
+
+        Container c;
+        c.key = key;
+        c.card = static_cast<std::uint32_t>(j - i);
+        if (c.card > kArrayMax) {
+            c.words.assign(kWords, 0);
+            for (std::size_t s = i; s < j; ++s) {
+                const std::uint16_t low = static_cast<std::uint16_t>(ids[s] & 0xFFFF);
+                c.words[low >> 6] |= 1ULL << (low & 63);
+            }
+        } else {
+            c.array.reserve(c.card);
+            for (std::size_t s = i; s < j; ++s) {
+                c.array.push_back(static_cast<std::uint16_t>(ids[s] & 0xFFFF));
+            }
+        }
+        out.containers_.push_back(std::move(c));
+        i = j;
+    }
+    return out;
+}
+
+std::size_t MembershipBitmap::findContainer(std::uint16_t key) const {
+    auto it = std::lower_bound(containers_.begin(), containers_.end(), key,
+                               [](const Container& c, std::uint16_t k) { return c.key < k; });
+    return static_cast<std::size_t>(it - containers_.begin());
+}
+
+void MembershipBitmap::add(std::uint32_t id) {
+    const std::uint16_t key = static_cast<std::uint16_t>(id >> 16);
+    const std::uint16_t low = static_cast<std::uint16_t>(id & 0xFFFF);
+    std::size_t idx = findContainer(key);
+    if (idx == containers_.size() || containers_[idx].key != key) {
+        Container c;
+        c.key = key;
+        containers_.insert(containers_.begin() + static_cast<std::ptrdiff_t>(idx), std::move(c));
+    }
+    Container& c = containers_[idx];
+    if (c.isBitmap()) {
+        std::uint64_t& word = c.words[low >> 6];
+        const std::uint64_t bit = 1ULL << (low & 63);
+        if (!(word & bit)) {
+            word |= bit;
+            ++c.card;
+        }
+        return;
+    }
+    auto it = std::lower_bound(c.array.begin(), c.array.end(), low);
+    if (it != c.array.end() && *it == low) return;
+    c.array.insert(it, low);
+    ++c.card;
+    if (c.card > kArrayMax) c.toBitmap();
+}
+
+bool MembershipBitmap::remove(std::uint32_t id) {
+    const std::uint16_t key = static_cast<std::uint16_t>(id >> 16);
+    const std::uint16_t low = static_cast<std::uint16_t>(id & 0xFFFF);
+    std::size_t idx = findContainer(key);
+    if (idx == containers_.size() || containers_[idx].key != key) return false;
+    Container& c = containers_[idx];
+    if (c.isBitmap()) {
+        std::uint64_t& word = c.words[low >> 6];
+        const std::uint64_t bit = 1ULL << (low & 63);
+        if (!(word & bit)) return false;
+        word &= ~bit;
+        --c.card;
+        c.normalize();
+    } else {
+        auto it = std::lower_bound(c.array.begin(), c.array.end(), low);
+        if (it == c.array.end() || *it != low) return false;
+        c.array.erase(it);
+        --c.card;
+    }
+    if (c.card == 0) containers_.erase(containers_.begin() + static_cast<std::ptrdiff_t>(idx));
+    return true;
+}
+
+bool MembershipBitmap::contains(std::uint32_t id) const {
+    const std::uint16_t key = static_cast<std::uint16_t>(id >> 16);
+    std::size_t idx = findContainer(key);
+    if (idx == containers_.size() || containers_[idx].key != key) return false;
+    return containers_[idx].contains(static_cast<std::uint16_t>(id & 0xFFFF));
+}
+
+std::size_t MembershipBitmap::cardinality() const {
+    std::size_t total = 0;
+    for (const auto& c : containers_) total += c.card;
+    return total;
+}
+
+std::vector<std::uint32_t> MembershipBitmap::toVector() const {
+    std::vector<std::uint32_t> out;
+    out.reserve(cardinality());
+    for (const auto& c : containers_) {
+        const std::uint32_t high = static_cast<std::uint32_t>(c.key) << 16;
+        if (!c.isBitmap()) {
+            for (auto low : c.array) out.push_back(high | low);
+            continue;
+        }
+        for (std::size_t w = 0; w < kWords; ++w) {
+            std::uint64_t bits = c.words[w];
+            while (bits) {
+                out.push_back(high | static_cast<std::uint32_t>(w * 64 + countTrailingZeros64(bits)));
+                bits &= bits - 1;
+            }
+        }
+    }
+    return out;
+}
+
+std::size_t MembershipBitmap::bytes() const {
+    std::size_t total = containers_.capacity() * sizeof(Container);
+    for (const auto& c : containers_) {
+        total += c.array.capacity() * sizeof(std::uint16_t) + c.words.capacity() * sizeof(std::uint64_t);
+    }
+    return total;
+}
+
+bool MembershipBitmap::operator==(const MembershipBitmap& other) const {
+    if (containers_.size() != other.containers_.size()) return false;
+    for (std::size_t i = 0; i < containers_.size(); ++i) {
+        const Container& a = containers_[i];
+        const Container& b = other.containers_[i];
+        // Form is a function of cardinality, so equal sets share a form
+        if (a.key != b.key || a.card != b.card || a.array != b.array || a.words != b.words) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// --- Container algebra ---
+
+std::size_t MembershipBitmap::andCardinality(const Container& a, const Container& b) {
+    if (a.isBitmap() && b.isBitmap()) {
+        std::size_t card = 0;
+        const std::uint64_t* x = a.words.data();
+        const std::uint64_t* y = b.words.data();
+        #pragma omp simd reduction(+:card)
+        for (std::size_t w = 0; w < kWords; ++w) {
+            card += static_cast<std::size_t>(popcount64(x[w] & y[w]));
+        }
+        return card;
+    }
+    if (a.isBitmap() || b.isBitmap()) {
+        const Container& arr = a.isBitmap() ? b : a;
+        const Container& bmp = a.isBitmap() ? a : b;
+        std::size_t card = 0;
+        for (auto low : arr.array) card += testBit(bmp.words, low) ? 1 : 0;
+        return card;
+    }
+    // Branch-free merge: interleaved IDs make the comparisons unpredictable
+    std::size_t card = 0;
+    const std::uint16_t* x = a.array.data();
+    const std::uint16_t* y = b.array.data();
+    const std::size_t nx = a.array.size();
+    const std::size_t ny = b.array.size();
+    std::size_t i = 0, j = 0;
+    while (i < nx && j < ny) {
+        const std::uint16_t u = x[i];
+        const std::uint16_t v = y[j];
+        card += (u == v);
+        i += (u <= v);
+        j += (v <= u);
+    }
+    return card;
+}
+
+MembershipBitmap::Container MembershipBitmap::combine(const Container& a, const Container& b, Op op) {
+    Container out;
+    out.key = a.key;
+
+    // Array ∘ array: sorted merges
+    if (!a.isBitmap() && !b.isBitmap()) {
+        auto sink = std::back_inserter(out.array);
+        switch (op) {
+            case Op::And:
+                std::set_intersection(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), sink);
+                break;
+            case Op::Or:
+                std::set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), sink);
+                break;
+            case Op::AndNot:
+                std::set_difference(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(), sink);
+                break;
+        }
+        out.card = static_cast<std::uint32_t>(out.array.size());
+        if (out.card > kArrayMax) out.toBitmap();
+        return out;
+    }
+
+    // Array ∩ bitmap and array \ bitmap: probe, result stays an array
+    if (!a.isBitmap() && (op == Op::And || op == Op::AndNot)) {
+        const bool keep = (op == Op::And);
+        for (auto low : a.array) {
+            if (testBit(b.words, low) == keep) out.array.push_back(low);
+        }
+        out.card = static_cast<std::uint32_t>(out.array.size());
+        return out;
+    }
+    if (!b.isBitmap() && op == Op::And) {
+        return combine(b, a, op);
+    }
+
+    // Otherwise work on words (an array operand is expanded once)
+    Container expandedA, expandedB;
+    const Container* pa = &a;
+    const Container* pb = &b;
+    if (!a.isBitmap()) { expandedA = a; expandedA.toBitmap(); pa = &expandedA; }
+    if (!b.isBitmap()) { expandedB = b; expandedB.toBitmap(); pb = &expandedB; }
+
+    out.words.assign(kWords, 0);
+    const std::uint64_t* x = pa->words.data();
+    const std::uint64_t* y = pb->words.data();
+    std::uint64_t* r = out.words.data();
+    std::size_t card = 0;
+    switch (op) {
+        case Op::And:
+            #pragma omp simd reduction(+:card)
+            for (std::size_t w = 0; w < kWords; ++w) {
+                r[w] = x[w] & y[w];
+                card += static_cast<std::size_t>(popcount64(r[w]));
+            }
+            break;
+        case Op::Or:
+            #pragma omp simd reduction(+:card)
+            for (std::size_t w = 0; w < kWords; ++w) {
+                r[w] = x[w] | y[w];
+                card += static_cast<std::size_t>(popcount64(r[w]));
+            }
+            break;
+        case Op::AndNot:
+            #pragma omp simd reduction(+:card)
+            for (std::size_t w = 0; w < kWords; ++w) {
+                r[w] = x[w] & ~y[w];
+                card += static_cast<std::size_t>(popcount64(r[w]));
+            }
+            break;
+    }
+    out.card = static_cast<std::uint32_t>(card);
+    out.normalize();
+    return out;
+}
+
+// --- Set algebra ---
+
+std::size_t MembershipBitmap::andCardinality(const MembershipBitmap& a, const MembershipBitmap& b) {
+    std::size_t card = 0;
+    std::size_t i = 0, j = 0;
+    while (i < a.containers_.size() && j < b.containers_.size()) {
+        const Container& ca = a.containers_[i];
+        const Container& cb = b.containers_[j];
+        if (ca.key < cb.key) {
+            ++i;
+        } else if (cb.key < ca.key) {
+            ++j;
+        } else {
+            card += andCardinality(ca, cb);
+            ++i;
+            ++j;
+        }
+    }
+    return card;
+}
+
+MembershipBitmap MembershipBitmap::andOf(const MembershipBitmap& a, const MembershipBitmap& b) {
+    MembershipBitmap out;
+    std::size_t i = 0, j = 0;
+    while (i < a.containers_.size() && j < b.containers_.size()) {
+        const Container& ca = a.containers_[i];
+        const Container& cb = b.containers_[j];
+        if (ca.key < cb.key) {
+            ++i;
+        } else if (cb.key < ca.key) {
+            ++j;
+        } else {
+            Container c = combine(ca, cb, Op::And);
+            if (c.card > 0) out.containers_.push_back(std::move(c));
+            ++i;
+            ++j;
+        }
+    }
+    return out;
+}
+
+MembershipBitmap MembershipBitmap::orOf(const MembershipBitmap& a, const MembershipBitmap& b) {
+    MembershipBitmap out;
+    std::size_t i = 0, j = 0;
+    while (i < a.containers_.size() || j < b.containers_.size()) {
+        if (j == b.containers_.size() ||
+            (i < a.containers_.size() && a.containers_[i].key < b.containers_[j].key)) {
+            out.containers_.push_back(a.containers_[i++]);
+        } else if (i == a.containers_.size() || b.containers_[j].key < a.containers_[i].key) {
+            out.containers_.push_back(b.containers_[j++]);
+        } else {
+            out.containers_.push_back(combine(a.containers_[i++], b.containers_[j++], Op::Or));
+        }
+    }
+    return out;
+}
+
+MembershipBitmap MembershipBitmap::andNotOf(const MembershipBitmap& a, const MembershipBitmap& b) {
+    MembershipBitmap out;
+    std::size_t j = 0;
+    for (const Container& ca : a.containers_) {
+        while (j < b.containers_.size() && b.containers_[j].key < ca.key) ++j;
+        if (j < b.containers_.size() && b.containers_[j].key == ca.key) {
+            Container c = combine(ca, b.containers_[j], Op::AndNot);
+            if (c.card > 0) out.containers_.push_back(std::move(c));
+        } else {
+            out.containers_.push_back(ca);
+        }
+    }
+    return out;
+}
+
+double MembershipBitmap::jaccard(const MembershipBitmap& a, const MembershipBitmap& b) {
+    const std::size_t inter = andCardinality(a, b);
+    const std::size_t uni = a.cardinality() + b.cardinality() - inter;
+    return uni == 0 ? 0.0 : static_cast<double>(inter) / static_cast<double>(uni);
+}
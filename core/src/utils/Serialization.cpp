@@ -24,23 +24,23 @@ void writeAgent(std::ofstream& out, const Agent& agent) {
     // Language
     writeBinary(out, agent.primaryLang);
     writeBinary(out, agent.dialect);
-    writeBinary(out, agent.fluency);
+    writeReal(out, agent.fluency);
     
     // Personality
-    writeBinary(out, agent.openness);
-    writeBinary(out, agent.conformity);
-    writeBinary(out, agent.assertiveness);
-    writeBinary(out, agent.sociality);
+    writeReal(out, agent.openness);
+    writeReal(out, agent.conformity);
+    writeReal(out, agent.assertiveness);
+    writeReal(out, agent.sociality);
     
     // Beliefs
-    writeBinaryArray(out, agent.x);
-    writeBinaryArray(out, agent.B);
-    writeBinary(out, agent.B_norm_sq);
+    writeRealArray(out, agent.x);
+    writeRealArray(out, agent.B);
+    writeReal(out, agent.B_norm_sq);
     
     // Multipliers
-    writeBinary(out, agent.m_comm);
-    writeBinary(out, agent.m_susceptibility);
-    writeBinary(out, agent.m_mobility);
+    writeReal(out, agent.m_comm);
+    writeReal(out, agent.m_susceptibility);
+    writeReal(out, agent.m_mobility);
     
     // Neighbors
     writeBinaryVector(out, agent.neighbors);
@@ -64,23 +64,23 @@ void readAgent(std::ifstream& in, Agent& agent) {
     // Language
     readBinary(in, agent.primaryLang);
     readBinary(in, agent.dialect);
-    readBinary(in, agent.fluency);
+    readReal(in, agent.fluency);
     
     // Personality
-    readBinary(in, agent.openness);
-    readBinary(in, agent.conformity);
-    readBinary(in, agent.assertiveness);
-    readBinary(in, agent.sociality);
+    readReal(in, agent.openness);
+    readReal(in, agent.conformity);
+    readReal(in, agent.assertiveness);
+    readReal(in, agent.sociality);
     
     // Beliefs
-    readBinaryArray(in, agent.x);
-    readBinaryArray(in, agent.B);
-    readBinary(in, agent.B_norm_sq);
+    readRealArray(in, agent.x);
+    readRealArray(in, agent.B);
+    readReal(in, agent.B_norm_sq);
     
     // Multipliers
-    readBinary(in, agent.m_comm);
-    readBinary(in, agent.m_susceptibility);
-    readBinary(in, agent.m_mobility);
+    readReal(in, agent.m_comm);
+    readReal(in, agent.m_susceptibility);
+    readReal(in, agent.m_mobility);
     
     // Neighbors
     readBinaryVector(in, agent.neighbors);
@@ -128,7 +128,7 @@ bool saveCheckpoint(const Kernel& kernel, const std::string& filepath) {
             writeBinary(out, region.hardship);
             writeBinary(out, region.efficiency);
             writeBinary(out, region.system_stability);
-            writeBinaryString(out, region.economic_system);
+            writeBinary(out, static_cast<std::uint8_t>(region.economic_system));
             writeBinaryArray(out, region.production);
             writeBinaryArray(out, region.prices);
         }
@@ -0,0 +1,132 @@
+#include "utils/SpatialIndex.h"
+#include <algorithm>
+#include <cmath>
+
+void SpatialGridIndex::build(const std::vector<Point>& points, double cell_size) {
+    points_ = points;
+    cell_size_ = (cell_size > 0.0) ? cell_size : 1.0;
+
+    if (points_.empty()) {
+        cells_x_ = cells_y_ = 0;
+        cell_start_.assign(1, 0);
+        cell_points_.clear();
+        return;
+    }
+
+    double max_x = points_[0][0], max_y = points_[0][1];
+    min_x_ = points_[0][0];
+    min_y_ = points_[0][1];
+    for (const auto& p : points_) {
+        min_x_ = std::min(min_x_, p[0]);
+        min_y_ = std::min(min_y_, p[1]);
+        max_x = std::max(max_x, p[0]);
+        max_y = std::max(max_y, p[1]);
+    }
+    cells_x_ = static_cast<int>((max_x - min_x_) / cell_size_) + 1;
+    cells_y_ = static_cast<int>((max_y - min_y_) / cell_size_) + 1;
+
+    // Counting sort points into cells (stable: ascending index within a cell)
+    const std::size_t num_cells = static_cast<std::size_t>(cells_x_) * cells_y_;
+    cell_start_.assign(num_cells + 1, 0);
+    std::vector<std::uint32_t> cell_of(points_.size());
+    for (std::size_t i = 0; i < points_.size(); ++i) {
+        int cx = cellCoord(points_[i][0], min_x_, cells_x_);
+        int cy = cellCoord(points_[i][1], min_y_, cells_y_);
+        cell_of[i] = static_cast<std::uint32_t>(cy * cells_x_ + cx);
+        cell_start_[cell_of[i] + 1]++;
+    }
+    for (std::size_t c = 0; c < num_cells; ++c) {
+        cell_start_[c + 1] += cell_start_[c];
+    }
+    cell_points_.resize(points_.size());
+    std::vector<std::uint32_t> fill(cell_start_.begin(), cell_start_.end() - 1);
+    for (std::size_t i = 0; i < points_.size(); ++i) {
+        cell_points_[fill[cell_of[i]]++] = static_cast<std::uint32_t>(i);
+    }
+}
+
+int SpatialGridIndex::cellCoord(double v, double origin, int cells) const {
+    int c = static_cast<int>(std::floor((v - origin) / cell_size_));
+    return std::clamp(c, 0, cells - 1);
+}
+
+template <typename Visitor>
+void SpatialGridIndex::visitRing(int cx, int cy, int ring, Visitor&& visit) const {
+    auto visitCell = [&](int x, int y) {
+        if (x < 0 || y < 0 || x >= cells_x_ || y >= cells_y_) return;
+        std::size_t c = static_cast<std::size_t>(y) * cells_x_ + x;
+        for (std::uint32_t s = cell_start_[c]; s < cell_start_[c + 1]; ++s) {
+            visit(cell_points_[s]);
+        }
+    };
+
+    if (ring == 0) {
+        visitCell(cx, cy);
+        return;
+    }
+    // Top and bottom rows of the ring, then the side columns (corners once)
+    for (int x = cx - ring; x <= cx + ring; ++x) {
+        visitCell(x, cy - ring);
+        visitCell(x, cy + ring);
+    }
+    for (int y = cy - ring + 1; y <= cy + ring - 1; ++y) {
+        visitCell(cx - ring, y);
+        visitCell(cx + ring, y);
+    }
+}
+
+void SpatialGridIndex::kNearest(const Point& query, std::size_t k,
+                                const std::vector<double>* weights, double min_weight,
+                                std::uint32_t exclude, std::vector<Neighbor>& out) const {
+    out.clear();
+    if (k == 0 || points_.empty()) return;
+
+    const int cx = cellCoord(query[0], min_x_, cells_x_);
+    const int cy = cellCoord(query[1], min_y_, cells_y_);
+    const int max_ring = std::max({cx, cy, cells_x_ - 1 - cx, cells_y_ - 1 - cy});
+
+    for (int ring = 0; ring <= max_ring; ++ring) {
+        visitRing(cx, cy, ring, [&](std::uint32_t j) {
+            if (j == exclude) return;
+            double dx = query[0] - points_[j][0];
+            double dy = query[1] - points_[j][1];
+            double dist = std::sqrt(dx * dx + dy * dy);
+            if (weights) {
+                dist *= (*weights)[j];
+            }
+            out.push_back({dist, j});
+        });
+
+        if (out.size() >= k) {
+            // Anything beyond this ring is at least ring·cellSize·minWeight away
+            std::nth_element(out.begin(), out.begin() + (k - 1), out.end());
+            out.resize(k);
+            double bound = ring * cell_size_ * min_weight;
+            if (out[k - 1].first < bound) break;
+        }
+    }
+
+    std::sort(out.begin(), out.end());
+    if (out.size() > k) out.resize(k);
+}
+
+void SpatialGridIndex::withinRadius(const Point& query, double radius,
+                                    std::vector<Neighbor>& out) const {
+    out.clear();
+    if (points_.empty() || radius < 0.0) return;
+
+    const int cx = cellCoord(query[0], min_x_, cells_x_);
+    const int cy = cellCoord(query[1], min_y_, cells_y_);
+    const int max_ring = std::max({cx, cy, cells_x_ - 1 - cx, cells_y_ - 1 - cy});
+    const int rings = std::min(max_ring, static_cast<int>(std::ceil(radius / cell_size_)) + 1);
+
+    for (int ring = 0; ring <= rings; ++ring) {
+        visitRing(cx, cy, ring, [&](std::uint32_t j) {
+            double dx = query[0] - points_[j][0];
+            double dy = query[1] - points_[j][1];
+            double dist = std::sqrt(dx * dx + dy * dy);
+            if (dist <= radius) out.push_back({dist, j});
+        });
+    }
+    std::sort(out.begin(), out.end());
+}
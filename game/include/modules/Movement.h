@@ -3,13 +3,17 @@
 
 #include <array>
 #include <vector>
-#include <map>
 #include <string>
 #include <cstdint>
+#include <utility>
+
+#include "kernel/BeliefSpace.h"
+#include "utils/MembershipBitmap.h"
 
 // Forward declarations
 class Kernel;
 struct Cluster;
+class OnlineClustering;
 
 // Movement lifecycle stages
 enum class MovementStage {
@@ -29,14 +33,18 @@ struct Movement {
     MovementStage stage = MovementStage::Birth;
     
     // Platform (mean beliefs of members)
-    std::array<double, 4> platform{0, 0, 0, 0};
+    BeliefVec platform{};
     
-    // Membership
+    // Membership: ascending agent IDs, mirrored in a compressed bitmap for
+    // overlap/churn set queries
     std::vector<std::uint32_t> members;
+    MembershipBitmap memberSet;
     std::vector<std::uint32_t> leaders;  // High-assertiveness agents
     
-    // Geographic presence
-    std::map<std::uint32_t, double> regionalStrength;  // region -> proportion
+    // Geographic presence: (region, proportion) for every region with members,
+    // ascending by region ID
+    std::vector<std::pair<std::uint32_t, double>> regionalStrength;
+    double strengthIn(std::uint32_t regionId) const;
     
     // Power metrics
     double power = 0.0;              // Overall power (0-1)
@@ -45,11 +53,14 @@ struct Movement {
     double institutionalAccess = 0.0; // Future: captured institutions
     
     // Economic base
-    std::map<int, double> classComposition;  // wealth decile -> proportion
+    std::array<double, 10> classComposition{};  // wealth decile -> proportion
     
     // Dynamics
     double coherence = 0.0;          // Internal belief alignment
-    double momentum = 0.0;           // Growth rate (members gained/lost per tick)
+    double momentum = 0.0;           // Net growth: (joined - left) / previous size, per tick
+    double churn = 0.0;              // Turnover: (joined + left) / previous size, per tick
+    std::uint32_t joined = 0;        // Members gained since the previous update
+    std::uint32_t left = 0;          // Members lost (departed or died) since the previous update
     double charismaScore = 0.0;      // Average leader assertiveness
 };
 
@@ -66,9 +77,29 @@ struct MovementFormationConfig {
     
     // Capacity limits to prevent unbounded growth
     std::uint32_t maxActiveMovements = 100;  // Cap on concurrent active movements
+    
+    // A cluster whose members overlap a live movement by at least this
+    // Jaccard index refreshes that movement's membership instead of forming
+    double rematchMinJaccard = 0.5;
+    
+    // Movements with at least this many members are updated one at a time
+    // with their members split across threads; smaller ones run one task each
+    std::uint32_t splitThreshold = 50000;
 };
 
-// Movement module
+/**
+ * Movement module
+ *
+ * Each update freezes the kernel state and runs a parallel pipeline:
+ *   1. Formation candidates: every cluster's sorted members, bitmap and
+ *      formation test are prepared in parallel.
+ *   2. Matching and formation run serially in cluster order, so movement IDs
+ *      and cluster→movement matches do not depend on the thread count (the
+ *      greedy match skips claimed movements, so it stays cheap).
+ *   3. Movements are independent once matched: small ones are updated with
+ *      one task per movement; those above `splitThreshold` members are
+ *      updated one at a time with their member pass split across threads.
+ */
 class MovementModule {
 public:
     explicit MovementModule(const MovementFormationConfig& cfg = MovementFormationConfig());
@@ -76,15 +107,26 @@ public:
     // Update movements based on kernel state
     void update(Kernel& kernel, const std::vector<Cluster>& clusters, std::uint64_t tick);
     
+    // Update from the kernel's online culture tracker: tracked cultures are
+    // screened on their O(1) size and coherence before members are gathered
+    // (every update, so existing movements follow their culture's membership)
+    void update(Kernel& kernel, const OnlineClustering& tracker, std::uint64_t tick);
+    
     // Access
     const std::vector<Movement>& movements() const { return movements_; }
     std::vector<Movement>& movementsMut() { return movements_; }
     
     // Queries
     Movement* findMovement(std::uint32_t id);
+    const Movement* findMovement(std::uint32_t id) const;
     std::vector<Movement*> movementsInRegion(std::uint32_t regionId);
     std::vector<Movement*> movementsByPower() const;  // Sorted descending
     
+    // Membership set queries (bitmap intersections; 0 for unknown IDs)
+    std::uint32_t sharedMembers(std::uint32_t a, std::uint32_t b) const;
+    double overlap(std::uint32_t a, std::uint32_t b) const;  // Jaccard index
+    MembershipBitmap multiMembers() const;   // Agents in two or more movements
+    
     // Statistics
     struct MovementStats {
         std::uint32_t totalMovements = 0;
@@ -95,6 +137,9 @@ public:
         double avgPower = 0.0;
         double avgSize = 0.0;
         double totalMembership = 0;  // Agents in any movement
+        std::uint32_t multiMembership = 0;  // Agents in two or more movements
+        double avgMomentum = 0.0;
+        double avgChurn = 0.0;
     };
     MovementStats computeStats() const;
     
@@ -103,14 +148,59 @@ private:
     std::vector<Movement> movements_;
     std::uint32_t nextId_ = 0;
     
+    // Global wealth decile cut points, rebuilt once per update (not per
+    // movement): decile(w) = #{d : thresholds[d] < w}, identical to ranking
+    // w against the fully sorted wealth distribution
+    struct WealthDeciles {
+        std::array<double, 9> thresholds{};
+        bool valid = false;
+        int decileOf(double wealth) const;
+    };
+    WealthDeciles deciles_;
+    
+    // A cluster prepared for matching/formation (built in parallel)
+    struct Candidate {
+        std::vector<std::uint32_t> members;  // Ascending
+        MembershipBitmap memberSet;
+        bool formable = false;               // Passes shouldFormMovement()
+    };
+    
+    // Sums of the single pass over (a range of) one movement's members
+    struct MemberTally {
+        BeliefVec platform{};
+        std::array<std::uint32_t, 10> deciles{};
+        double street = 0.0;                 // Σ assertiveness · (1 + hardship)
+    };
+    
+    // Per-thread scratch for the membership pass, reused across updates
+    struct ThreadScratch {
+        MemberTally tally;
+        std::vector<std::uint32_t> regionCounts;     // Dense, one slot per region
+        std::vector<std::uint32_t> touchedRegions;   // Regions with a nonzero count
+        std::vector<BeliefState> beliefs;  // Contiguous member B (task path)
+    };
+    std::vector<ThreadScratch> scratch_;
+    std::vector<BeliefState> splitBeliefs_;  // Member B for the split path
+    
     // Formation logic
     void detectFormations(Kernel& kernel, const std::vector<Cluster>& clusters, std::uint64_t tick);
     bool shouldFormMovement(const Cluster& cluster, const Kernel& kernel) const;
-    Movement createMovement(const Cluster& cluster, const Kernel& kernel, std::uint64_t tick);
+    Movement createMovement(const Cluster& cluster, Candidate candidate, std::uint64_t tick);
+    // Best live movement overlapping `members`, skipping matched[m] != 0 (-1 if none)
+    int matchMovement(const MembershipBitmap& members, const std::vector<char>& matched) const;
+    // Replace membership, counting joiners/leavers through the bitmaps
+    void refreshMembers(Movement& mov, std::vector<std::uint32_t> members, MembershipBitmap memberSet);
+    void pruneDeadMembers(Movement& mov, const Kernel& kernel);
     
     // Update logic
+    void buildWealthDeciles(const Kernel& kernel);
     void updateExistingMovements(Kernel& kernel, std::uint64_t tick);
-    void updateMembership(Movement& mov, const Kernel& kernel);
+    // `scratch` = the calling thread's slot (one task per movement), or null to
+    // split this movement's member pass across all threads
+    void updateMovement(Movement& mov, const Kernel& kernel, std::uint64_t tick, ThreadScratch* scratch);
+    void updateMembership(Movement& mov, const Kernel& kernel, ThreadScratch* scratch);
+    void tallyMember(std::uint32_t agentId, const Kernel& kernel, ThreadScratch& scratch,
+                     BeliefState& beliefOut) const;
     void updatePowerMetrics(Movement& mov, const Kernel& kernel);
     void updateStage(Movement& mov);
     void pruneDeadMovements();
@@ -1,33 +1,115 @@
 #include "modules/Movement.h"
 #include "kernel/Kernel.h"
 #include "modules/Culture.h"
+#include "modules/OnlineClustering.h"
 #include <algorithm>
 #include <cmath>
+#include <iterator>
 #include <numeric>
-#include <set>
+#include <omp.h>
 
 MovementModule::MovementModule(const MovementFormationConfig& cfg) : cfg_(cfg) {}
 
 // Main update: detect new formations, update existing movements
 void MovementModule::update(Kernel& kernel, const std::vector<Cluster>& clusters, std::uint64_t tick) {
+    buildWealthDeciles(kernel);
+    for (auto& mov : movements_) {
+        mov.joined = 0;
+        mov.left = 0;
+    }
     detectFormations(kernel, clusters, tick);
     updateExistingMovements(kernel, tick);
     pruneDeadMovements();
 }
 
-// Formation detection from clusters
+void MovementModule::update(Kernel& kernel, const OnlineClustering& tracker, std::uint64_t tick) {
+    auto candidates = tracker.materialize(kernel, cfg_.minSize, cfg_.minCoherence);
+    update(kernel, candidates, tick);
+}
+
+// Formation detection from clusters: a cluster that is mostly an existing
+// movement's membership refreshes it; otherwise it may form a new movement
 void MovementModule::detectFormations(Kernel& kernel, const std::vector<Cluster>& clusters, std::uint64_t tick) {
-    // Capacity check: prevent unbounded movement growth
-    if (movements_.size() >= cfg_.maxActiveMovements) {
-        return;  // At capacity, no new formations until some die
+    const std::int64_t numClusters = static_cast<std::int64_t>(clusters.size());
+    
+    // Candidates (sorted members, bitmap, formation test) in parallel
+    std::vector<Candidate> candidates(clusters.size());
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (std::int64_t ii = 0; ii < numClusters; ++ii) {
+        const std::size_t c = static_cast<std::size_t>(ii);
+        Candidate& cand = candidates[c];
+        cand.members = clusters[c].members;
+        if (!std::is_sorted(cand.members.begin(), cand.members.end())) {
+            std::sort(cand.members.begin(), cand.members.end());
+        }
+        cand.memberSet = MembershipBitmap::fromSorted(cand.members);
+        cand.formable = shouldFormMovement(clusters[c], kernel);
     }
     
-    for (const auto& cluster : clusters) {
-        if (movements_.size() >= cfg_.maxActiveMovements) break;  // Stop if we hit cap during iteration
-        if (shouldFormMovement(cluster, kernel)) {
-            movements_.push_back(createMovement(cluster, kernel, tick));
+    // Greedy matching and ID assignment, serially in cluster order. Claimed
+    // movements are skipped and the rising best tightens the size bound, so
+    // this evaluates far fewer Jaccard indices than a parallel all-pairs pass.
+    std::vector<char> matched(movements_.size(), 0);
+    for (std::size_t c = 0; c < clusters.size(); ++c) {
+        int best = matchMovement(candidates[c].memberSet, matched);
+        if (best >= 0) {
+            matched[best] = 1;
+            refreshMembers(movements_[best], std::move(candidates[c].members),
+                           std::move(candidates[c].memberSet));
+            continue;
+        }
+        
+        // Capacity check: prevent unbounded movement growth
+        if (movements_.size() >= cfg_.maxActiveMovements) continue;
+        if (candidates[c].formable) {
+            movements_.push_back(createMovement(clusters[c], std::move(candidates[c]), tick));
+            matched.push_back(1);
+        }
+    }
+}
+
+int MovementModule::matchMovement(const MembershipBitmap& members, const std::vector<char>& matched) const {
+    int best = -1;
+    double bestJaccard = cfg_.rematchMinJaccard;
+    const double size = static_cast<double>(members.cardinality());
+    for (std::size_t m = 0; m < movements_.size(); ++m) {
+        if (matched[m] || movements_[m].stage == MovementStage::Dead) continue;
+        // Jaccard <= min/max of the two sizes: skip pairs that cannot qualify
+        const double other = static_cast<double>(movements_[m].members.size());
+        if (std::min(size, other) < bestJaccard * std::max(size, other)) continue;
+        double jaccard = MembershipBitmap::jaccard(members, movements_[m].memberSet);
+        if (jaccard >= bestJaccard) {
+            bestJaccard = jaccard;
+            best = static_cast<int>(m);
         }
     }
+    return best;
+}
+
+void MovementModule::refreshMembers(Movement& mov, std::vector<std::uint32_t> members,
+                                    MembershipBitmap memberSet) {
+    const std::size_t stayed = MembershipBitmap::andCardinality(mov.memberSet, memberSet);
+    const std::uint32_t joined = static_cast<std::uint32_t>(memberSet.cardinality() - stayed);
+    const std::uint32_t left = static_cast<std::uint32_t>(mov.memberSet.cardinality() - stayed);
+    mov.joined += joined;
+    mov.left += left;
+    mov.members = std::move(members);
+    mov.memberSet = std::move(memberSet);
+    if (joined > 0 || left > 0) {
+        mov.leaders.clear();  // Re-identified in the update pass
+    }
+}
+
+void MovementModule::pruneDeadMembers(Movement& mov, const Kernel& kernel) {
+    const auto& agents = kernel.agents();
+    auto alive = [&agents](std::uint32_t id) { return id < agents.size() && agents[id].alive; };
+    if (std::all_of(mov.members.begin(), mov.members.end(), alive)) return;
+    
+    std::vector<std::uint32_t> living;
+    living.reserve(mov.members.size());
+    std::copy_if(mov.members.begin(), mov.members.end(), std::back_inserter(living), alive);
+    MembershipBitmap livingSet = MembershipBitmap::fromSorted(living);
+    refreshMembers(mov, std::move(living), std::move(livingSet));
 }
 
 bool MovementModule::shouldFormMovement(const Cluster& cluster, const Kernel& kernel) const {
@@ -73,7 +155,7 @@ bool MovementModule::shouldFormMovement(const Cluster& cluster, const Kernel& ke
     return false;
 }
 
-Movement MovementModule::createMovement(const Cluster& cluster, const Kernel& kernel, std::uint64_t tick) {
+Movement MovementModule::createMovement(const Cluster& cluster, Candidate candidate, std::uint64_t tick) {
     Movement mov;
     mov.id = nextId_++;
     mov.birthTick = tick;
@@ -83,128 +165,215 @@ Movement MovementModule::createMovement(const Cluster& cluster, const Kernel& ke
     // Platform = cluster centroid
     mov.platform = cluster.centroid;
     
-    // Members
-    mov.members = cluster.members;
-    
-    // Identify leaders
-    mov.leaders = identifyLeaders(cluster.members, kernel, 5);
+    // Members (ascending, mirrored in the bitmap)
+    mov.members = std::move(candidate.members);
+    mov.memberSet = std::move(candidate.memberSet);
     
-    // Coherence from cluster
+    // Coherence from cluster; leaders and metrics follow in the update pass
     mov.coherence = cluster.coherence;
     
-    // Initial metrics
-    updateMembership(mov, kernel);
-    updatePowerMetrics(mov, kernel);
-    
     return mov;
 }
 
-// Update existing movements
+// Update existing movements: large ones split across threads, the rest as
+// one task per movement
 void MovementModule::updateExistingMovements(Kernel& kernel, std::uint64_t tick) {
-    for (auto& mov : movements_) {
+    const std::size_t threads = static_cast<std::size_t>(std::max(1, omp_get_max_threads()));
+    const std::size_t regionCount = kernel.regionIndex().size();
+    if (scratch_.size() < threads) scratch_.resize(threads);
+    for (auto& scratch : scratch_) {
+        if (scratch.regionCounts.size() < regionCount) scratch.regionCounts.assign(regionCount, 0);
+    }
+    
+    std::vector<std::size_t> tasks;
+    tasks.reserve(movements_.size());
+    for (std::size_t m = 0; m < movements_.size(); ++m) {
+        Movement& mov = movements_[m];
         if (mov.stage == MovementStage::Dead) continue;
-        
-        updateMembership(mov, kernel);
-        updatePowerMetrics(mov, kernel);
-        updateStage(mov);
-        
-        mov.lastUpdateTick = tick;
+        if (threads > 1 && mov.members.size() >= cfg_.splitThreshold) {
+            updateMovement(mov, kernel, tick, nullptr);
+        } else {
+            tasks.push_back(m);
+        }
+    }
+    
+    const std::int64_t numTasks = static_cast<std::int64_t>(tasks.size());
+    #pragma omp parallel
+    {
+        ThreadScratch& scratch = scratch_[static_cast<std::size_t>(omp_get_thread_num())];
+        #pragma omp for schedule(dynamic, 1)
+        for (std::int64_t ii = 0; ii < numTasks; ++ii) {
+            updateMovement(movements_[tasks[static_cast<std::size_t>(ii)]], kernel, tick, &scratch);
+        }
     }
 }
 
-void MovementModule::updateMembership(Movement& mov, const Kernel& kernel) {
-    const auto& agents = kernel.agents();
+void MovementModule::updateMovement(Movement& mov, const Kernel& kernel, std::uint64_t tick,
+                                    ThreadScratch* scratch) {
+    pruneDeadMembers(mov, kernel);
+    if (mov.leaders.empty() && !mov.members.empty()) {
+        mov.leaders = identifyLeaders(mov.members, kernel, 5);
+    }
     
-    // Recompute platform as mean of current members
-    std::array<double, 4> newPlatform{0, 0, 0, 0};
-    for (auto agentId : mov.members) {
-        const auto& agent = agents[agentId];
-        for (int d = 0; d < 4; ++d) {
-            newPlatform[d] += agent.B[d];
-        }
+    // Momentum and churn relative to the size at the previous update
+    const double previousSize = static_cast<double>(mov.members.size()) + mov.left - mov.joined;
+    const double elapsed = static_cast<double>(std::max<std::uint64_t>(1, tick - mov.lastUpdateTick));
+    const double scale = 1.0 / (std::max(1.0, previousSize) * elapsed);
+    mov.momentum = (static_cast<double>(mov.joined) - mov.left) * scale;
+    mov.churn = (static_cast<double>(mov.joined) + mov.left) * scale;
+    
+    updateMembership(mov, kernel, scratch);
+    updatePowerMetrics(mov, kernel);
+    updateStage(mov);
+    
+    mov.lastUpdateTick = tick;
+}
+
+void MovementModule::buildWealthDeciles(const Kernel& kernel) {
+    const auto& ecoAgents = kernel.economy().agents();
+    const std::size_t n = ecoAgents.size();
+    deciles_.valid = n > 0;
+    if (n == 0) return;
+    
+    std::vector<double> wealths;
+    wealths.reserve(n);
+    for (const auto& ae : ecoAgents) {
+        wealths.push_back(ae.wealth);
     }
-    if (!mov.members.empty()) {
-        for (int d = 0; d < 4; ++d) {
-            newPlatform[d] /= mov.members.size();
-        }
+    
+    // A wealth w ranks at decile >= d iff at least ceil(d·n/10) wealths lie
+    // strictly below it, i.e. iff the ceil(d·n/10)-th smallest wealth is < w.
+    // Nine nth_element selections on shrinking suffixes replace a full sort.
+    auto from = wealths.begin();
+    for (int d = 1; d <= 9; ++d) {
+        const std::size_t rank = (static_cast<std::size_t>(d) * n + 9) / 10 - 1;
+        auto nth = wealths.begin() + static_cast<std::ptrdiff_t>(rank);
+        std::nth_element(from, nth, wealths.end());
+        deciles_.thresholds[d - 1] = *nth;
+        from = nth;
+    }
+}
+
+int MovementModule::WealthDeciles::decileOf(double wealth) const {
+    int decile = 0;
+    for (double t : thresholds) {
+        decile += (t < wealth) ? 1 : 0;
     }
-    mov.platform = newPlatform;
+    return decile;
+}
+
+// One member's contribution to the single pass: platform sums, dense
+// regional count, wealth decile, street power and a contiguous belief copy
+void MovementModule::tallyMember(std::uint32_t agentId, const Kernel& kernel, ThreadScratch& scratch,
+                                 BeliefState& beliefOut) const {
+    const auto& agent = kernel.agents()[agentId];
+    const auto& ecoAgents = kernel.economy().agents();
+    MemberTally& tally = scratch.tally;
+    belief::add<kBeliefDims>(tally.platform, agent.B);
+    beliefOut = agent.B;
     
-    // Recompute coherence (variance in belief space)
-    double variance = 0.0;
-    for (auto agentId : mov.members) {
-        const auto& agent = agents[agentId];
-        double dist = 0.0;
-        for (int d = 0; d < 4; ++d) {
-            double diff = agent.B[d] - mov.platform[d];
-            dist += diff * diff;
+    if (agent.region < scratch.regionCounts.size()) {
+        if (scratch.regionCounts[agent.region]++ == 0) {
+            scratch.touchedRegions.push_back(agent.region);
         }
-        variance += std::sqrt(dist);
     }
-    if (!mov.members.empty()) {
-        variance /= mov.members.size();
+    
+    double hardship = 0.0;
+    if (agentId < ecoAgents.size()) {
+        hardship = ecoAgents[agentId].hardship;
+        if (deciles_.valid) {
+            tally.deciles[deciles_.decileOf(ecoAgents[agentId].wealth)]++;
+        }
     }
-    mov.coherence = std::max(0.0, 1.0 - variance);
+    tally.street += agent.assertiveness * (1.0 + hardship);
+}
+
+// Single pass over members, then a coherence pass over the contiguous belief
+// copy. With a null `scratch` both passes are split across threads and the
+// per-thread tallies are merged in thread order.
+void MovementModule::updateMembership(Movement& mov, const Kernel& kernel, ThreadScratch* scratch) {
+    const std::int64_t n = static_cast<std::int64_t>(mov.members.size());
+    const bool split = (scratch == nullptr);
+    std::vector<BeliefState>& beliefs = split ? splitBeliefs_ : scratch->beliefs;
+    beliefs.resize(mov.members.size());
     
-    // Regional strength
-    mov.regionalStrength.clear();
-    const auto& regionIndex = kernel.regionIndex();
-    for (std::uint32_t r = 0; r < regionIndex.size(); ++r) {
-        int count = 0;
-        for (auto agentId : mov.members) {
-            if (agents[agentId].region == r) {
-                count++;
+    if (split) {
+        for (auto& s : scratch_) {
+            s.tally = MemberTally{};
+            s.touchedRegions.clear();
+        }
+        #pragma omp parallel
+        {
+            ThreadScratch& local = scratch_[static_cast<std::size_t>(omp_get_thread_num())];
+            #pragma omp for schedule(static)
+            for (std::int64_t ii = 0; ii < n; ++ii) {
+                const std::size_t i = static_cast<std::size_t>(ii);
+                tallyMember(mov.members[i], kernel, local, beliefs[i]);
             }
         }
-        if (count > 0) {
-            mov.regionalStrength[r] = static_cast<double>(count) / mov.members.size();
+        // Fold every thread's tally and region counts into slot 0
+        scratch = &scratch_[0];
+        for (std::size_t t = 1; t < scratch_.size(); ++t) {
+            ThreadScratch& other = scratch_[t];
+            belief::add<kBeliefDims>(scratch->tally.platform, other.tally.platform);
+            for (int d = 0; d < 10; ++d) scratch->tally.deciles[d] += other.tally.deciles[d];
+            scratch->tally.street += other.tally.street;
+            for (auto r : other.touchedRegions) {
+                if (scratch->regionCounts[r] == 0) scratch->touchedRegions.push_back(r);
+                scratch->regionCounts[r] += other.regionCounts[r];
+                other.regionCounts[r] = 0;
+            }
+            other.touchedRegions.clear();
+        }
+    } else {
+        scratch->tally = MemberTally{};
+        scratch->touchedRegions.clear();
+        for (std::int64_t ii = 0; ii < n; ++ii) {
+            const std::size_t i = static_cast<std::size_t>(ii);
+            tallyMember(mov.members[i], kernel, *scratch, beliefs[i]);
         }
     }
     
-    // Class composition (wealth deciles)
-    mov.classComposition.clear();
-    const auto& economy = kernel.economy();
-    const auto& ecoAgents = economy.agents();
+    const MemberTally& tally = scratch->tally;
+    const double invSize = mov.members.empty() ? 0.0 : 1.0 / mov.members.size();
+    mov.platform = tally.platform;
+    belief::scale<kBeliefDims>(mov.platform, invSize);
+    // Average street power per member (not n+1 which penalizes small movements)
+    mov.streetCapacity = tally.street * invSize;
     
-    // Collect all agent wealths for proper decile calculation
-    std::vector<double> all_wealths;
-    all_wealths.reserve(ecoAgents.size());
-    for (const auto& ae : ecoAgents) {
-        all_wealths.push_back(ae.wealth);
+    // Coherence (mean distance to platform) over the contiguous belief copy;
+    // distances are rescaled to the 4-axis space so thresholds keep their meaning
+    const BeliefVec platform = mov.platform;
+    constexpr double kAxisScale = 4.0 / kBeliefDims;
+    double variance = 0.0;
+    #pragma omp parallel for schedule(static) reduction(+:variance) if(split)
+    for (std::int64_t ii = 0; ii < n; ++ii) {
+        const auto& b = beliefs[static_cast<std::size_t>(ii)];
+        variance += std::sqrt(kAxisScale * belief::distanceSq<kBeliefDims>(b, platform));
     }
-    std::sort(all_wealths.begin(), all_wealths.end());
+    variance *= invSize;
+    mov.coherence = std::max(0.0, 1.0 - variance);
     
-    // Calculate deciles for movement members based on global wealth distribution
-    for (auto agentId : mov.members) {
-        if (agentId < ecoAgents.size()) {
-            double wealth = ecoAgents[agentId].wealth;
-            // Find position in sorted wealth distribution
-            auto it = std::lower_bound(all_wealths.begin(), all_wealths.end(), wealth);
-            int decile = std::distance(all_wealths.begin(), it) * 10 / all_wealths.size();
-            decile = std::min(9, decile);  // cap at 9
-            mov.classComposition[decile]++;
-        }
+    // Regional strength: sparse (region, share) list, then reset the dense slots
+    std::sort(scratch->touchedRegions.begin(), scratch->touchedRegions.end());
+    mov.regionalStrength.clear();
+    mov.regionalStrength.reserve(scratch->touchedRegions.size());
+    for (auto r : scratch->touchedRegions) {
+        mov.regionalStrength.emplace_back(r, scratch->regionCounts[r] * invSize);
+        scratch->regionCounts[r] = 0;
     }
-    // Normalize
-    for (auto& [decile, count] : mov.classComposition) {
-        count /= mov.members.size();
+    scratch->touchedRegions.clear();
+    
+    // Class composition (global wealth deciles)
+    for (int d = 0; d < 10; ++d) {
+        mov.classComposition[d] = tally.deciles[d] * invSize;
     }
 }
 
 void MovementModule::updatePowerMetrics(Movement& mov, const Kernel& kernel) {
     const auto& agents = kernel.agents();
-    const auto& economy = kernel.economy();
-    const auto& ecoAgents = economy.agents();
     
-    // Street capacity: sum of assertiveness * (1 + hardship)
-    double streetPower = 0.0;
-    for (auto agentId : mov.members) {
-        double assertiveness = agents[agentId].assertiveness;
-        double hardship = (agentId < ecoAgents.size()) ? ecoAgents[agentId].hardship : 0.0;
-        streetPower += assertiveness * (1.0 + hardship);
-    }
-    // Average street power per member (not n+1 which penalizes small movements)
-    mov.streetCapacity = mov.members.empty() ? 0.0 : streetPower / mov.members.size();
+    // (Street capacity is tallied in the membership pass)
     
     // Charisma score: average assertiveness of leaders
     double charismaSum = 0.0;
@@ -264,21 +433,34 @@ std::vector<std::uint32_t> MovementModule::identifyLeaders(const std::vector<std
         candidates.emplace_back(agentId, agents[agentId].assertiveness);
     }
     
-    // Sort by assertiveness descending
-    std::sort(candidates.begin(), candidates.end(),
-              [](const auto& a, const auto& b) { return a.second > b.second; });
+    // Top-N by assertiveness descending (ties keep member order)
+    const std::size_t n = std::min<std::size_t>(topN, candidates.size());
+    std::partial_sort(candidates.begin(), candidates.begin() + n, candidates.end(),
+                      [](const auto& a, const auto& b) {
+                          return a.second > b.second || (a.second == b.second && a.first < b.first);
+                      });
     
     std::vector<std::uint32_t> leaders;
     leaders.reserve(topN);
-    for (std::uint32_t i = 0; i < topN && i < candidates.size(); ++i) {
+    for (std::uint32_t i = 0; i < n; ++i) {
         leaders.push_back(candidates[i].first);
     }
     
     return leaders;
 }
 
+double Movement::strengthIn(std::uint32_t regionId) const {
+    auto it = std::lower_bound(regionalStrength.begin(), regionalStrength.end(), regionId,
+                               [](const auto& entry, std::uint32_t r) { return entry.first < r; });
+    return (it != regionalStrength.end() && it->first == regionId) ? it->second : 0.0;
+}
+
 // Queries
 Movement* MovementModule::findMovement(std::uint32_t id) {
+    return const_cast<Movement*>(static_cast<const MovementModule*>(this)->findMovement(id));
+}
+
+const Movement* MovementModule::findMovement(std::uint32_t id) const {
     auto it = std::find_if(movements_.begin(), movements_.end(),
                            [id](const Movement& m) { return m.id == id; });
     return (it != movements_.end()) ? &(*it) : nullptr;
@@ -287,7 +469,7 @@ Movement* MovementModule::findMovement(std::uint32_t id) {
 std::vector<Movement*> MovementModule::movementsInRegion(std::uint32_t regionId) {
     std::vector<Movement*> result;
     for (auto& mov : movements_) {
-        if (mov.regionalStrength.count(regionId) > 0) {
+        if (mov.strengthIn(regionId) > 0.0) {
             result.push_back(&mov);
         }
     }
@@ -305,6 +487,29 @@ std::vector<Movement*> MovementModule::movementsByPower() const {
     return result;
 }
 
+std::uint32_t MovementModule::sharedMembers(std::uint32_t a, std::uint32_t b) const {
+    const Movement* ma = findMovement(a);
+    const Movement* mb = findMovement(b);
+    if (!ma || !mb) return 0;
+    return static_cast<std::uint32_t>(MembershipBitmap::andCardinality(ma->memberSet, mb->memberSet));
+}
+
+double MovementModule::overlap(std::uint32_t a, std::uint32_t b) const {
+    const Movement* ma = findMovement(a);
+    const Movement* mb = findMovement(b);
+    if (!ma || !mb) return 0.0;
+    return MembershipBitmap::jaccard(ma->memberSet, mb->memberSet);
+}
+
+MembershipBitmap MovementModule::multiMembers() const {
+    MembershipBitmap seen, multi;
+    for (const auto& mov : movements_) {
+        multi = MembershipBitmap::orOf(multi, MembershipBitmap::andOf(seen, mov.memberSet));
+        seen = MembershipBitmap::orOf(seen, mov.memberSet);
+    }
+    return multi;
+}
+
 // Statistics
 MovementModule::MovementStats MovementModule::computeStats() const {
     MovementStats stats;
@@ -312,7 +517,9 @@ MovementModule::MovementStats MovementModule::computeStats() const {
     
     double totalPower = 0.0;
     double totalSize = 0.0;
-    std::set<std::uint32_t> allMembers;
+    double totalMomentum = 0.0;
+    double totalChurn = 0.0;
+    MembershipBitmap allMembers, multi;
     
     for (const auto& mov : movements_) {
         switch (mov.stage) {
@@ -325,14 +532,20 @@ MovementModule::MovementStats MovementModule::computeStats() const {
         
         totalPower += mov.power;
         totalSize += mov.members.size();
-        allMembers.insert(mov.members.begin(), mov.members.end());
+        totalMomentum += mov.momentum;
+        totalChurn += mov.churn;
+        multi = MembershipBitmap::orOf(multi, MembershipBitmap::andOf(allMembers, mov.memberSet));
+        allMembers = MembershipBitmap::orOf(allMembers, mov.memberSet);
     }
     
     if (stats.totalMovements > 0) {
         stats.avgPower = totalPower / stats.totalMovements;
         stats.avgSize = totalSize / stats.totalMovements;
+        stats.avgMomentum = totalMomentum / stats.totalMovements;
+        stats.avgChurn = totalChurn / stats.totalMovements;
     }
-    stats.totalMembership = allMembers.size();
+    stats.totalMembership = allMembers.cardinality();
+    stats.multiMembership = static_cast<std::uint32_t>(multi.cardinality());
     
     return stats;
 }
@@ -0,0 +1,476 @@
+#include <gtest/gtest.h>
+#include "modules/Culture.h"
+#include "modules/OnlineClustering.h"
+#include "kernel/Kernel.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+
+KernelConfig makeConfig(std::uint32_t population, std::uint32_t regions, std::uint64_t seed) {
+    KernelConfig cfg;
+    cfg.population = population;
+    cfg.regions = regions;
+    cfg.seed = seed;
+    cfg.demographyEnabled = false;
+    return cfg;
+}
+
+// Agent state (BeliefState) or aggregates (BeliefVec), in double
+template <typename A, typename B>
+double sqDist(const std::array<A, kBeliefDims>& a, const std::array<B, kBeliefDims>& b) {
+    double s = 0.0;
+    for (int d = 0; d < kBeliefDims; ++d) {
+        const double diff = static_cast<double>(a[d]) - b[d];
+        s += diff * diff;
+    }
+    return s;
+}
+
+// Bounded K-means must reach a Lloyd fixed point over living agents only
+void expectLloydFixedPoint(Kernel& kernel, int k, KMeansBounds bounds) {
+    KMeansClustering km(k, 200, 1e-6, bounds);
+    auto clusters = km.run(kernel);
+    ASSERT_TRUE(km.converged());
+    EXPECT_EQ(km.usedElkan(), bounds == KMeansBounds::Elkan);
+
+    const auto& agents = kernel.agents();
+    std::vector<int> seen(agents.size(), 0);
+    double inertia = 0.0;
+    for (const auto& cluster : clusters) {
+        for (auto id : cluster.members) {
+            ASSERT_TRUE(agents[id].alive) << "dead agent " << id << " clustered";
+            seen[id]++;
+            double own = sqDist(agents[id].B, cluster.centroid);
+            inertia += own;
+            for (const auto& other : clusters) {
+                if (other.members.empty()) continue;
+                EXPECT_LE(own, sqDist(agents[id].B, other.centroid) + 1e-9);
+            }
+        }
+    }
+    for (std::size_t i = 0; i < agents.size(); ++i) {
+        EXPECT_EQ(seen[i], agents[i].alive ? 1 : 0) << "agent " << i;
+    }
+    EXPECT_NEAR(km.inertia(), inertia, 1e-6 * std::max(1.0, inertia));
+
+    // Bounds must prune: naive Lloyd evaluates N·k distances per pass
+    const std::uint64_t naive = static_cast<std::uint64_t>(km.iterationsUsed() + 2) *
+                                kernel.agents().size() * static_cast<std::uint64_t>(k);
+    EXPECT_LT(km.distanceEvaluations(), naive);
+}
+
+// Reference: the original sequential DBSCAN (linear region queries, clusters
+// expanded in scan order). Returns labels: -1 noise, else cluster id.
+std::vector<int> naiveDbscan(const std::vector<Agent>& agents, double eps, int minPts) {
+    const std::size_t n = agents.size();
+    auto query = [&](std::size_t i) {
+        std::vector<std::uint32_t> out;
+        for (std::uint32_t j = 0; j < n; ++j) {
+            if (sqDist(agents[i].B, agents[j].B) <= eps * eps) out.push_back(j);
+        }
+        return out;
+    };
+    std::vector<int> labels(n, 0);
+    int clusterId = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (labels[i] != 0) continue;
+        auto neighbors = query(i);
+        if (static_cast<int>(neighbors.size()) < minPts) {
+            labels[i] = -1;
+            continue;
+        }
+        ++clusterId;
+        labels[i] = clusterId;
+        for (std::size_t q = 0; q < neighbors.size(); ++q) {
+            auto j = neighbors[q];
+            if (labels[j] == -1) labels[j] = clusterId;
+            if (labels[j] == 0) {
+                labels[j] = clusterId;
+                auto more = query(j);
+                if (static_cast<int>(more.size()) >= minPts) {
+                    neighbors.insert(neighbors.end(), more.begin(), more.end());
+                }
+            }
+        }
+    }
+    for (auto& label : labels) label = (label > 0) ? label - 1 : -1;
+    return labels;
+}
+
+}  // namespace
+
+TEST(CultureTest, KMeansHamerlySkipsDeadAgents) {
+    Kernel kernel(makeConfig(3000, 10, 11));
+    kernel.stepN(20);
+    auto& agents = kernel.agentsMut();
+    for (std::size_t i = 0; i < agents.size(); i += 7) {
+        agents[i].alive = false;
+    }
+    expectLloydFixedPoint(kernel, 6, KMeansBounds::Hamerly);
+}
+
+TEST(CultureTest, KMeansElkanLargeK) {
+    Kernel kernel(makeConfig(3000, 10, 23));
+    kernel.stepN(20);
+    expectLloydFixedPoint(kernel, 40, KMeansBounds::Elkan);
+}
+
+TEST(CultureTest, MiniBatchKMeansApproximatesFullBatch) {
+    Kernel kernel(makeConfig(4000, 10, 5));
+    kernel.stepN(20);
+    auto& agents = kernel.agentsMut();
+    for (std::size_t i = 0; i < agents.size(); i += 9) {
+        agents[i].alive = false;
+    }
+
+    KMeansClustering full(8, 200, 1e-6);
+    full.run(kernel);
+
+    MiniBatchKMeansClustering mb(8, 256, 200);
+    auto clusters = mb.run(kernel);
+
+    std::size_t members = 0, alive = 0;
+    for (const auto& cluster : clusters) {
+        for (auto id : cluster.members) {
+            EXPECT_TRUE(agents[id].alive);
+        }
+        members += cluster.members.size();
+    }
+    for (const auto& agent : agents) alive += agent.alive ? 1 : 0;
+    EXPECT_EQ(members, alive);
+
+    // Mini-batch trades a little inertia for population-independent cost
+    EXPECT_LT(mb.inertia(), full.inertia() * 1.15);
+}
+
+// Stopping early must not leave inertia on the table: the same run continued
+// to 3000 iterations (batches are drawn from the same stream) improves on a
+// stopped one by at most a few tolerances. A centroid-shift test stops once the
+// 1/count steps are small, leaving ~7 tolerances here.
+TEST(CultureTest, MiniBatchKMeansStopsOnlyWhenSettled) {
+    Kernel kernel(makeConfig(4000, 10, 5));
+    kernel.stepN(20);
+
+    const double tolerance = 1e-3;
+    int stops = 0;
+    for (int batch : {64, 256}) {
+        MiniBatchKMeansClustering stopped(8, batch, 3000, tolerance);
+        stopped.run(kernel);
+        if (!stopped.converged()) continue;  // Still improving at the iteration cap
+        ++stops;
+        MiniBatchKMeansClustering continued(8, batch, 3000, 1e-6);
+        continued.run(kernel);
+
+        EXPECT_GE(continued.iterationsUsed(), stopped.iterationsUsed());
+        EXPECT_LT(stopped.inertia(), continued.inertia() * (1.0 + 3 * tolerance)) << "batch " << batch;
+    }
+    EXPECT_GT(stops, 0);
+}
+
+TEST(CultureTest, DBSCANMatchesSequentialLabels) {
+    Kernel kernel(makeConfig(1500, 10, 3));
+    auto& agents = kernel.agentsMut();
+
+    // Four belief blobs of different spread plus uniform background noise
+    std::mt19937_64 rng(99);
+    const std::array<BeliefVec, 4> centers = {{
+        {0.5, 0.5, 0.0, 0.0}, {-0.5, 0.2, 0.3, -0.4}, {0.0, -0.6, -0.3, 0.5}, {0.45, 0.35, 0.1, 0.05}}};
+    std::uniform_real_distribution<double> uniform(-0.95, 0.95);
+    for (std::size_t i = 0; i < agents.size(); ++i) {
+        if (i % 10 == 0) {
+            for (int d = 0; d < kBeliefDims; ++d) agents[i].B[d] = uniform(rng);
+            continue;
+        }
+        const auto& c = centers[i % centers.size()];
+        std::normal_distribution<double> spread(0.0, 0.05 + 0.02 * (i % centers.size()));
+        for (int d = 0; d < kBeliefDims; ++d) agents[i].B[d] = std::clamp(c[d] + spread(rng), -0.99, 0.99);
+    }
+
+    const double eps = 0.12 * std::sqrt(kBeliefDims / 4.0);  // Blob spread is per axis
+    const int minPts = 8;
+    auto expected = naiveDbscan(agents, eps, minPts);
+
+    DBSCANClustering db(eps, minPts);
+    auto clusters = db.run(kernel);
+
+    std::vector<int> labels(agents.size(), -1);
+    for (const auto& cluster : clusters) {
+        for (auto id : cluster.members) labels[id] = static_cast<int>(cluster.id);
+    }
+    int noise = 0;
+    for (std::size_t i = 0; i < agents.size(); ++i) {
+        EXPECT_EQ(labels[i], expected[i]) << "agent " << i;
+        if (expected[i] < 0) ++noise;
+    }
+    EXPECT_GE(clusters.size(), 2u);
+    EXPECT_EQ(db.noisePoints(), noise);
+
+    // Dead agents are never clustered
+    agents[1].alive = false;
+    for (const auto& cluster : db.run(kernel)) {
+        for (auto id : cluster.members) EXPECT_NE(id, 1u);
+    }
+}
+
+TEST(CultureTest, OnlineTrackerMatchesMemberMeans) {
+    // Demography on, so births and deaths flow through the tracker too
+    KernelConfig cfg = makeConfig(6000, 30, 77);
+    cfg.demographyEnabled = true;
+    cfg.cultureTrackerK = 6;
+    cfg.cultureTrackerSweepTicks = 7;
+    Kernel kernel(cfg);
+    kernel.stepN(45);
+
+    const OnlineClustering* tracker = kernel.cultureTracker();
+    ASSERT_NE(tracker, nullptr);
+    const auto& agents = kernel.agents();
+
+    std::vector<BeliefVec> sum(6, BeliefVec{});
+    std::vector<std::uint32_t> count(6, 0);
+    std::uint32_t alive = 0;
+    for (const auto& agent : agents) {
+        int c = tracker->getCluster(agent.id);
+        if (!agent.alive) {
+            EXPECT_EQ(c, -1) << "dead agent " << agent.id << " still tracked";
+            continue;
+        }
+        ++alive;
+        ASSERT_GE(c, 0) << "living agent " << agent.id << " untracked";
+        count[c]++;
+        for (int d = 0; d < kBeliefDims; ++d) sum[c][d] += agent.B[d];
+    }
+    EXPECT_EQ(tracker->trackedAgents(), alive);
+
+    for (int c = 0; c < 6; ++c) {
+        EXPECT_EQ(tracker->clusterSize(c), count[c]);
+        if (count[c] == 0) continue;
+        for (int d = 0; d < kBeliefDims; ++d) {
+            EXPECT_NEAR(tracker->centroids()[c][d], sum[c][d] / count[c], 1e-9);
+        }
+    }
+
+    // Materialized clusters carry the same members and coherence
+    auto clusters = tracker->materialize(kernel);
+    for (const auto& cluster : clusters) {
+        EXPECT_EQ(cluster.members.size(), count[cluster.id]);
+        EXPECT_NEAR(cluster.coherence, tracker->clusterCoherence(static_cast<int>(cluster.id)), 1e-9);
+    }
+
+    // A full sweep leaves the tracker close to a fresh batch clustering
+    KMeansClustering km(6);
+    km.run(kernel);
+    EXPECT_LT(tracker->inertia(), 1.5 * km.inertia());
+}
+
+TEST(CultureTest, KMeansWarmStartConvergesQuickly) {
+    Kernel kernel(makeConfig(8000, 40, 21));
+    kernel.stepN(20);
+
+    KMeansClustering cold(8, 200, 1e-6);
+    auto clusters = cold.run(kernel);
+    ASSERT_TRUE(cold.converged());
+    EXPECT_FALSE(cold.warmStarted());
+
+    // Same population: the previous centroids are already a fixed point
+    KMeansClustering warm(8, 200, 1e-6);
+    warm.warmStart(clusters);
+    auto again = warm.run(kernel);
+    EXPECT_TRUE(warm.warmStarted());
+    EXPECT_TRUE(warm.converged());
+    EXPECT_LE(warm.iterationsUsed(), 2);
+    EXPECT_NEAR(warm.inertia(), cold.inertia(), 1e-6 * cold.inertia());
+
+    // After a few ticks of drift (the economy's thread RNGs are not seeded, so
+    // the exact drift may vary run to run) each warm-started cluster stays
+    // closest to the centroid it was seeded from: identities carry over
+    kernel.stepN(3);
+    KMeansClustering drifted(8, 200, 1e-6);
+    drifted.warmStart(again);
+    auto moved = drifted.run(kernel);
+    ASSERT_EQ(moved.size(), again.size());
+    for (std::size_t i = 0; i < moved.size(); ++i) {
+        if (moved[i].members.empty()) continue;
+        for (std::size_t j = 0; j < again.size(); ++j) {
+            EXPECT_LE(sqDist(moved[i].centroid, again[i].centroid),
+                      sqDist(moved[i].centroid, again[j].centroid) + 1e-12)
+                << "cluster " << i << " drifted toward seed " << j;
+        }
+    }
+}
+
+TEST(CultureTest, ClusterTrackerKeepsIdentities) {
+    Kernel kernel(makeConfig(6000, 30, 5));
+    kernel.stepN(10);
+    KMeansClustering km(6, 200, 1e-6);
+    auto first = km.run(kernel);
+
+    for (ClusterMatch match : {ClusterMatch::Overlap, ClusterMatch::Centroid}) {
+        ClusterTrackerConfig cfg;
+        cfg.match = match;
+        ClusterTracker tracker(cfg);
+
+        auto initial = first;
+        tracker.update(initial, 100);
+        ASSERT_EQ(tracker.live().size(), initial.size());
+        for (const auto& cluster : initial) EXPECT_EQ(cluster.birthTick, 100u);
+
+        // Same clusters in reverse order, one dropped: ids follow the members
+        auto later = initial;
+        std::reverse(later.begin(), later.end());
+        const std::uint32_t droppedId = later.back().id;
+        later.pop_back();
+        for (auto& cluster : later) cluster.id = 999;
+        tracker.update(later, 140);
+
+        for (const auto& cluster : later) {
+            auto it = std::find_if(initial.begin(), initial.end(), [&](const Cluster& c) {
+                return c.members == cluster.members;
+            });
+            ASSERT_NE(it, initial.end());
+            EXPECT_EQ(cluster.id, it->id);
+            EXPECT_EQ(cluster.birthTick, 100u);
+        }
+        ASSERT_EQ(tracker.retired().size(), 1u);
+        EXPECT_EQ(tracker.retired()[0].id, droppedId);
+        EXPECT_EQ(tracker.retired()[0].deathTick, 140u);
+
+        // A brand-new culture gets a fresh id
+        auto withNew = later;
+        withNew.push_back(initial[0]);
+        withNew.back().centroid = {5.0, 5.0, 5.0, 5.0};
+        withNew.back().members.clear();
+        tracker.update(withNew, 150);
+        EXPECT_EQ(withNew.back().birthTick, 150u);
+        EXPECT_GE(withNew.back().id, static_cast<std::uint32_t>(initial.size()));
+    }
+}
+
+TEST(CultureTest, EnrichmentMatchesPerClusterTallies) {
+    Kernel kernel(makeConfig(5000, 25, 13));
+    kernel.stepN(10);
+    KMeansClustering km(7);
+    auto clusters = km.run(kernel);
+    const auto& agents = kernel.agents();
+
+    for (const auto& cluster : clusters) {
+        ASSERT_FALSE(cluster.members.empty());
+        const double size = static_cast<double>(cluster.members.size());
+        BeliefVec sum{};
+        std::array<int, 4> langs{0, 0, 0, 0};
+        std::map<std::uint32_t, int> regions;
+        std::map<int, int> dialects;
+        for (auto id : cluster.members) {
+            for (int d = 0; d < kBeliefDims; ++d) sum[d] += agents[id].B[d];
+            langs[agents[id].primaryLang]++;
+            regions[agents[id].region]++;
+            dialects[agents[id].primaryLang * 256 + agents[id].dialect]++;
+        }
+        for (int d = 0; d < kBeliefDims; ++d) EXPECT_NEAR(cluster.centroid[d], sum[d] / size, 1e-9);
+        for (int l = 0; l < 4; ++l) EXPECT_DOUBLE_EQ(cluster.languageShare[l], langs[l] / size);
+        EXPECT_EQ(langs[cluster.dominantLang], *std::max_element(langs.begin(), langs.end()));
+
+        int bestDialect = 0;
+        for (const auto& [key, count] : dialects) bestDialect = std::max(bestDialect, count);
+        bool dominantFound = false;
+        for (const auto& [key, count] : dialects) {
+            if (count == bestDialect && (key & 0xFF) == cluster.dominantDialect) dominantFound = true;
+        }
+        EXPECT_TRUE(dominantFound);
+
+        // Top regions: count descending, region ascending on ties
+        std::vector<std::pair<int, std::uint32_t>> ranked;
+        for (const auto& [region, count] : regions) ranked.push_back({-count, region});
+        std::sort(ranked.begin(), ranked.end());
+        ASSERT_EQ(cluster.topRegions.size(), std::min<std::size_t>(5, ranked.size()));
+        for (std::size_t j = 0; j < cluster.topRegions.size(); ++j) {
+            EXPECT_EQ(cluster.topRegions[j].first, ranked[j].second);
+            EXPECT_DOUBLE_EQ(cluster.topRegions[j].second, -ranked[j].first / size);
+        }
+    }
+}
+
+TEST(CultureTest, SampledSilhouetteBracketsExact) {
+    Kernel kernel(makeConfig(1200, 10, 8));
+    auto& agents = kernel.agentsMut();
+    std::mt19937_64 rng(4);
+    const std::array<BeliefVec, 3> centers = {{
+        {0.5, 0.5, 0.0, 0.0}, {-0.5, 0.0, 0.4, 0.0}, {0.0, -0.5, -0.3, 0.4}}};
+    std::normal_distribution<double> spread(0.0, 0.15);
+    for (std::size_t i = 0; i < agents.size(); ++i) {
+        for (int d = 0; d < kBeliefDims; ++d) {
+            agents[i].B[d] = std::clamp(centers[i % 3][d] + spread(rng), -0.99, 0.99);
+        }
+    }
+    KMeansClustering km(3);
+    auto clusters = km.run(kernel);
+
+    // Exact O(N²) silhouette
+    std::vector<int> label(agents.size(), -1);
+    for (std::size_t c = 0; c < clusters.size(); ++c) {
+        for (auto id : clusters[c].members) label[id] = static_cast<int>(c);
+    }
+    double exact = 0.0;
+    for (std::size_t i = 0; i < agents.size(); ++i) {
+        std::vector<double> sums(clusters.size(), 0.0);
+        for (std::size_t j = 0; j < agents.size(); ++j) {
+            sums[label[j]] += std::sqrt(sqDist(agents[i].B, agents[j].B));
+        }
+        const std::size_t own = static_cast<std::size_t>(label[i]);
+        double a = sums[own] / (clusters[own].members.size() - 1);
+        double b = std::numeric_limits<double>::max();
+        for (std::size_t c = 0; c < clusters.size(); ++c) {
+            if (c != own) b = std::min(b, sums[c] / clusters[c].members.size());
+        }
+        exact += (b - a) / std::max(a, b);
+    }
+    exact /= agents.size();
+
+    SilhouetteOptions options;
+    options.sampleSize = 600;
+    options.referencePerCluster = 1000;  // exact mean distances for these clusters
+    auto metrics = computeClusterMetrics(clusters, kernel, options);
+    EXPECT_EQ(metrics.silhouetteSamples, 600u);
+    EXPECT_LE(metrics.silhouetteLow, exact + 0.01);
+    EXPECT_GE(metrics.silhouetteHigh, exact - 0.01);
+    EXPECT_NEAR(metrics.silhouette, exact, 0.05);
+
+    // Subsampled reference sets stay close
+    options.referencePerCluster = 100;
+    EXPECT_NEAR(computeClusterMetrics(clusters, kernel, options).silhouette, exact, 0.05);
+
+    options.sampleSize = 0;
+    EXPECT_EQ(computeClusterMetrics(clusters, kernel, options).silhouetteSamples, 0u);
+}
+
+TEST(CultureTest, AsyncClusteringUsesSnapshotGeneration) {
+    Kernel kernel(makeConfig(4000, 20, 31));
+    kernel.stepN(5);
+    auto snapshot = ClusteringSnapshot::capture(kernel);
+    KMeansClustering sync(5);
+    auto expected = sync.run(snapshot);
+
+    // The kernel keeps stepping while the worker clusters generation 5
+    auto pending = clusterAsync(kernel, KMeansClustering(5));
+    kernel.stepN(3);
+    ClusteringResult result = pending.get();
+
+    EXPECT_EQ(result.generation, 5u);
+    EXPECT_EQ(kernel.generation(), 8u);
+    ASSERT_EQ(result.clusters.size(), expected.size());
+    for (std::size_t c = 0; c < expected.size(); ++c) {
+        EXPECT_EQ(result.clusters[c].members, expected[c].members);
+        EXPECT_EQ(result.clusters[c].birthTick, 5u);
+    }
+    EXPECT_GT(result.metrics.silhouetteSamples, 0u);
+
+    // Snapshot rows only cover agents alive at capture
+    EXPECT_EQ(snapshot.size(), snapshot.agentId.size());
+    for (std::size_t row = 0; row < snapshot.size(); ++row) {
+        EXPECT_EQ(snapshot.row(snapshot.agentId[row]), static_cast<std::int32_t>(row));
+    }
+}
@@ -1,5 +1,12 @@
 #include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <omp.h>
 #include "kernel/Kernel.h"
+#include "modules/Economy.h"
+#include "utils/CounterRng.h"
+#include "utils/DegreeScheduler.h"
 
 // Basic kernel initialization test
 TEST(KernelTest, Initialization) {
@@ -42,7 +49,7 @@ TEST(KernelTest, DeterministicUpdates) {
     
     // Beliefs should be within valid tanh bounds [-1, 1]
     for (size_t i = 0; i < agents1.size(); ++i) {
-        for (int d = 0; d < 4; ++d) {
+        for (int d = 0; d < kBeliefDims; ++d) {
             EXPECT_GE(agents1[i].B[d], -1.0) << "Belief below -1";
             EXPECT_LE(agents1[i].B[d], 1.0) << "Belief above 1";
             EXPECT_GE(agents2[i].B[d], -1.0) << "Belief below -1";
@@ -70,3 +77,670 @@ TEST(KernelTest, MetricsComputation) {
     EXPECT_GE(metrics.avgConformity, 0.0);
     EXPECT_LE(metrics.avgConformity, 1.0);
 }
+
+// Incrementally maintained regional belief profiles must track a fresh scan
+// through belief updates, economic feedback, births, deaths and migration
+TEST(KernelTest, RegionalBeliefProfilesMatchFullScan) {
+    KernelConfig cfg;
+    cfg.population = 2000;
+    cfg.regions = 12;
+    cfg.seed = 7;
+
+    Kernel kernel(cfg);
+    kernel.stepN(95);  // Off the 100-tick rebuild, so only deltas are in play
+
+    for (std::uint32_t r = 0; r < cfg.regions; ++r) {
+        RegionalBeliefMoments scan;
+        for (const auto& agent : kernel.agents()) {
+            if (agent.alive && agent.region == r) scan.add(agent.B);
+        }
+        RegionalBeliefProfile expected = scan.profile();
+        RegionalBeliefProfile maintained = kernel.regionalBeliefProfile(r);
+
+        ASSERT_EQ(maintained.population, expected.population) << "region " << r;
+        for (int d = 0; d < kBeliefDims; ++d) {
+            EXPECT_NEAR(maintained.mean[d], expected.mean[d], 1e-9);
+            EXPECT_NEAR(maintained.variance[d], expected.variance[d], 1e-9);
+            EXPECT_NEAR(maintained.dominant_pole[d], expected.dominant_pole[d], 1e-9);
+        }
+        EXPECT_NEAR(maintained.polarization, expected.polarization, 1e-9);
+    }
+}
+
+// The fused health + psychology sweep must reproduce the serial module updates
+// bit for bit per agent, whatever the thread count
+TEST(KernelTest, FusedWellbeingSweepMatchesSerial) {
+    KernelConfig cfg;
+    cfg.population = 3000;
+    cfg.regions = 8;
+    cfg.seed = 11;
+
+    Kernel kernel(cfg);
+    kernel.stepN(20);
+    const Economy& economy = kernel.economy();
+    const auto& econAgents = economy.agents();
+
+    EXPECT_EQ(CounterRng::bits(1, 2, 3, 0), CounterRng::bits(1, 2, 3, 0));
+    EXPECT_NE(CounterRng::bits(1, 2, 3, 0), CounterRng::bits(1, 2, 3, 1));
+
+    std::vector<Agent> serial = kernel.agents();
+    HealthModule serialHealth;
+    PsychologyModule serialPsych;
+    serialHealth.configure(cfg.regions, 99);
+    serialPsych.configure(cfg.regions, 99);
+
+    std::vector<Agent> fused = kernel.agents();
+    HealthModule fusedHealth;
+    PsychologyModule fusedPsych;
+    fusedHealth.configure(cfg.regions, 99);
+    fusedPsych.configure(cfg.regions, 99);
+
+    const int savedThreads = omp_get_max_threads();
+    omp_set_num_threads(4);
+    for (std::uint64_t tick = 1; tick <= 5; ++tick) {
+        serialHealth.updateAgents(serial, economy, tick);
+        serialPsych.updateAgents(serial, economy, tick);
+
+        fusedHealth.beginTick(economy, 4);
+        fusedPsych.beginTick(economy, fused, 4);
+        const std::int64_t n = static_cast<std::int64_t>(fused.size());
+        #pragma omp parallel
+        {
+            const std::size_t tid = static_cast<std::size_t>(omp_get_thread_num());
+            #pragma omp for schedule(static)
+            for (std::int64_t ii = 0; ii < n; ++ii) {
+                Agent& agent = fused[static_cast<std::size_t>(ii)];
+                if (!agent.alive) continue;
+                fusedHealth.updateAgent(agent, tick, tid);
+                fusedPsych.updateAgent(agent, econAgents[agent.id], tid);
+            }
+        }
+        fusedHealth.finishTick();
+        fusedPsych.finishTick();
+    }
+    omp_set_num_threads(savedThreads);
+
+    for (std::size_t i = 0; i < serial.size(); ++i) {
+        ASSERT_EQ(fused[i].health.infected, serial[i].health.infected) << "agent " << i;
+        ASSERT_EQ(fused[i].health.physical_health, serial[i].health.physical_health) << "agent " << i;
+        ASSERT_EQ(fused[i].health.immunity, serial[i].health.immunity) << "agent " << i;
+        ASSERT_EQ(fused[i].psych.stress_level, serial[i].psych.stress_level) << "agent " << i;
+        ASSERT_EQ(fused[i].psych.mental_health, serial[i].psych.mental_health) << "agent " << i;
+        ASSERT_EQ(fused[i].m_comm, serial[i].m_comm) << "agent " << i;
+    }
+    for (std::uint32_t r = 0; r < cfg.regions; ++r) {
+        EXPECT_NEAR(fusedHealth.regionalSnapshots()[r].avg_health,
+                    serialHealth.regionalSnapshots()[r].avg_health, 1e-12);
+        EXPECT_NEAR(fusedPsych.regionalMetrics()[r].avg_stress,
+                    serialPsych.regionalMetrics()[r].avg_stress, 1e-12);
+        EXPECT_NEAR(fusedPsych.regionalMetrics()[r].low_mental_health_share,
+                    serialPsych.regionalMetrics()[r].low_mental_health_share, 1e-12);
+    }
+}
+
+// Network SEIR: infection only travels along ties, every new exposure has an
+// infectious contact, and work is proportional to the infectious agents' edges
+TEST(KernelTest, NetworkEpidemicSpreadsAlongTies) {
+    // A 300-agent ring (k = 4) and a separate 100-agent ring nobody is seeded in
+    std::vector<Agent> agents(400);
+    for (std::uint32_t i = 0; i < 400; ++i) {
+        agents[i].id = i;
+        const std::uint32_t base = i < 300 ? 0 : 300;
+        const std::uint32_t size = i < 300 ? 300 : 100;
+        const std::uint32_t local = i - base;
+        for (std::uint32_t off : {1u, 2u, size - 1, size - 2}) {
+            agents[i].neighbors.push_back(base + (local + off) % size);
+        }
+    }
+
+    HealthModule health;
+    health.configure(1, 5);
+    health.initializeAgents(agents);
+    health.setEpidemicModel(EpidemicModel::Network, agents);
+    health.diseaseMut().spillover = 0.0;
+    health.diseaseMut().transmission = 0.3;
+    health.diseaseMut().latent_ticks = 2;
+
+    // Nothing infected: no contacts scanned
+    health.stepEpidemic(agents, 0);
+    EXPECT_EQ(health.epidemicStats().edgesScanned, 0u);
+    EXPECT_EQ(health.epidemicStats().newExposures, 0u);
+
+    ASSERT_TRUE(health.seedInfection(agents[0], 0));
+    EXPECT_FALSE(health.seedInfection(agents[0], 0));
+
+    for (std::uint64_t tick = 1; tick <= 60; ++tick) {
+        std::vector<bool> wasInfectious(agents.size());
+        std::size_t expectedEdges = 0;
+        for (const auto& agent : agents) {
+            wasInfectious[agent.id] = agent.health.stage == InfectionStage::Infectious;
+            if (wasInfectious[agent.id]) expectedEdges += agent.neighbors.size();
+        }
+
+        health.stepEpidemic(agents, tick);
+        const auto& stats = health.epidemicStats();
+        EXPECT_EQ(stats.edgesScanned, expectedEdges) << "tick " << tick;
+
+        std::size_t exposed = 0, infectious = 0, fresh = 0;
+        for (const auto& agent : agents) {
+            const auto& h = agent.health;
+            exposed += h.stage == InfectionStage::Exposed;
+            infectious += h.stage == InfectionStage::Infectious;
+            EXPECT_EQ(h.infected, h.stage == InfectionStage::Infectious);
+            if (h.stage == InfectionStage::Exposed && h.stage_tick == tick) {
+                ++fresh;
+                bool hasSource = false;
+                for (auto nb : agent.neighbors) hasSource |= wasInfectious[nb];
+                EXPECT_TRUE(hasSource) << "agent " << agent.id << " tick " << tick;
+            }
+        }
+        EXPECT_EQ(stats.exposed, exposed);
+        EXPECT_EQ(stats.infectious, infectious);
+        EXPECT_EQ(stats.newExposures, fresh);
+    }
+
+    EXPECT_GT(health.epidemicStats().totalCases, 10u);
+    for (std::uint32_t i = 300; i < 400; ++i) {
+        EXPECT_EQ(agents[i].health.stage, InfectionStage::Susceptible) << "agent " << i;
+    }
+}
+
+// The kernel drives the network model through its fused wellbeing sweep
+TEST(KernelTest, NetworkEpidemicRunsInKernel) {
+    KernelConfig cfg;
+    cfg.population = 2000;
+    cfg.regions = 10;
+    cfg.seed = 3;
+    cfg.networkEpidemic = true;
+    cfg.demographyEnabled = false;  // Deaths after the sweep would lag the stats by a tick
+
+    Kernel kernel(cfg);
+    EXPECT_EQ(kernel.health().epidemicModel(), EpidemicModel::Network);
+    EXPECT_EQ(kernel.seedInfections(20), 20u);
+    kernel.stepN(15);
+
+    std::size_t exposed = 0, infectious = 0;
+    for (const auto& agent : kernel.agents()) {
+        if (!agent.alive) continue;
+        exposed += agent.health.stage == InfectionStage::Exposed;
+        infectious += agent.health.stage == InfectionStage::Infectious;
+    }
+    const auto& stats = kernel.health().epidemicStats();
+    EXPECT_EQ(stats.exposed, exposed);
+    EXPECT_EQ(stats.infectious, infectious);
+    EXPECT_GE(stats.totalCases, 20u);
+}
+
+// Accuracy harness for adaptive level of detail: a run with quiet agents on
+// 2/4/8-tick updates must track a full-rate run's aggregate state
+TEST(KernelTest, LevelOfDetailTracksFullRate) {
+    for (bool meanField : {true, false}) {
+        SCOPED_TRACE(meanField ? "hybrid" : "pairwise");
+        KernelConfig cfg;
+        cfg.population = 6000;
+        cfg.regions = 20;
+        cfg.seed = 21;
+        cfg.demographyEnabled = false;
+        cfg.useMeanField = meanField;
+
+        // Noise-free pairwise moves are ~10× smaller per tick, so the drift
+        // tolerance scales down with them
+        KernelConfig lodCfg = cfg;
+        lodCfg.lod.enabled = true;
+        if (!meanField) lodCfg.lod.tolerance = 2e-3;
+
+        Kernel full(cfg);
+        Kernel adaptive(lodCfg);
+        full.stepN(150);
+        adaptive.stepN(150);
+
+        struct Summary {
+            BeliefVec mean{};
+            double spread = 0.0, stress = 0.0, mental = 0.0, health = 0.0;
+        };
+        auto summarize = [](const Kernel& kernel) {
+            Summary s;
+            std::size_t n = 0;
+            for (const auto& agent : kernel.agents()) {
+                if (!agent.alive) continue;
+                for (int d = 0; d < kBeliefDims; ++d) s.mean[d] += agent.B[d];
+                s.spread += agent.B_norm_sq;
+                s.stress += agent.psych.stress_level;
+                s.mental += agent.psych.mental_health;
+                s.health += agent.health.physical_health;
+                ++n;
+            }
+            for (auto& m : s.mean) m /= n;
+            s.spread /= n;
+            s.stress /= n;
+            s.mental /= n;
+            s.health /= n;
+            return s;
+        };
+        const Summary a = summarize(full);
+        const Summary b = summarize(adaptive);
+        for (int d = 0; d < kBeliefDims; ++d) EXPECT_NEAR(a.mean[d], b.mean[d], 0.02) << "dim " << d;
+        EXPECT_NEAR(a.spread, b.spread, 0.15 * a.spread);
+        EXPECT_NEAR(a.stress, b.stress, 0.01);
+        EXPECT_NEAR(a.mental, b.mental, 0.01);
+        EXPECT_NEAR(a.health, b.health, 0.01);
+        EXPECT_NEAR(full.computeMetrics().polarizationMean, adaptive.computeMetrics().polarizationMean, 0.01);
+
+        // Quiet agents actually left full rate, and fewer belief updates ran
+        const LodStats& stats = adaptive.levelOfDetail().stats();
+        const std::size_t alive = stats.tierCounts[0] + stats.tierCounts[1] + stats.tierCounts[2] + stats.tierCounts[3];
+        EXPECT_EQ(alive, cfg.population);
+        EXPECT_GT(stats.tierCounts[3], alive / 4);
+        EXPECT_LT(stats.beliefUpdates, alive / 2);
+        EXPECT_GE(stats.wellbeingUpdates, stats.beliefUpdates / 2);
+    }
+}
+
+// Reduced-precision storage (AGENT_FLOAT_STATE) against the double path:
+// a shadow run rounds all agent state to float and traits to 16 bits after
+// every tick, and its aggregates must track the double run. (In a float
+// build the rounding is a no-op and both runs coincide.)
+TEST(KernelTest, ReducedPrecisionTracksDouble) {
+    for (bool meanField : {true, false}) {
+        KernelConfig cfg;
+        cfg.population = 4000;
+        cfg.regions = 20;
+        cfg.seed = 33;
+        cfg.demographyEnabled = false;
+        cfg.useMeanField = meanField;
+
+        auto toFloat = [](auto& v) { v = static_cast<float>(v); };
+        auto reduce = [&](Kernel& kernel) {
+            for (auto& a : kernel.agentsMut()) {
+                for (int d = 0; d < kBeliefDims; ++d) {
+                    toFloat(a.x[d]);
+                    toFloat(a.B[d]);
+                }
+                toFloat(a.B_norm_sq);
+                toFloat(a.m_comm);
+                toFloat(a.m_susceptibility);
+                toFloat(a.m_mobility);
+                toFloat(a.psych.stress_level);
+                toFloat(a.psych.mental_health);
+                toFloat(a.psych.recovery_memory);
+                toFloat(a.health.physical_health);
+                toFloat(a.health.immunity);
+            }
+        };
+
+        Kernel exact(cfg);
+        Kernel reduced(cfg);
+        for (auto& a : reduced.agentsMut()) {
+            for (trait_t* trait : {&a.fluency, &a.openness, &a.conformity, &a.assertiveness, &a.sociality}) {
+                *trait = static_cast<double>(UnitQ16(*trait));
+            }
+        }
+        reduce(reduced);
+        for (int t = 0; t < 150; ++t) {
+            exact.step();
+            reduced.step();
+            reduce(reduced);
+        }
+
+        BeliefVec meanA{}, meanB{};
+        double stressA = 0.0, stressB = 0.0, sqDrift = 0.0;
+        const auto& a = exact.agents();
+        const auto& b = reduced.agents();
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            for (int d = 0; d < kBeliefDims; ++d) {
+                meanA[d] += a[i].B[d] / a.size();
+                meanB[d] += b[i].B[d] / b.size();
+                const double drift = static_cast<double>(a[i].B[d]) - b[i].B[d];
+                sqDrift += drift * drift / (a.size() * kBeliefDims);
+            }
+            stressA += a[i].psych.stress_level / a.size();
+            stressB += b[i].psych.stress_level / b.size();
+        }
+        for (int d = 0; d < kBeliefDims; ++d) {
+            EXPECT_NEAR(meanA[d], meanB[d], 0.01) << "meanField " << meanField << " dim " << d;
+        }
+        EXPECT_NEAR(stressA, stressB, 0.01) << "meanField " << meanField;
+        EXPECT_NEAR(exact.computeMetrics().polarizationMean, reduced.computeMetrics().polarizationMean, 0.01)
+            << "meanField " << meanField;
+        // The pairwise path is noise-free, so individual trajectories must stay
+        // close as well (hybrid noise amplifies rounding differences per agent)
+        if (!meanField) {
+            EXPECT_LT(std::sqrt(sqDrift), 1e-4);
+        }
+    }
+}
+
+// Innovation noise is counter-based, so two hybrid runs with one seed coincide
+TEST(KernelTest, HybridUpdateReproducibleForSeed) {
+    KernelConfig cfg;
+    cfg.population = 1500;
+    cfg.regions = 10;
+    cfg.seed = 8;
+    cfg.demographyEnabled = false;
+    cfg.useMeanField = true;
+
+    Kernel first(cfg);
+    Kernel second(cfg);
+    first.stepN(20);
+    second.stepN(20);
+    for (std::size_t i = 0; i < first.agents().size(); ++i) {
+        for (int d = 0; d < kBeliefDims; ++d) {
+            ASSERT_EQ(first.agents()[i].B[d], second.agents()[i].B[d]) << "agent " << i << " dim " << d;
+        }
+    }
+}
+
+// Level-of-detail step scaling is the identity for one tick and approaches
+// dt / sqrt(dt) for slow relaxation
+TEST(KernelTest, LevelOfDetailStepScales) {
+    double drift = 0.0, noise = 0.0;
+    LevelOfDetail::stepScales(0.1, 1.0, drift, noise);
+    EXPECT_EQ(drift, 1.0);
+    EXPECT_EQ(noise, 1.0);
+    LevelOfDetail::stepScales(1e-5, 8.0, drift, noise);
+    EXPECT_NEAR(drift, 8.0, 1e-3);
+    EXPECT_NEAR(noise, std::sqrt(8.0), 1e-3);
+    // Fast relaxation saturates: the agent reaches its target, noise stays bounded
+    LevelOfDetail::stepScales(0.5, 8.0, drift, noise);
+    EXPECT_NEAR(drift, (1.0 - std::pow(0.5, 8)) / 0.5, 1e-12);
+    EXPECT_LT(noise, std::sqrt(8.0));
+}
+
+// The packed-node pairwise kernel reproduces the per-edge formula, skipping
+// dead and out-of-range neighbors, for whole and split neighbor ranges
+TEST(KernelTest, PairwiseInfluenceMatchesScalarEdges) {
+    const std::uint32_t n = 300;
+    const double stepSize = 0.15, simFloor = 0.05;
+    std::vector<Agent> agents(n);
+    std::mt19937_64 rng(11);
+    std::uniform_real_distribution<double> belief(-0.9, 0.9), unit(0.0, 1.0);
+    for (std::uint32_t i = 0; i < n; ++i) {
+        Agent& agent = agents[i];
+        agent.id = i;
+        agent.primaryLang = static_cast<std::uint8_t>(i % 3);
+        agent.fluency = unit(rng);
+        agent.m_comm = 0.5 + unit(rng);
+        agent.m_susceptibility = 0.5 + unit(rng);
+        for (auto& b : agent.B) b = i % 17 == 0 ? 1e-4 * belief(rng) : belief(rng);
+        agent.B_norm_sq = belief::normSq<kBeliefDims>(agent.B);
+        agent.alive = i % 23 != 5;
+        for (std::uint32_t d : {1u, 2u, 5u, 11u}) {
+            agent.neighbors.push_back((i + d) % n);
+            agent.neighbors.push_back((i + n - d) % n);
+        }
+    }
+    agents[7].neighbors.push_back(n + 3);  // Stale ID
+    for (std::uint32_t j = 0; j < n; j += 2) agents[42].neighbors.push_back(j);  // Hub
+
+    auto expected = [&](std::uint32_t i, std::uint32_t begin, std::uint32_t end, double& weightSum) {
+        const Agent& ai = agents[i];
+        BeliefVec acc{};
+        weightSum = 0.0;
+        for (std::uint32_t e = begin; e < end; ++e) {
+            const std::uint32_t j = ai.neighbors[e];
+            if (j >= n || !agents[j].alive) continue;
+            const Agent& aj = agents[j];
+            const double normProdSq = static_cast<double>(ai.B_norm_sq) * aj.B_norm_sq;
+            const double gate = normProdSq < 1e-9 ? 1.0
+                : std::max(0.0, (belief::dot<kBeliefDims>(ai.B, aj.B) / std::sqrt(normProdSq) - simFloor) /
+                                    (1.0 - simFloor));
+            const double lq = ai.primaryLang == aj.primaryLang ? 0.5 * (ai.fluency + aj.fluency) : 0.1;
+            const double weight = stepSize * gate * lq * 0.5 * (ai.m_comm + aj.m_comm) * ai.m_susceptibility;
+            weightSum += weight;
+            for (int b = 0; b < kBeliefDims; ++b) {
+                acc[b] += weight * belief::fastTanh(static_cast<double>(aj.B[b]) - ai.B[b]);
+            }
+        }
+        return acc;
+    };
+
+    PairwiseInfluence pairwise;
+    pairwise.build(agents, stepSize, simFloor);
+    const double tolerance = kFloatState ? 1e-5 : 1e-12;
+    for (std::uint32_t i = 0; i < n; ++i) {
+        if (!agents[i].alive) continue;
+        const auto degree = static_cast<std::uint32_t>(agents[i].neighbors.size());
+        const std::uint32_t mid = degree / 3;
+        BeliefState whole{}, split{};
+        state_t wholeWeight = 0, splitWeight = 0;
+        pairwise.accumulate(i, agents[i].neighbors.data(), 0, degree, whole, wholeWeight);
+        pairwise.accumulate(i, agents[i].neighbors.data(), 0, mid, split, splitWeight);
+        pairwise.accumulate(i, agents[i].neighbors.data(), mid, degree, split, splitWeight);
+        double referenceWeight = 0.0;
+        const BeliefVec reference = expected(i, 0, degree, referenceWeight);
+        for (int b = 0; b < kBeliefDims; ++b) {
+            EXPECT_NEAR(whole[b], reference[b], tolerance) << "agent " << i << " dim " << b;
+            EXPECT_NEAR(split[b], reference[b], tolerance) << "agent " << i << " dim " << b;
+        }
+        EXPECT_NEAR(wholeWeight, referenceWeight, tolerance * (1.0 + referenceWeight)) << "agent " << i;
+        EXPECT_NEAR(splitWeight, referenceWeight, tolerance * (1.0 + referenceWeight)) << "agent " << i;
+    }
+}
+
+// Edge replicas hold each neighbor's quantized state in neighbor-list order;
+// liveness and language edits flow through refresh(), which copies only the
+// edges reading changed agents; rewiring needs markStale()
+TEST(KernelTest, EdgeReplicasMirrorNeighbors) {
+    const std::uint32_t n = 200;
+    std::vector<Agent> agents(n);
+    std::mt19937_64 rng(5);
+    std::uniform_real_distribution<double> belief(-1.0, 1.0), unit(0.0, 1.0);
+    for (std::uint32_t i = 0; i < n; ++i) {
+        Agent& agent = agents[i];
+        agent.id = i;
+        agent.primaryLang = static_cast<std::uint8_t>(i % 4);
+        agent.fluency = unit(rng);
+        agent.m_comm = unit(rng);
+        for (auto& b : agent.B) b = belief(rng);
+        for (std::uint32_t d : {1u, 3u, 8u}) agent.neighbors.push_back((i * 7 + d) % n);
+    }
+    agents[9].neighbors.push_back(n + 1);  // Stale ID
+
+    auto check = [&](const EdgeReplicas& replicas) {
+        for (std::uint32_t i = 0; i < n; ++i) {
+            const EdgeReplicas::Replica* row = replicas.row(i);
+            for (std::size_t e = 0; e < agents[i].neighbors.size(); ++e) {
+                const std::uint32_t j = agents[i].neighbors[e];
+                if (j >= n || !agents[j].alive) {
+                    EXPECT_FALSE(EdgeReplicas::live(row[e])) << "edge " << i << " <- " << j;
+                    continue;
+                }
+                ASSERT_TRUE(EdgeReplicas::live(row[e])) << "edge " << i << " <- " << j;
+                EXPECT_EQ(row[e].lang, agents[j].primaryLang);
+                EXPECT_FLOAT_EQ(row[e].comm, static_cast<float>(agents[j].m_comm));
+                EXPECT_NEAR(row[e].fluency / UnitQ16::kScale, agents[j].fluency, 1.0 / UnitQ16::kScale);
+                for (int d = 0; d < kBeliefDims; ++d) {
+                    EXPECT_NEAR(EdgeReplicas::belief(row[e], d), agents[j].B[d], 0.5 / EdgeReplicas::kScale + 1e-7);
+                }
+            }
+        }
+    };
+
+    EdgeReplicas replicas;
+    replicas.refresh(agents);
+    EXPECT_EQ(replicas.edgeCount(), 3u * n + 1);
+    EXPECT_EQ(replicas.copiedEdges(), replicas.edgeCount());
+    check(replicas);
+
+    replicas.refresh(agents);
+    EXPECT_EQ(replicas.copiedEdges(), 0u);
+
+    agents[17].alive = false;
+    agents[18].primaryLang = 3;
+    agents[19].B[0] = -agents[19].B[0];
+    std::size_t readers = 0;
+    for (const Agent& agent : agents) {
+        for (std::uint32_t j : agent.neighbors) readers += j >= 17 && j <= 19;
+    }
+    replicas.refresh(agents);
+    EXPECT_EQ(replicas.rebuilds(), 1u);
+    EXPECT_EQ(replicas.copiedEdges(), readers);
+    check(replicas);
+
+    agents[20].neighbors = {0, 17, 199, 4};
+    replicas.markStale();
+    replicas.refresh(agents);
+    EXPECT_EQ(replicas.rebuilds(), 2u);
+    EXPECT_EQ(replicas.edgeCount(), 3u * n + 2);
+    EXPECT_EQ(replicas.rowSize(20), 4u);
+    check(replicas);
+}
+
+// Replica-fed sweeps against the exact path: pairwise trajectories stay
+// within the quantization error, hybrid aggregates track
+TEST(KernelTest, EdgeReplicasTrackExactPath) {
+    for (bool meanField : {false, true}) {
+        KernelConfig cfg;
+        cfg.population = 3000;
+        cfg.regions = 20;
+        cfg.seed = 21;
+        cfg.demographyEnabled = false;
+        cfg.useMeanField = meanField;
+
+        Kernel exact(cfg);
+        cfg.edgeReplicas = true;
+        Kernel replica(cfg);
+        for (int t = 0; t < 100; ++t) {
+            exact.step();
+            replica.step();
+        }
+
+        BeliefVec meanA{}, meanB{};
+        double sqDrift = 0.0;
+        const auto& a = exact.agents();
+        const auto& b = replica.agents();
+        ASSERT_EQ(a.size(), b.size());
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            for (int d = 0; d < kBeliefDims; ++d) {
+                meanA[d] += a[i].B[d] / a.size();
+                meanB[d] += b[i].B[d] / b.size();
+                const double drift = static_cast<double>(a[i].B[d]) - b[i].B[d];
+                sqDrift += drift * drift / (a.size() * kBeliefDims);
+            }
+        }
+        for (int d = 0; d < kBeliefDims; ++d) {
+            EXPECT_NEAR(meanA[d], meanB[d], 0.01) << "meanField " << meanField << " dim " << d;
+        }
+        EXPECT_NEAR(exact.computeMetrics().polarizationMean, replica.computeMetrics().polarizationMean, 0.01)
+            << "meanField " << meanField;
+        if (!meanField) {
+            EXPECT_LT(std::sqrt(sqDrift), 1e-4);
+        }
+    }
+}
+
+// Edge-balanced tasks visit every edge exactly once, split hubs, and account
+// for all work in the per-thread load statistics
+TEST(KernelTest, DegreeSchedulerCoversEdgesAndSplitsHubs) {
+    std::vector<std::uint32_t> degrees(5000);
+    for (std::size_t i = 0; i < degrees.size(); ++i) degrees[i] = static_cast<std::uint32_t>(i % 13);
+    degrees[1234] = 60000;  // Hub far above one task's cost
+    degrees[4999] = 9000;
+
+    const int savedThreads = omp_get_max_threads();
+    omp_set_num_threads(4);
+    DegreeScheduler scheduler;
+    scheduler.build(degrees.size(), [&](std::size_t i) { return degrees[i]; });
+
+    // Per item: number of edges seen and the sum of their indices
+    std::vector<std::uint64_t> seen(degrees.size(), 0), sums(degrees.size(), 0);
+    std::vector<std::uint64_t> partialSeen(scheduler.partialSlots(), 0), partialSums(scheduler.partialSlots(), 0);
+    scheduler.run([&](std::uint32_t i, std::uint32_t begin, std::uint32_t end, std::int32_t slot, std::size_t) {
+        ASSERT_LE(begin, end);
+        ASSERT_LE(end, degrees[i]);
+        std::uint64_t count = 0, sum = 0;
+        for (std::uint32_t e = begin; e < end; ++e) {
+            ++count;
+            sum += e;
+        }
+        if (slot < 0) {
+            seen[i] = count;
+            sums[i] = sum;
+        } else {
+            partialSeen[static_cast<std::size_t>(slot)] = count;
+            partialSums[static_cast<std::size_t>(slot)] = sum;
+        }
+    });
+    omp_set_num_threads(savedThreads);
+
+    std::vector<std::uint32_t> splitIds;
+    for (const auto& split : scheduler.splits()) {
+        splitIds.push_back(split.id);
+        for (std::uint32_t slot = split.slot_begin; slot < split.slot_end; ++slot) {
+            seen[split.id] += partialSeen[slot];
+            sums[split.id] += partialSums[slot];
+        }
+    }
+    EXPECT_EQ(splitIds, (std::vector<std::uint32_t>{1234, 4999}));
+
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < degrees.size(); ++i) {
+        const std::uint64_t d = degrees[i];
+        EXPECT_EQ(seen[i], d) << "item " << i;
+        EXPECT_EQ(sums[i], d * (d - (d > 0 ? 1 : 0)) / 2) << "item " << i;
+        total += 1 + d;
+    }
+
+    const SchedulerLoad& load = scheduler.load();
+    ASSERT_EQ(load.tasks.size(), 4u);
+    std::uint64_t cost = 0;
+    std::size_t tasks = 0;
+    for (std::size_t t = 0; t < load.tasks.size(); ++t) {
+        cost += load.cost[t];
+        tasks += load.tasks[t];
+    }
+    EXPECT_EQ(cost, total);
+    EXPECT_EQ(tasks, scheduler.taskCount());
+    EXPECT_GE(load.imbalance(), 1.0);
+    // The hub alone is worth dozens of tasks
+    EXPECT_GT(scheduler.splits()[0].slot_end - scheduler.splits()[0].slot_begin, 30u);
+}
+
+// The belief kernels are instantiated for every supported dimensionality,
+// whatever BELIEF_DIMS this build uses
+template <int D>
+void checkBeliefKernels() {
+    std::mt19937_64 rng(D);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    BeliefArray<D> a{}, b{};
+    for (int d = 0; d < D; ++d) {
+        a[d] = uniform(rng);
+        b[d] = uniform(rng);
+    }
+
+    double dot = 0.0, aa = 0.0, bb = 0.0, dist = 0.0;
+    for (int d = 0; d < D; ++d) {
+        dot += a[d] * b[d];
+        aa += a[d] * a[d];
+        bb += b[d] * b[d];
+        dist += (a[d] - b[d]) * (a[d] - b[d]);
+    }
+    EXPECT_NEAR(belief::dot<D>(a, b), dot, 1e-12) << "D=" << D;
+    EXPECT_NEAR(belief::normSq<D>(a), aa, 1e-12) << "D=" << D;
+    EXPECT_NEAR(belief::distanceSq<D>(a, b), dist, 1e-12) << "D=" << D;
+    EXPECT_NEAR(belief::cosine<D>(a, b), dot / std::sqrt(aa * bb), 1e-12) << "D=" << D;
+    EXPECT_EQ(belief::cosine<D>(a, BeliefArray<D>{}), 0.0);
+
+    BeliefArray<D> acc = a;
+    belief::addScaled<D>(acc, b, 0.5);
+    belief::add<D>(acc, b);
+    belief::scale<D>(acc, 2.0);
+    for (int d = 0; d < D; ++d) {
+        EXPECT_NEAR(acc[d], 2.0 * (a[d] + 1.5 * b[d]), 1e-12) << "D=" << D << " dim " << d;
+    }
+}
+
+TEST(KernelTest, BeliefKernelsMatchScalarLoops) {
+    checkBeliefKernels<4>();
+    checkBeliefKernels<8>();
+    checkBeliefKernels<16>();
+}
+
+TEST(KernelTest, BeliefDimsMustMatchBuild) {
+    KernelConfig cfg;
+    cfg.population = 200;
+    cfg.regions = 4;
+    EXPECT_EQ(cfg.beliefDims, kBeliefDims);
+    cfg.beliefDims = kBeliefDims == 4 ? 8 : 4;
+    EXPECT_THROW(Kernel kernel(cfg), std::invalid_argument);
+}
@@ -0,0 +1,258 @@
+#include <gtest/gtest.h>
+#include "modules/Movement.h"
+#include "modules/Culture.h"
+#include "kernel/Kernel.h"
+#include "utils/MembershipBitmap.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <map>
+#include <omp.h>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace {
+
+KernelConfig makeConfig(std::uint32_t population, std::uint32_t regions, std::uint64_t seed) {
+    KernelConfig cfg;
+    cfg.population = population;
+    cfg.regions = regions;
+    cfg.seed = seed;
+    cfg.demographyEnabled = false;
+    return cfg;
+}
+
+// Agent state (BeliefState) or aggregates (BeliefVec), in double
+template <typename A, typename B>
+double sqDist(const std::array<A, kBeliefDims>& a, const std::array<B, kBeliefDims>& b) {
+    double s = 0.0;
+    for (int d = 0; d < kBeliefDims; ++d) {
+        const double diff = static_cast<double>(a[d]) - b[d];
+        s += diff * diff;
+    }
+    return s;
+}
+
+// A tight cluster: agents [skip, skip + size) by belief distance to `anchor`
+Cluster nearestCluster(const Kernel& kernel, std::uint32_t anchor, std::size_t size,
+                       std::size_t skip = 0) {
+    const auto& agents = kernel.agents();
+    std::vector<std::pair<double, std::uint32_t>> byDist;
+    for (const auto& a : agents) {
+        if (a.alive) byDist.emplace_back(sqDist(a.B, agents[anchor].B), a.id);
+    }
+    std::sort(byDist.begin(), byDist.end());
+    Cluster cluster;
+    for (std::size_t i = skip; i < skip + size && i < byDist.size(); ++i) {
+        cluster.members.push_back(byDist[i].second);
+    }
+    std::sort(cluster.members.begin(), cluster.members.end());
+    for (auto id : cluster.members) {
+        for (int d = 0; d < kBeliefDims; ++d) cluster.centroid[d] += agents[id].B[d] / cluster.members.size();
+    }
+    cluster.coherence = 0.9;
+    return cluster;
+}
+
+}  // namespace
+
+// The single-pass analytics must match the per-region scan and the
+// sort-and-rank decile definition they replace
+TEST(MovementTest, SinglePassAnalyticsMatchReference) {
+    Kernel kernel(makeConfig(6000, 40, 11));
+    for (int t = 0; t < 20; ++t) kernel.step();
+
+    MovementFormationConfig cfg;
+    cfg.minCharismaDensity = 0.0;
+    MovementModule movements(cfg);
+    std::vector<Cluster> clusters{nearestCluster(kernel, 0, 600), nearestCluster(kernel, 4000, 400)};
+    movements.update(kernel, clusters, kernel.generation());
+    ASSERT_FALSE(movements.movements().empty());
+
+    const auto& agents = kernel.agents();
+    const auto& ecoAgents = kernel.economy().agents();
+    std::vector<double> sorted;
+    for (const auto& ae : ecoAgents) sorted.push_back(ae.wealth);
+    std::sort(sorted.begin(), sorted.end());
+
+    for (const auto& mov : movements.movements()) {
+        const double n = static_cast<double>(mov.members.size());
+        BeliefVec platform{};
+        std::map<std::uint32_t, double> regions;
+        std::array<double, 10> deciles{};
+        for (auto id : mov.members) {
+            for (int d = 0; d < kBeliefDims; ++d) platform[d] += agents[id].B[d] / n;
+            regions[agents[id].region] += 1.0 / n;
+            auto it = std::lower_bound(sorted.begin(), sorted.end(), ecoAgents[id].wealth);
+            int decile = std::min<int>(9, static_cast<int>((it - sorted.begin()) * 10 / sorted.size()));
+            deciles[decile] += 1.0 / n;
+        }
+        double meanDist = 0.0;
+        for (auto id : mov.members) meanDist += std::sqrt(4.0 / kBeliefDims * sqDist(agents[id].B, platform)) / n;  // 4-axis units
+
+        for (int d = 0; d < kBeliefDims; ++d) EXPECT_NEAR(mov.platform[d], platform[d], 1e-12);
+        EXPECT_NEAR(mov.coherence, std::max(0.0, 1.0 - meanDist), 1e-12);
+
+        ASSERT_EQ(mov.regionalStrength.size(), regions.size());
+        std::size_t i = 0;
+        for (const auto& [region, share] : regions) {
+            EXPECT_EQ(mov.regionalStrength[i].first, region);
+            EXPECT_NEAR(mov.regionalStrength[i].second, share, 1e-12);
+            EXPECT_NEAR(mov.strengthIn(region), share, 1e-12);
+            ++i;
+        }
+        for (int d = 0; d < 10; ++d) {
+            EXPECT_NEAR(mov.classComposition[d], deciles[d], 1e-12) << "decile " << d;
+        }
+    }
+
+    // Region queries agree with the sparse lists
+    for (std::uint32_t r = 0; r < 40; ++r) {
+        for (auto* mov : movements.movementsInRegion(r)) {
+            EXPECT_GT(mov->strengthIn(r), 0.0);
+        }
+    }
+}
+
+// Bitmap algebra must agree with sorted-vector set operations across array
+// and bitmap containers (dense low chunk, sparse high chunks)
+TEST(MovementTest, MembershipBitmapMatchesSetAlgebra) {
+    std::mt19937 rng(7);
+    auto randomSet = [&rng](double denseP) {
+        std::bernoulli_distribution dense(denseP);
+        std::uniform_int_distribution<std::uint32_t> sparse(65536, 400000);
+        std::set<std::uint32_t> ids;
+        for (std::uint32_t i = 0; i < 65536; ++i) {
+            if (dense(rng)) ids.insert(i);
+        }
+        for (int i = 0; i < 3000; ++i) ids.insert(sparse(rng));
+        return std::vector<std::uint32_t>(ids.begin(), ids.end());
+    };
+    const auto a = randomSet(0.4);
+    const auto b = randomSet(0.03);
+    const auto ba = MembershipBitmap::fromSorted(a);
+    const auto bb = MembershipBitmap::fromSorted(b);
+    EXPECT_EQ(ba.toVector(), a);
+    EXPECT_EQ(ba.cardinality(), a.size());
+
+    auto reference = [&](auto op) {
+        std::vector<std::uint32_t> out;
+        op(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(out));
+        return out;
+    };
+    using It = std::vector<std::uint32_t>::const_iterator;
+    using Out = std::back_insert_iterator<std::vector<std::uint32_t>>;
+    const auto inter = reference(std::set_intersection<It, It, Out>);
+    const auto uni = reference(std::set_union<It, It, Out>);
+    const auto diffAB = reference(std::set_difference<It, It, Out>);
+
+    for (const auto* lhs : {&ba, &bb}) {
+        const auto* rhs = (lhs == &ba) ? &bb : &ba;
+        EXPECT_EQ(MembershipBitmap::andOf(*lhs, *rhs).toVector(), inter);
+        EXPECT_EQ(MembershipBitmap::orOf(*lhs, *rhs).toVector(), uni);
+        EXPECT_EQ(MembershipBitmap::andCardinality(*lhs, *rhs), inter.size());
+    }
+    EXPECT_EQ(MembershipBitmap::andNotOf(ba, bb).toVector(), diffAB);
+    EXPECT_NEAR(MembershipBitmap::jaccard(ba, bb),
+                static_cast<double>(inter.size()) / uni.size(), 1e-15);
+    EXPECT_TRUE(MembershipBitmap::andOf(ba, bb) == MembershipBitmap::fromSorted(inter));
+
+    // Point updates across the array/bitmap threshold match a bulk build
+    MembershipBitmap incremental;
+    for (auto id : b) incremental.add(id);
+    for (std::uint32_t i = 0; i < 65536; i += 9) incremental.add(i);
+    for (std::uint32_t i = 0; i < 65536; i += 9) {
+        if (!std::binary_search(b.begin(), b.end(), i)) {
+            EXPECT_TRUE(incremental.remove(i));
+        }
+    }
+    EXPECT_TRUE(incremental == bb);
+    EXPECT_FALSE(incremental.remove(399999 + 2));
+    for (auto id : b) EXPECT_TRUE(incremental.contains(id));
+}
+
+// A drifted cluster refreshes its movement (same ID) and reports joiners,
+// leavers, momentum and churn; a partly overlapping one forms a new movement
+TEST(MovementTest, ClustersRematchAndTrackChurn) {
+    Kernel kernel(makeConfig(6000, 40, 5));
+    MovementFormationConfig cfg;
+    cfg.minCharismaDensity = 0.0;
+    MovementModule movements(cfg);
+
+    movements.update(kernel, {nearestCluster(kernel, 0, 600)}, 100);
+    ASSERT_EQ(movements.movements().size(), 1u);
+    const std::uint32_t firstId = movements.movements()[0].id;
+    EXPECT_EQ(movements.movements()[0].momentum, 0.0);
+
+    // Ranks [50, 680) against the original [0, 600); plus ranks [300, 900)
+    std::vector<Cluster> next{nearestCluster(kernel, 0, 630, 50), nearestCluster(kernel, 0, 600, 300)};
+    movements.update(kernel, next, 110);
+    ASSERT_EQ(movements.movements().size(), 2u);
+
+    const Movement* drifted = movements.findMovement(firstId);
+    ASSERT_NE(drifted, nullptr);
+    EXPECT_EQ(drifted->members.size(), 630u);
+    EXPECT_EQ(drifted->memberSet.cardinality(), 630u);
+    EXPECT_EQ(drifted->joined, 80u);
+    EXPECT_EQ(drifted->left, 50u);
+    EXPECT_NEAR(drifted->momentum, 30.0 / 600.0 / 10.0, 1e-12);
+    EXPECT_NEAR(drifted->churn, 130.0 / 600.0 / 10.0, 1e-12);
+
+    const std::uint32_t secondId = movements.movements()[1].id;
+    EXPECT_EQ(movements.sharedMembers(firstId, secondId), 380u);
+    EXPECT_NEAR(movements.overlap(firstId, secondId), 380.0 / 850.0, 1e-12);
+    EXPECT_EQ(movements.multiMembers().cardinality(), 380u);
+
+    auto stats = movements.computeStats();
+    EXPECT_EQ(stats.totalMembership, 850.0);
+    EXPECT_EQ(stats.multiMembership, 380u);
+}
+
+// Split (member-parallel) and task (movement-parallel) updates must agree
+// with a single-threaded run, including movement IDs and matches
+TEST(MovementTest, ParallelPipelineMatchesSerial) {
+    Kernel kernel(makeConfig(8000, 40, 17));
+    std::vector<Cluster> first, second;
+    for (std::uint32_t anchor = 0; anchor < 8000; anchor += 1000) {
+        first.push_back(nearestCluster(kernel, anchor, 500));
+        second.push_back(nearestCluster(kernel, anchor, 520, 30));
+    }
+
+    MovementFormationConfig cfg;
+    cfg.minCharismaDensity = 0.0;
+    auto run = [&](int threads, std::uint32_t splitThreshold) {
+        MovementFormationConfig local = cfg;
+        local.splitThreshold = splitThreshold;
+        MovementModule movements(local);
+        const int saved = omp_get_max_threads();
+        omp_set_num_threads(threads);
+        movements.update(kernel, first, 10);
+        movements.update(kernel, second, 20);
+        omp_set_num_threads(saved);
+        return movements.movements();
+    };
+    const auto serial = run(1, 1000000);
+    const auto tasks = run(4, 1000000);
+    const auto split = run(4, 1);
+    ASSERT_FALSE(serial.empty());
+
+    for (const auto* other : {&tasks, &split}) {
+        ASSERT_EQ(other->size(), serial.size());
+        for (std::size_t m = 0; m < serial.size(); ++m) {
+            const Movement& a = serial[m];
+            const Movement& b = (*other)[m];
+            EXPECT_EQ(a.id, b.id);
+            EXPECT_EQ(a.members, b.members);
+            EXPECT_EQ(a.leaders, b.leaders);
+            EXPECT_EQ(a.joined, b.joined);
+            EXPECT_EQ(a.left, b.left);
+            EXPECT_EQ(a.regionalStrength, b.regionalStrength);
+            EXPECT_EQ(a.classComposition, b.classComposition);
+            for (int d = 0; d < kBeliefDims; ++d) EXPECT_NEAR(a.platform[d], b.platform[d], 1e-12);
+            EXPECT_NEAR(a.coherence, b.coherence, 1e-12);
+            EXPECT_NEAR(a.streetCapacity, b.streetCapacity, 1e-12);
+            EXPECT_NEAR(a.power, b.power, 1e-12);
+        }
+    }
+}